@@ -5,6 +5,7 @@ MPUController::MPUController(MPU *mpu) {
 
 	rotation = new Quaternion();
 	acceleration = new Vector3D();
+	fixedRotation = new QuaternionQ30();
 	accelerationOffset = new Vector3D();
 	gyroscopeOffset = new Vector3D();
 
@@ -207,9 +208,14 @@ Quaternion MPUController::GetRotation() {
 
 		fifoCount -= packetSize;
 
-		QuaternionFloat q = QuaternionFloat();
+		int32_t words[4];
 
-		mpu->dmpGetQuaternion(&q, fifoBuffer);
+		//Full Q30 words, stays fixed point until the controller boundary
+		mpu->dmpGetQuaternion(words, fifoBuffer);
+
+		*fixedRotation = QuaternionQ30::FromDMP(words).UnitQuaternion();
+
+		Quaternion q = fixedRotation->ToQuaternion();
 
 		/*
 		+1 x w if (1,2,3), (3,1,2), or (2,3,1)
@@ -218,7 +224,9 @@ Quaternion MPUController::GetRotation() {
 		-> antisymmetric tensor(Levi-Civita symbol)
 		*/
 		//flip chirality and negate
-		return Quaternion(q.w, q.y, q.z, q.x);
+		*rotation = Quaternion(q.W, q.Y, q.Z, q.X);
+
+		return *rotation;
 	}
 }
 
@@ -243,26 +251,21 @@ Vector3D MPUController::GetLinearAcceleration() {
 
 		fifoCount -= packetSize;
 
-		QuaternionFloat q = QuaternionFloat();
+		int16_t a[3];
 
-	    q = QuaternionFloat(rotation->W, rotation->X, rotation->Y, rotation->Z);
+		mpu->dmpGetAccel(a, fifoBuffer);
 
-		VectorInt16 a = VectorInt16();
-		VectorFloat g = VectorFloat();
-		VectorInt16 lA = VectorInt16();
-
-		mpu->dmpGetAccel(&a, fifoBuffer);
-		mpu->dmpGetGravity(&g, &q);
-		mpu->dmpGetLinearAccel(&lA, &a, &g);
-
-		Vector3D gAccel = Vector3D(lA.x, lA.z, lA.y);
+		//Gravity from the latest DMP quaternion, all in Q14
+		Vector3Q14 lA = fixedRotation->LinearAcceleration(Vector3Q14(a[0], a[1], a[2]));
 
 		//ax = raw / sensitivity SET TO 4 CURRENTLY
 		//2g = sensitivity of 16384
 		//4g = sensitivity of 8192
 		//8g = sensitivity of 4096
 		//16g = sensitivity of 2048
-		gAccel = gAccel / 16384;//Scaling factor from 8192+/- to 
+		Vector3D gAccel = Vector3Q14(lA.X, lA.Z, lA.Y).ToVector3D();//Q14 scaling, 16384 per g
+
+		*acceleration = gAccel;
 
 		return gAccel;
 	}
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <unistd.h>
 
+#include "../DTRQController/FixedPoint.h"
 #include "../DTRQController/Rotation.h"
 #include "../DTRQController/VectorKalmanFilter.h"
 #include "../DTRQController/VectorLeastSquares.h"
@@ -44,6 +45,8 @@ private:
 	Quaternion *rotation;
 	Vector3D *acceleration;
 
+	QuaternionQ30 *fixedRotation;//latest DMP sample, sensor frame, unit
+
 	Vector3D *accelerationOffset;
 	Vector3D *gyroscopeOffset;
 
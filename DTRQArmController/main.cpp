@@ -1,7 +1,7 @@
 #include "I2CController.h"
+#include "../DTRQController/FlightLoop.h"
+#include "../DTRQController/FlightRecorder.h"
 #include "../DTRQController/Rotation.h"
-#include "../DTRQController/Quadcopter.h"
-#include "../DTRQController/VectorFIRFilter.h"
 #include "../DTRQController/VectorKalmanFilter.h"
 #include "../DTRQController/QuaternionKalmanFilter.h"
 #include <chrono>
@@ -10,49 +10,33 @@
 #include <unistd.h>
 
 
-VectorFeedbackController pos = VectorFeedbackController{
-	new PID{ 10, 0, 12.5 },
-	new PID{ 1, 0, 0.2 },
-	new PID{ 10, 0, 12.5 }
-};
-
-VectorFeedbackController rot = VectorFeedbackController{
-	new PID{ 0.05, 0, 0.325 },
-	new PID{ 0.05, 0, 0.325 },
-	new PID{ 0.05, 0, 0.325 }
-};
-
 I2CController *i2cController;
-Quadcopter quad = Quadcopter(false, 0.3, 55, 0.05, &pos, &rot);
-QuaternionKalmanFilter quatKF = QuaternionKalmanFilter(0.75, 10);
-VectorKalmanFilter accelKF = VectorKalmanFilter(0.5, 50);
-Vector3D velocity = Vector3D(0, 0, 0);
-Vector3D position = Vector3D(0, 0, 0);
+FlightLoop *flightLoop;
+FlightRecorder recorder;
 
 Vector3D targetPosition = Vector3D(0, 0, 0);
-Rotation targetRotation = Rotation(Quaternion(1, 0, 0, 0));
+RotationF targetRotation = RotationF(QuaternionF(1, 0, 0, 0));
 
 //catches the interupt
 void sighandler(int signal) {
 	std::cout << "Caught signal interupt: " << signal << std::endl;
 
 	i2cController->~I2CController();
-	quad.~Quadcopter();
+	recorder.Close();
+	delete flightLoop;
 
 	std::cout << "Shutting down quadcopter..." << std::endl;
 
 	exit(1);
 }
 
-int main() {
+//optional argument: path of a flight trace to record for DTRQReplayer
+int main(int argc, char *argv[]) {
 	signal(SIGINT, &sighandler);
 
 	std::cout << "Starting quadcopter..." << std::endl;
 	auto previousTime = std::chrono::system_clock::now();
 
-	Quaternion rotation;
-	Vector3D worldAccel;
-
 	i2cController = new I2CController(0x70);
 
 	i2cController->InitializePCA();
@@ -113,10 +97,6 @@ int main() {
 
 	previousTime = std::chrono::system_clock::now();
 
-	VectorFIRFilter acceMHP = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
-	VectorFIRFilter acceFHP = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
-	VectorFIRFilter acceBHP = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
-
 	while (calTime < 3) {
 		calTime = ((double)((std::chrono::system_clock::now() - previousTime).count()) / pow(10.0, 9.0));
 		Quaternion gm = i2cController->GetMainRotation();
@@ -145,54 +125,41 @@ int main() {
 	std::cout << "Offsets Captured." << std::endl;
 	////////////////////////////////////
 
+	flightLoop = new FlightLoop(forwaOffset, backaOffset);
+
+	if (argc > 1 && recorder.OpenWrite(argv[1], forwaOffset, backaOffset)) {
+		std::cout << "Recording flight trace to " << argv[1] << std::endl;
+	}
+
 	previousTime = std::chrono::system_clock::now();
 	std::cout << "Beginning control loop..." << std::endl;
 	while (true) {
-		double dT = ((double)((std::chrono::system_clock::now() - previousTime).count()) / pow(10.0, 9.0));
+		FlightLoop::Inputs inputs;
+
+		inputs.dT = ((double)((std::chrono::system_clock::now() - previousTime).count()) / pow(10.0, 9.0));
 		previousTime = std::chrono::system_clock::now();
 
-		Vector3D am, af, ab;
-		af = i2cController->GetMainFWorldAcceleration().Add(forwaOffset);
-		ab = i2cController->GetMainBWorldAcceleration().Add(backaOffset);
+		inputs.MainFAcceleration = i2cController->GetMainFWorldAcceleration();
+		inputs.MainBAcceleration = i2cController->GetMainBWorldAcceleration();
 
-		Quaternion qm, qf, qb;
 		//qm = i2cController->GetMainRotation();
-		qf = i2cController->GetMainFRotation().UnitQuaternion();// .Multiply(forwgOffset);//correct initial offset
-		qb = i2cController->GetMainBRotation().UnitQuaternion();// .Multiply(backgOffset);
-
-		//quatKF.Filter(qm);
-		quatKF.Filter(qb);
-		rotation = quatKF.Filter(qf).UnitQuaternion();
-
-		// -1000 / af
-
-		//worldAccel = af;//(af.Add(ab)).Divide(2);
-		//acceFHP.Filter(accelKF.Filter(af));
-		worldAccel = acceBHP.Filter(ab.Divide(2.0)).Add(acceFHP.Filter(af.Divide(2.0)));//accelkf
-		//worldAccel = ab.Divide(2.0).Add(af.Divide(2.0));
+		inputs.MainFRotation = i2cController->GetMainFRotation();// .Multiply(forwgOffset);//correct initial offset
+		inputs.MainBRotation = i2cController->GetMainBRotation();// .Multiply(backgOffset);
 
-		//std::cout << rotation.ToString() << std::endl;
+		inputs.TargetPosition = targetPosition;
+		inputs.TargetRotation = Quaternion(targetRotation.GetQuaternion());
 
-		velocity = velocity.Add(worldAccel.Multiply(9.81).Multiply(dT));//g-force to m/s^2
-		position = position.Add(velocity.Multiply(dT));
+		FlightLoop::Outputs outputs = flightLoop->Tick(inputs);
 
-		std::cout << worldAccel.ToString() << " " << position.ToString() << std::endl;
+		recorder.Record(inputs, outputs);
 
-		quad.SetTarget(position, rotation);
-		quad.SetCurrent(position, rotation);
-
-		quad.CalculateCombinedThrustVector();//Secondary Solver
-
-		EulerAngles eaypr = Rotation(Quaternion(rotation)).GetEulerAngles(EulerConstants::EulerOrderYXZS);
-		
-		//std::cout << eaypr.Angles.ToString() << std::endl;
-		//std::cout  << position.ToString() << " " << velocity.ToString() << " " << worldAccel.ToString() << std::endl;
+		std::cout << outputs.WorldAcceleration.ToString() << " " << outputs.Position.ToString() << std::endl;
 		
 		//set outputs
-		i2cController->SetBThrustVector(Vector3D(-quad.TB->CurrentRotation.X, 0, -quad.TB->CurrentRotation.Z));
-		i2cController->SetCThrustVector(Vector3D(-quad.TC->CurrentRotation.X, 0,  quad.TC->CurrentRotation.Z));
-		i2cController->SetDThrustVector(Vector3D( quad.TD->CurrentRotation.X, 0,  quad.TD->CurrentRotation.Z));
-		i2cController->SetEThrustVector(Vector3D( quad.TE->CurrentRotation.X, 0, -quad.TE->CurrentRotation.Z));
+		i2cController->SetBThrustVector(outputs.ThrustB);
+		i2cController->SetCThrustVector(outputs.ThrustC);
+		i2cController->SetDThrustVector(outputs.ThrustD);
+		i2cController->SetEThrustVector(outputs.ThrustE);
 		
 		bcm2835_delay(1);
 	}
@@ -215,7 +182,8 @@ int main() {
 	std::cout << "Removing objects from memory." << std::endl;
 
 	i2cController->~I2CController();
-	quad.~Quadcopter();
+	recorder.Close();
+	delete flightLoop;
 
 	std::cout << "End of control." << std::endl;
 
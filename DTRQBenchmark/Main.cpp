@@ -0,0 +1,971 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EulerConversion.h"
+#include "FastFourierTransform.h"
+#include "FFTPlan.h"
+#include "FIRBank.h"
+#include "FiniteImpulseResponse.h"
+#include "FixedPoint.h"
+#include "Mathematics.h"
+#include "Matrix3.h"
+#include "PID.h"
+#include "PowerSpectralDensity.h"
+#include "Quadcopter.h"
+#include "Quaternion.h"
+#include "QuaternionKalmanFilter.h"
+#include "RealFFTPlan.h"
+#include "Rotation.h"
+#include "RotationBatch.h"
+#include "RotationMatrix.h"
+#include "SIMD.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+#include "VectorFeedbackController.h"
+#include "VectorFIRFilter.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//Times the math kernels in nanoseconds per operation, each kernel runs over a block of random inputs, compares float
+//and double flight trajectories and flight loop filters, times the Quadcopter step, the batch conversions of a flight log, the FFTs
+//and the Welch spectrum
+typedef struct Options {
+	std::string Suite = "all";
+	int Iterations = 2000;//passes over the input block
+	double Seconds = 600;//simulated flight for the precision suite
+	int Samples = 10000000;//recorded quaternions for the batch suite
+} Options;
+
+const int BlockSize = 1024;
+
+volatile double sink;
+
+void PrintUsage() {
+	std::cout << "Usage: DTRQBenchmark [--suite all|vector|precision|step|batch|fft] [--iterations N] [--seconds S] [--samples N]" << std::endl;
+}
+
+bool ParseArguments(int argc, char *argv[], Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+
+		if (i + 1 >= argc) {
+			std::cout << "Missing value for " << argument << std::endl;
+			return false;
+		}
+
+		char *end = nullptr;
+		const char *value = argv[++i];
+
+		if (argument == "--suite") {
+			options.Suite = value;
+			continue;
+		}
+		else if (argument == "--iterations") options.Iterations = (int)strtol(value, &end, 10);
+		else if (argument == "--seconds") options.Seconds = strtod(value, &end);
+		else if (argument == "--samples") options.Samples = (int)strtol(value, &end, 10);
+		else {
+			std::cout << "Unknown argument " << argument << std::endl;
+			return false;
+		}
+
+		if (*end != '\0') {
+			std::cout << "Invalid value for " << argument << ": " << value << std::endl;
+			return false;
+		}
+	}
+
+	if (options.Iterations <= 0) {
+		std::cout << "Iterations must be positive." << std::endl;
+		return false;
+	}
+
+	if (options.Seconds <= 0) {
+		std::cout << "Seconds must be positive." << std::endl;
+		return false;
+	}
+
+	if (options.Samples <= 0) {
+		std::cout << "Samples must be positive." << std::endl;
+		return false;
+	}
+
+	if (options.Suite != "all" && options.Suite != "vector" && options.Suite != "precision" && options.Suite != "step" && options.Suite != "batch" &&
+		options.Suite != "fft") {
+		std::cout << "Unknown suite " << options.Suite << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//Runs operation over the block once to warm up, then iterations times, and returns nanoseconds per operation
+template <typename Operation>
+double Measure(int iterations, Operation operation) {
+	double total = 0;
+
+	for (int i = 0; i < BlockSize; i++) total += operation(i);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		for (int i = 0; i < BlockSize; i++) {
+			total += operation(i);
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	sink = total;
+
+	return seconds * 1e9 / ((double)iterations * BlockSize);
+}
+
+std::string Scientific(double value) {
+	std::ostringstream stream;
+
+	stream << std::scientific << std::setprecision(2) << value;
+
+	return stream.str();
+}
+
+void Report(std::string name, double scalar, double vector) {
+	std::cout << "  " << name << std::string(18 - name.length(), ' ') <<
+		"scalar ns/op: " << Mathematics::DoubleToCleanString(scalar) <<
+		" " << SIMD::Backend() << " ns/op: " << Mathematics::DoubleToCleanString(vector) <<
+		" speedup: " << Mathematics::DoubleToCleanString(scalar / vector) << std::endl;
+}
+
+//Two implementations of the same operation, both built for the current backend
+void Compare(std::string name, double before, double after) {
+	std::cout << "  " << name << std::string(18 - name.length(), ' ') <<
+		"before ns/op: " << Mathematics::DoubleToCleanString(before) <<
+		" after ns/op: " << Mathematics::DoubleToCleanString(after) <<
+		" speedup: " << Mathematics::DoubleToCleanString(before / after) << std::endl;
+}
+
+void RunVectorSuite(int iterations) {
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> value(-1.0, 1.0);
+	std::vector<double> a(BlockSize * 4), b(BlockSize * 4);
+	std::vector<Quaternion> quaternions(BlockSize), others(BlockSize);
+	std::vector<Vector3D> vectors(BlockSize), batchOutput(BlockSize);
+
+	for (int i = 0; i < BlockSize * 4; i++) {
+		a[i] = value(generator);
+		b[i] = value(generator);
+	}
+
+	for (int i = 0; i < BlockSize; i++) {
+		quaternions[i] = Quaternion(a[i * 4], a[i * 4 + 1], a[i * 4 + 2], a[i * 4 + 3]);
+		others[i] = Quaternion(b[i * 4], b[i * 4 + 1], b[i * 4 + 2], b[i * 4 + 3]);
+		vectors[i] = Vector3D(b[i * 4], b[i * 4 + 1], b[i * 4 + 2]);
+	}
+
+	std::cout << "Vector kernels, backend " << SIMD::Backend() << ", " << iterations << " x " << BlockSize << " operations" << std::endl;
+
+	double result[4];
+
+	Report("Multiply",
+		Measure(iterations, [&](int i) { SIMD::ScalarQuaternionMultiply(&a[i * 4], &b[i * 4], result); return result[0]; }),
+		Measure(iterations, [&](int i) { SIMD::QuaternionMultiply(&a[i * 4], &b[i * 4], result); return result[0]; }));
+
+	Report("Dot",
+		Measure(iterations, [&](int i) { return SIMD::ScalarDot(&a[i * 4], &b[i * 4], 4); }),
+		Measure(iterations, [&](int i) { return SIMD::Dot(&a[i * 4], &b[i * 4], 4); }));
+
+	Report("Rotate",
+		Measure(iterations, [&](int i) { SIMD::ScalarRotate(&a[i * 4], &b[i * 4], 2.0, result); return result[0]; }),
+		Measure(iterations, [&](int i) { SIMD::RotateUnitVector(&a[i * 4], &b[i * 4], result); return result[0]; }));
+
+	//Single precision, a quaternion fills one SSE register
+	std::vector<float> aF(a.begin(), a.end()), bF(b.begin(), b.end());
+	float resultF[4];
+
+	Report("Multiply float",
+		Measure(iterations, [&](int i) { SIMD::ScalarQuaternionMultiply(&aF[i * 4], &bF[i * 4], resultF); return (double)resultF[0]; }),
+		Measure(iterations, [&](int i) { SIMD::QuaternionMultiply(&aF[i * 4], &bF[i * 4], resultF); return (double)resultF[0]; }));
+
+	Report("Rotate float",
+		Measure(iterations, [&](int i) { SIMD::ScalarRotate(&aF[i * 4], &bF[i * 4], 2.0f, resultF); return (double)resultF[0]; }),
+		Measure(iterations, [&](int i) { SIMD::RotateUnitVector(&aF[i * 4], &bF[i * 4], resultF); return (double)resultF[0]; }));
+
+	//Rotation paths, before is the previous two Hamilton products and the inverse, then the expanded form against
+	//the unit fast path, then one rotation per vector against a matrix built once per block
+	std::cout << "Rotation paths" << std::endl;
+
+	double matrix[9];
+	std::vector<double> rotated(BlockSize * 3);
+
+	Compare("RotateVector",
+		Measure(iterations, [&](int i) {
+			const double *q = &a[i * 4];
+			double n = 1.0 / SIMD::ScalarDot(q, q, 4);
+			double inverse[4] = { q[0] * n, -q[1] * n, -q[2] * n, -q[3] * n };
+			double pure[4] = { 0.0, b[i * 4], b[i * 4 + 1], b[i * 4 + 2] };
+			double product[4];
+
+			SIMD::QuaternionMultiply(q, pure, product);
+			SIMD::QuaternionMultiply(product, inverse, result);
+
+			return result[1];
+		}),
+		Measure(iterations, [&](int i) { SIMD::RotateVector(&a[i * 4], &b[i * 4], result); return result[0]; }));
+
+	Compare("RotateUnitVector",
+		Measure(iterations, [&](int i) { SIMD::RotateVector(&a[i * 4], &b[i * 4], result); return result[0]; }),
+		Measure(iterations, [&](int i) { SIMD::RotateUnitVector(&a[i * 4], &b[i * 4], result); return result[0]; }));
+
+	Compare("TransformVectors",
+		Measure(iterations, [&](int i) { SIMD::RotateVector(a.data(), &b[i * 3], &rotated[i * 3]); return rotated[i * 3]; }),
+		Measure(iterations, [&](int i) {
+			if (i == 0) {
+				SIMD::RotationMatrix(a.data(), matrix);
+				SIMD::TransformVectors(matrix, b.data(), rotated.data(), BlockSize);
+			}
+
+			return rotated[i * 3];
+		}));
+
+	//Euler rotations as the thrusters use them, outer and inner joint angles in degrees, before rebuilds the matrix
+	//and its trig for every vector, after builds it once
+	std::vector<Vector3D> angles(BlockSize);
+
+	for (int i = 0; i < BlockSize; i++) {
+		angles[i] = Vector3D(a[i * 4] * 60.0, 0, a[i * 4 + 1] * 60.0);
+	}
+
+	Matrix3 rotation = Matrix3::RotationXYZ(angles[0]);
+
+	Compare("Matrix3 reuse",
+		Measure(iterations, [&](int i) { return RotationMatrix::RotateVector(angles[0], vectors[i]).Y; }),
+		Measure(iterations, [&](int i) { return rotation.Multiply(vectors[i]).Y; }));
+
+	//Thruster joint quaternion, before goes through Rotation and the runtime order, after is specialised for ZYXS
+	Compare("Euler order",
+		Measure(iterations, [&](int i) { return Rotation(EulerAngles(angles[i], EulerConstants::EulerOrderZYXS)).GetQuaternion().W; }),
+		Measure(iterations, [&](int i) { return EulerConversion::ToQuaternion<EulerConstants::EulerOrderZYXSTag>(angles[i]).W; }));
+
+	//libm against the approximate policy kernels, angles within a turn as the conversions see them
+	std::cout << "Trigonometry" << std::endl;
+
+	std::vector<double> radians(BlockSize);
+
+	for (int i = 0; i < BlockSize; i++) radians[i] = a[i] * Mathematics::PI;
+
+	Compare("SinCos",
+		Measure(iterations, [&](int i) { return sin(radians[i]) + cos(radians[i]); }),
+		Measure(iterations, [&](int i) { double s, c; Trigonometry::ApproximateSinCos(radians[i], s, c); return s + c; }));
+
+	Compare("Atan2",
+		Measure(iterations, [&](int i) { return atan2(a[i], b[i]); }),
+		Measure(iterations, [&](int i) { return Trigonometry::ApproximateAtan2(a[i], b[i]); }));
+
+	Compare("Asin",
+		Measure(iterations, [&](int i) { return asin(a[i]); }),
+		Measure(iterations, [&](int i) { return Trigonometry::ApproximateAsin(a[i]); }));
+
+	Compare("Acos",
+		Measure(iterations, [&](int i) { return acos(a[i]); }),
+		Measure(iterations, [&](int i) { return Trigonometry::ApproximateAcos(a[i]); }));
+
+	Trigonometry::SetPolicy(Trigonometry::Approximate);
+
+	double approximateEuler = Measure(iterations, [&](int i) { return EulerConversion::ToQuaternion<EulerConstants::EulerOrderZYXSTag>(angles[i]).W; });
+
+	Trigonometry::SetPolicy(Trigonometry::Exact);
+
+	Compare("Euler policy",
+		Measure(iterations, [&](int i) { return EulerConversion::ToQuaternion<EulerConstants::EulerOrderZYXSTag>(angles[i]).W; }),
+		approximateEuler);
+
+	//One DMP sample to a world frame linear acceleration, before is the float path MPUController took through
+	//QuaternionFloat, dmpGetGravity and a double rotation, after stays in Q30/Q14 and converts at the end
+	std::cout << "DMP samples" << std::endl;
+
+	std::vector<int32_t> quaternionWords(BlockSize * 4);
+	std::vector<int16_t> accelerationWords(BlockSize * 3);
+
+	for (int i = 0; i < BlockSize; i++) {
+		double norm = quaternions[i].Magnitude();
+
+		for (int j = 0; j < 4; j++) quaternionWords[i * 4 + j] = (int32_t)(a[i * 4 + j] / norm * (1 << 30));
+		for (int j = 0; j < 3; j++) accelerationWords[i * 3 + j] = (int16_t)(b[i * 4 + j] * 16384);
+	}
+
+	Compare("DMP fusion",
+		Measure(iterations, [&](int i) {
+			const int32_t *w = &quaternionWords[i * 4];
+			const int16_t *r = &accelerationWords[i * 3];
+			float qw = (float)(int16_t)(w[0] >> 16) / 16384.0f, qx = (float)(int16_t)(w[1] >> 16) / 16384.0f;
+			float qy = (float)(int16_t)(w[2] >> 16) / 16384.0f, qz = (float)(int16_t)(w[3] >> 16) / 16384.0f;
+			float gx = 2 * (qx * qz - qw * qy), gy = 2 * (qw * qx + qy * qz), gz = qw * qw - qx * qx - qy * qy + qz * qz;
+			int16_t lx = (int16_t)(r[0] - gx * 16384), ly = (int16_t)(r[1] - gy * 16384), lz = (int16_t)(r[2] - gz * 16384);
+			Quaternion q = Quaternion(qw, qx, qy, qz);
+
+			return q.RotateVector(Vector3D(lx, ly, lz) / 16384).Y;
+		}),
+		Measure(iterations, [&](int i) {
+			const int16_t *r = &accelerationWords[i * 3];
+			QuaternionQ30 q = QuaternionQ30::FromDMP(&quaternionWords[i * 4]).UnitQuaternion();
+
+			return q.RotateVector(q.LinearAcceleration(Vector3Q14(r[0], r[1], r[2]))).ToVector3D().Y;
+		}));
+
+	//The flight loop's 100 tap accelerometer high pass, before is the shift register FiniteImpulseResponse inserted
+	//into at the front of a vector, after the mirrored delay line and the interleaved vector filter
+	std::cout << "Filters" << std::endl;
+
+	FiniteImpulseResponse fir = FiniteImpulseResponse(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+	VectorFIRFilter vectorFIR = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+	std::vector<double> firTaps = fir.GetTaps();
+	std::vector<double> shiftRegisters[3];
+
+	auto shiftRegisterFilter = [&](std::vector<double> &sr, double sample) {
+		double output = 0.0;
+
+		sr.insert(sr.begin(), sample);
+		sr.pop_back();
+		sr.resize(firTaps.size());
+
+		for (int j = 0; j < (int)firTaps.size(); j++) output += sr.at(j) * firTaps.at(j);
+
+		return output;
+	};
+
+	Compare("FIR 100 taps",
+		Measure(iterations, [&](int i) { return shiftRegisterFilter(shiftRegisters[0], a[i]); }),
+		Measure(iterations, [&](int i) { return fir.Filter(a[i]); }));
+
+	Compare("Vector FIR",
+		Measure(iterations, [&](int i) {
+			return shiftRegisterFilter(shiftRegisters[0], vectors[i].X) + shiftRegisterFilter(shiftRegisters[1], vectors[i].Y) +
+				shiftRegisterFilter(shiftRegisters[2], vectors[i].Z);
+		}),
+		Measure(iterations, [&](int i) { Vector3D filtered = vectorFIR.Filter(vectors[i]); return filtered.X + filtered.Y + filtered.Z; }));
+
+	//Front and back accelerometers as the flight loop filters them, two vector filters against one folded bank
+	VectorFIRFilter backFIR = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+	FIRBank bank = FIRBank(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+
+	Compare("FIR bank 6 ch",
+		Measure(iterations, [&](int i) {
+			return backFIR.Filter(others[i].GetBiVector()).Add(vectorFIR.Filter(vectors[i])).X;
+		}),
+		Measure(iterations, [&](int i) {
+			Vector3D back = others[i].GetBiVector();
+			double samples[6] = { vectors[i].X, vectors[i].Y, vectors[i].Z, back.X, back.Y, back.Z };
+
+			bank.Filter(samples, samples);
+
+			return samples[3] + samples[0];
+		}));
+
+	//Public API, includes the struct copies around the kernels
+	std::cout << "Quaternion and Vector3D methods" << std::endl;
+
+	double multiply = Measure(iterations, [&](int i) { return quaternions[i].Multiply(others[i]).W; });
+	double rotate = Measure(iterations, [&](int i) { return quaternions[i].RotateVector(vectors[i]).X; });
+	double euler = Measure(iterations, [&](int i) { return RotationMatrix::RotateVector(angles[i], vectors[i]).Y; });
+	double batch = Measure(iterations, [&](int i) {
+		if (i == 0) Quaternion::RotateVectors(quaternions[0], vectors.data(), batchOutput.data(), BlockSize);
+
+		return batchOutput[i].X;
+	});
+	double unit = Measure(iterations, [&](int i) { return quaternions[i].UnitQuaternion().W; });
+	double dot = Measure(iterations, [&](int i) { return quaternions[i].DotProduct(others[i]); });
+	double cross = Measure(iterations, [&](int i) { return vectors[i].CrossProduct(vectors[BlockSize - 1 - i]).X; });
+
+	std::cout << "  Quaternion::Multiply      ns/op: " << Mathematics::DoubleToCleanString(multiply) << std::endl;
+	std::cout << "  Quaternion::RotateVector  ns/op: " << Mathematics::DoubleToCleanString(rotate) << std::endl;
+	std::cout << "  Quaternion::RotateVectors ns/op: " << Mathematics::DoubleToCleanString(batch) << std::endl;
+	std::cout << "  RotationMatrix::RotateVector ns/op: " << Mathematics::DoubleToCleanString(euler) << std::endl;
+	std::cout << "  Quaternion::UnitQuaternion ns/op: " << Mathematics::DoubleToCleanString(unit) << std::endl;
+	std::cout << "  Quaternion::DotProduct    ns/op: " << Mathematics::DoubleToCleanString(dot) << std::endl;
+	std::cout << "  Vector3D::CrossProduct    ns/op: " << Mathematics::DoubleToCleanString(cross) << std::endl;
+}
+
+template <typename T>
+struct FlightState {
+	Vector3<T> Position;
+	Vector3<T> Velocity;
+	QuaternionT<T> Attitude;
+};
+
+//Body rates and thrust are evaluated in double so both precisions fly the same inputs
+void FlightProfile(double time, Vector3D &rate, double &thrust) {
+	rate = Vector3D(0.4 * sin(0.31 * time), 0.6 * cos(0.17 * time), 0.3 * sin(0.53 * time));
+	thrust = 9.81 * (1.0 + 0.05 * sin(0.9 * time));
+}
+
+//One step of the rigid body, attitude from the body rate, then thrust rotated into the world frame against gravity
+//and quadratic drag
+template <typename T>
+void StepFlight(FlightState<T> &state, Vector3D rate, double thrust, T dT) {
+	QuaternionT<T> q = state.Attitude;
+
+	q = q.Add(QuaternionT<T>(Vector3<T>(rate)).Multiply(q).Multiply(T(0.5) * dT));
+	state.Attitude = q.Multiply(T(1) / q.Magnitude());
+
+	Vector3<T> force = state.Attitude.RotateVector(Vector3<T>(0, (T)thrust, 0));
+	Vector3<T> drag = state.Velocity.Multiply(state.Velocity.Absolute()).Multiply(T(0.05));
+
+	force = force.Add(Vector3<T>(0, T(-9.81), 0)).Subtract(drag);
+
+	state.Velocity = state.Velocity.Add(force.Multiply(dT));
+	state.Position = state.Position.Add(state.Velocity.Multiply(dT));
+}
+
+template <typename T>
+double TimeFlight(int steps, double dT) {
+	FlightState<T> state;
+	Vector3D rate;
+	double thrust;
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < steps; i++) {
+		FlightProfile(i * dT, rate, thrust);
+		StepFlight(state, rate, thrust, (T)dT);
+	}
+
+	sink = (double)state.Position.X;
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / steps;
+}
+
+//The filtering and dead reckoning of FlightLoop::Tick in either precision, inputs arrive in double as from the recorder
+template <typename T>
+struct FlightFilters {
+	QuaternionKalmanFilterT<T> RotationFilter = QuaternionKalmanFilterT<T>(T(0.75), 10);
+	FIRBankT<T> AccelerationFilter = FIRBankT<T>(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+	QuaternionT<T> Rotation;
+	Vector3<T> WorldAcceleration;
+	Vector3<T> Velocity;
+	Vector3<T> Position;
+
+	void Tick(Quaternion front, Quaternion back, Vector3D frontAcceleration, Vector3D backAcceleration, double dT) {
+		Vector3<T> af = Vector3<T>(frontAcceleration).Divide(T(2));
+		Vector3<T> ab = Vector3<T>(backAcceleration).Divide(T(2));
+		T accelerations[6] = { af.X, af.Y, af.Z, ab.X, ab.Y, ab.Z };
+
+		RotationFilter.Filter(QuaternionT<T>(back).UnitQuaternion());
+		Rotation = RotationFilter.Filter(QuaternionT<T>(front).UnitQuaternion()).UnitQuaternion();
+
+		AccelerationFilter.Filter(accelerations, accelerations);
+
+		WorldAcceleration = Vector3<T>(accelerations[3], accelerations[4], accelerations[5]).Add(Vector3<T>(accelerations[0], accelerations[1], accelerations[2]));
+		Velocity = Velocity.Add(WorldAcceleration.Multiply(T(9.81)).Multiply((T)dT));
+		Position = Position.Add(Velocity.Multiply((T)dT));
+	}
+};
+
+//Sensor readings of the double reference flight, each board with its own noise
+typedef struct SensorSample {
+	Quaternion Front;
+	Quaternion Back;
+	Vector3D FrontAcceleration;
+	Vector3D BackAcceleration;
+} SensorSample;
+
+std::vector<SensorSample> RecordSensors(int steps, double dT) {
+	std::vector<SensorSample> samples(steps);
+	std::mt19937 generator(23);
+	std::normal_distribution<double> noise(0.0, 1e-3);
+	FlightState<double> state;
+	Vector3D rate;
+	double thrust;
+
+	for (int i = 0; i < steps; i++) {
+		Vector3D previous = state.Velocity;
+
+		FlightProfile(i * dT, rate, thrust);
+		StepFlight(state, rate, thrust, dT);
+
+		Vector3D acceleration = state.Velocity.Subtract(previous).Divide(dT * 9.81);//m/s^2 to g-force
+
+		samples[i].Front = state.Attitude.Add(Quaternion(noise(generator), noise(generator), noise(generator), noise(generator)));
+		samples[i].Back = state.Attitude.Add(Quaternion(noise(generator), noise(generator), noise(generator), noise(generator)));
+		samples[i].FrontAcceleration = acceleration.Add(Vector3D(noise(generator), noise(generator), noise(generator)));
+		samples[i].BackAcceleration = acceleration.Add(Vector3D(noise(generator), noise(generator), noise(generator)));
+	}
+
+	return samples;
+}
+
+template <typename T>
+double TimeFilters(const std::vector<SensorSample> &samples, int steps, double dT) {
+	FlightFilters<T> filters;
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < steps; i++) {
+		filters.Tick(samples[i].Front, samples[i].Back, samples[i].FrontAcceleration, samples[i].BackAcceleration, dT);
+	}
+
+	sink = (double)filters.Position.X;
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / steps;
+}
+
+//Feeds one recorded sensor stream through the flight loop filters in float and double
+void RunFilterPrecision(double seconds) {
+	const double dT = 0.001;
+	int steps = (int)(seconds / dT + 0.5);
+	int reportEvery = steps / 10 > 0 ? steps / 10 : 1;
+	std::vector<SensorSample> samples = RecordSensors(steps, dT);
+	FlightFilters<double> reference;
+	FlightFilters<float> single;
+	double maximumAcceleration = 0, maximumPosition = 0, maximumAttitude = 0;
+
+	std::cout << "Float against double flight loop filters, " << seconds << " s at dT " << dT << std::endl;
+
+	for (int i = 1; i <= steps; i++) {
+		const SensorSample &sample = samples[i - 1];
+
+		reference.Tick(sample.Front, sample.Back, sample.FrontAcceleration, sample.BackAcceleration, dT);
+		single.Tick(sample.Front, sample.Back, sample.FrontAcceleration, sample.BackAcceleration, dT);
+
+		Quaternion attitudeSingle = Quaternion(single.Rotation);
+		double acceleration = Vector3D(single.WorldAcceleration).CalculateEuclideanDistance(reference.WorldAcceleration);
+		double position = Vector3D(single.Position).CalculateEuclideanDistance(reference.Position);
+		double dot = std::abs(attitudeSingle.DotProduct(reference.Rotation)) / (attitudeSingle.Magnitude() * reference.Rotation.Magnitude());
+		double attitude = Mathematics::RadiansToDegrees(2.0 * acos(Mathematics::Constrain(dot, -1, 1)));
+
+		maximumAcceleration = acceleration > maximumAcceleration ? acceleration : maximumAcceleration;
+		maximumPosition = position > maximumPosition ? position : maximumPosition;
+		maximumAttitude = attitude > maximumAttitude ? attitude : maximumAttitude;
+
+		if (i % reportEvery == 0 || i == steps) {
+			std::cout << "  t:" << Mathematics::DoubleToCleanString(i * dT) <<
+				" dead reckoned m:" << Mathematics::DoubleToCleanString(reference.Position.GetLength()) <<
+				" position error m: " << Scientific(position) <<
+				" acceleration error g: " << Scientific(acceleration) <<
+				" attitude error deg: " << Scientific(attitude) << std::endl;
+		}
+	}
+
+	std::cout << "  Maximum position error m: " << Scientific(maximumPosition) <<
+		" acceleration error g: " << Scientific(maximumAcceleration) <<
+		" attitude error deg: " << Scientific(maximumAttitude) << std::endl;
+
+	int timedSteps = steps < 100000 ? steps : 100000;
+
+	std::cout << "  double ns/tick: " << Mathematics::DoubleToCleanString(TimeFilters<double>(samples, timedSteps, dT)) <<
+		" float ns/tick: " << Mathematics::DoubleToCleanString(TimeFilters<float>(samples, timedSteps, dT)) << std::endl;
+}
+
+//Flies the same profile in float and double side by side and reports how far the float trajectory drifts
+void RunPrecisionSuite(double seconds) {
+	const double dT = 0.001;
+	int steps = (int)(seconds / dT + 0.5);
+	int reportEvery = steps / 10 > 0 ? steps / 10 : 1;
+	FlightState<double> reference;
+	FlightState<float> single;
+	Vector3D rate;
+	double thrust;
+	double maximumPosition = 0, maximumAttitude = 0;
+
+	std::cout << "Float against double trajectory, " << seconds << " s at dT " << dT << std::endl;
+
+	for (int i = 1; i <= steps; i++) {
+		FlightProfile((i - 1) * dT, rate, thrust);
+		StepFlight(reference, rate, thrust, dT);
+		StepFlight(single, rate, thrust, (float)dT);
+
+		//The float attitude is renormalized in double so its own rounding does not read as an attitude error
+		Quaternion attitudeSingle = Quaternion(single.Attitude);
+		double position = Vector3D(single.Position).CalculateEuclideanDistance(reference.Position);
+		double dot = std::abs(attitudeSingle.DotProduct(reference.Attitude)) / attitudeSingle.Magnitude();
+		double attitude = Mathematics::RadiansToDegrees(2.0 * acos(Mathematics::Constrain(dot, -1, 1)));
+
+		maximumPosition = position > maximumPosition ? position : maximumPosition;
+		maximumAttitude = attitude > maximumAttitude ? attitude : maximumAttitude;
+
+		if (i % reportEvery == 0 || i == steps) {
+			std::cout << "  t:" << Mathematics::DoubleToCleanString(i * dT) <<
+				" distance m:" << Mathematics::DoubleToCleanString(reference.Position.GetLength()) <<
+				" position error m: " << Scientific(position) <<
+				" relative: " << Scientific(position / reference.Position.GetLength()) <<
+				" attitude error deg: " << Scientific(attitude) << std::endl;
+		}
+	}
+
+	std::cout << "  Maximum position error m: " << Scientific(maximumPosition) <<
+		" maximum attitude error deg: " << Scientific(maximumAttitude) << std::endl;
+
+	int timedSteps = steps < 100000 ? steps : 100000;
+
+	std::cout << "  double ns/step: " << Mathematics::DoubleToCleanString(TimeFlight<double>(timedSteps, dT)) <<
+		" float ns/step: " << Mathematics::DoubleToCleanString(TimeFlight<float>(timedSteps, dT)) << std::endl;
+
+	RunFilterPrecision(seconds);
+}
+
+//User space retired instructions where the kernel exposes the counter, timing alone otherwise
+typedef struct InstructionCounter {
+	int Descriptor = -1;
+
+	InstructionCounter() {
+#if defined(__linux__)
+		perf_event_attr attributes = perf_event_attr();
+
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		Descriptor = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+	}
+
+	~InstructionCounter() {
+#if defined(__linux__)
+		if (Descriptor >= 0) close(Descriptor);
+#endif
+	}
+
+	bool IsAvailable() {
+		return Descriptor >= 0;
+	}
+
+	void Start() {
+#if defined(__linux__)
+		if (Descriptor < 0) return;
+
+		ioctl(Descriptor, PERF_EVENT_IOC_RESET, 0);
+		ioctl(Descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+
+	long long Stop() {
+		long long count = 0;
+
+#if defined(__linux__)
+		if (Descriptor < 0) return 0;
+
+		ioctl(Descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+		if (read(Descriptor, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+
+		return count;
+	}
+} InstructionCounter;
+
+//Closed loop hover recovery as the campaign flies it, SetTarget, SimulateCurrent and CalculateCombinedThrustVector
+//per step
+void RunStepSuite(int iterations) {
+	const char *names[3] = { "SemiImplicitEuler", "RungeKutta4", "ExponentialMap" };
+	const double dT = 0.001;
+	int steps = iterations * 10;
+	InstructionCounter counter;
+	std::streambuf *output = std::cout.rdbuf();
+
+	std::cout << "Quadcopter step, " << steps << " steps at dT " << dT << ", instruction counter " <<
+		(counter.IsAvailable() ? "available" : "unavailable") << std::endl;
+
+	for (int run = 0; run < 6; run++) {
+		int integrator = run % 3;
+		Trigonometry::Policy policy = run < 3 ? Trigonometry::Exact : Trigonometry::Approximate;
+
+		Trigonometry::SetPolicy(policy);
+
+		if (integrator == 0) std::cout << (policy == Trigonometry::Exact ? " Exact trigonometry" : " Approximate trigonometry") << std::endl;
+
+		VectorFeedbackController *pos = new VectorFeedbackController{
+			new PID{ 10, 0, 12.5 },
+			new PID{ 1, 0, 0.2 },
+			new PID{ 10, 0, 12.5 }
+		};
+
+		VectorFeedbackController *rot = new VectorFeedbackController{
+			new PID{ 0.05, 0, 0.325 },
+			new PID{ 0.05, 0, 0.325 },
+			new PID{ 0.05, 0, 0.325 }
+		};
+
+		std::cout.rdbuf(nullptr);//constructor diagnostics
+
+		Quadcopter quad(true, 0.3, 55, dT, pos, rot);
+
+		std::cout.rdbuf(output);
+
+		Vector3D target = Vector3D(0, 0, 0);
+		Rotation level = Rotation(Quaternion(1, 0, 0, 0));
+
+		quad.SetIntegrator((Quadcopter::Integrator)integrator);
+		quad.SetFeedbackEnabled(true);
+		quad.SetCurrent(Vector3D(1, 2, -1), Rotation(EulerAngles(Vector3D(10, -5, 20), EulerConstants::EulerOrderXYZS)));
+
+		Rotation::ResetCacheCounters();
+
+		auto start = std::chrono::steady_clock::now();
+
+		counter.Start();
+
+		for (int i = 0; i < steps; i++) {
+			quad.SetTarget(target, level);
+			quad.SimulateCurrent(Vector3D(0, 0, 0));
+			quad.CalculateCombinedThrustVector();
+		}
+
+		long long instructions = counter.Stop();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		sink = quad.CurrentPosition.X;
+
+		std::cout << "  " << names[integrator] << std::string(20 - std::string(names[integrator]).length(), ' ') <<
+			"ns/step: " << Mathematics::DoubleToCleanString(seconds * 1e9 / steps);
+
+		if (counter.IsAvailable()) std::cout << " instructions/step: " << Mathematics::DoubleToCleanString((double)instructions / steps);
+
+		std::cout << " rotation cache hits/step: " << Mathematics::DoubleToCleanString((double)Rotation::GetCacheHits() / steps) <<
+			" misses/step: " << Mathematics::DoubleToCleanString((double)Rotation::GetCacheMisses() / steps) << std::endl;
+	}
+
+	Trigonometry::SetPolicy(Trigonometry::Exact);
+}
+
+//Seconds for one call of operation
+template <typename Operation>
+double Time(Operation operation) {
+	auto start = std::chrono::steady_clock::now();
+
+	operation();
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//A recorded flight log converted to each representation, before goes sample by sample through Rotation, after through
+//RotationBatch on the calling thread and on every hardware thread
+void RunBatchSuite(int samples) {
+	std::mt19937 generator(5);
+	std::uniform_real_distribution<double> value(-1.0, 1.0);
+	std::vector<double> w(samples), x(samples), y(samples), z(samples);
+	std::vector<double> output[9];
+	WorkStealingPool serial = WorkStealingPool(1);
+	WorkStealingPool pool = WorkStealingPool();
+	int threads = pool.GetThreadCount();
+
+	for (int i = 0; i < samples; i++) {
+		Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+
+		q = q.Divide(q.Magnitude());
+
+		w[i] = q.W; x[i] = q.X; y[i] = q.Y; z[i] = q.Z;
+	}
+
+	for (int i = 0; i < 9; i++) output[i].resize(samples);
+
+	RotationBatch::QuaternionArrays quaternions = { w.data(), x.data(), y.data(), z.data() };
+	RotationBatch::VectorArrays first = { output[0].data(), output[1].data(), output[2].data() };
+	RotationBatch::VectorArrays second = { output[3].data(), output[4].data(), output[5].data() };
+	RotationBatch::VectorArrays third = { output[6].data(), output[7].data(), output[8].data() };
+	double *rotations = output[3].data();
+
+	std::cout << "Flight log of " << samples << " samples, " << threads << " threads" << std::endl;
+
+	auto report = [&](std::string name, double before, double single, double threaded) {
+		Compare(name, before * 1e9 / samples, single * 1e9 / samples);
+		std::cout << "    threaded ns/op: " << Mathematics::DoubleToCleanString(threaded * 1e9 / samples) <<
+			" seconds: " << Mathematics::DoubleToCleanString(threaded) << std::endl;
+	};
+
+	report("Euler ZYXS",
+		Time([&]() { for (int i = 0; i < samples; i++) output[0][i] = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetEulerAngles(EulerConstants::EulerOrderZYXS).Angles.X; }),
+		Time([&]() { RotationBatch::ToEulerAngles(quaternions, EulerConstants::EulerOrderZYXS, first, samples, serial); }),
+		Time([&]() { RotationBatch::ToEulerAngles(quaternions, EulerConstants::EulerOrderZYXS, first, samples, pool); }));
+
+	report("Axis angle",
+		Time([&]() { for (int i = 0; i < samples; i++) output[0][i] = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetAxisAngle().Rotation; }),
+		Time([&]() { RotationBatch::ToAxisAngles(quaternions, first, rotations, samples, serial); }),
+		Time([&]() { RotationBatch::ToAxisAngles(quaternions, first, rotations, samples, pool); }));
+
+	report("Direction angle",
+		Time([&]() { for (int i = 0; i < samples; i++) output[0][i] = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetDirectionAngle().Rotation; }),
+		Time([&]() { RotationBatch::ToDirectionAngles(quaternions, first, rotations, samples, serial); }),
+		Time([&]() { RotationBatch::ToDirectionAngles(quaternions, first, rotations, samples, pool); }));
+
+	report("Rotation matrix",
+		Time([&]() { for (int i = 0; i < samples; i++) output[0][i] = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetRotationMatrix().YAxis.Z; }),
+		Time([&]() { RotationBatch::ToRotationMatrices(quaternions, first, second, third, samples, serial); }),
+		Time([&]() { RotationBatch::ToRotationMatrices(quaternions, first, second, third, samples, pool); }));
+
+	//Re-filtering one channel of the log with the longest FIR, one sample at a time against blocks
+	FiniteImpulseResponse direct = FiniteImpulseResponse(FiniteImpulseResponse::Low, 1000, 1000, 15, 0);
+	FiniteImpulseResponse blocks = FiniteImpulseResponse(FiniteImpulseResponse::Low, 1000, 1000, 15, 0);
+
+	Compare("FIR 1000 taps",
+		Time([&]() { for (int i = 0; i < samples; i++) output[0][i] = direct.Filter(x[i]); }) * 1e9 / samples,
+		Time([&]() { blocks.FilterBlock(x.data(), output[0].data(), samples); }) * 1e9 / samples);
+
+	sink = output[0][samples - 1];
+}
+
+//The recursive transform FFTPlan replaced, it split even and odd halves through a temporary array at every level
+//and evaluated each twiddle with exp
+void RecursivePerform(std::complex<double> *data, int length) {
+	if (length < 2) return;
+
+	std::complex<double> *odd = new std::complex<double>[length / 2];
+
+	for (int i = 0; i < length / 2; i++) odd[i] = data[i * 2 + 1];
+	for (int i = 0; i < length / 2; i++) data[i] = data[i * 2];
+	for (int i = 0; i < length / 2; i++) data[i + length / 2] = odd[i];
+
+	delete[] odd;
+
+	RecursivePerform(data, length / 2);
+	RecursivePerform(data + length / 2, length / 2);
+
+	for (int k = 0; k < length / 2; k++) {
+		std::complex<double> even = data[k];
+		std::complex<double> twiddle = exp(std::complex<double>(0, -2.0 * Mathematics::PI * k / length));
+		std::complex<double> product = twiddle * data[k + length / 2];
+
+		data[k] = even + product;
+		data[k + length / 2] = even - product;
+	}
+}
+
+//Forward transforms of each power of two length, about iterations * 1024 samples transformed per length, both sides
+//include copying the input back before each transform
+void RunFFTSuite(int iterations) {
+	std::mt19937 generator(17);
+	std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+	std::cout << "Forward FFT, ns per transform" << std::endl;
+
+	for (int length = 64; length <= 65536; length *= 2) {
+		std::vector<std::complex<double>> input(length), data(length);
+		FFTPlan plan = FFTPlan(length);
+		int repeats = iterations * 1024 / length > 4 ? iterations * 1024 / length : 4;
+
+		for (int i = 0; i < length; i++) input[i] = std::complex<double>(value(generator), value(generator));
+
+		double before = Time([&]() {
+			for (int r = 0; r < repeats; r++) {
+				data = input;
+				RecursivePerform(data.data(), length);
+			}
+		});
+		double after = Time([&]() {
+			for (int r = 0; r < repeats; r++) {
+				data = input;
+				plan.Forward(data.data());
+			}
+		});
+
+		sink = data[1].real();
+
+		Compare("FFT " + std::to_string(length), before * 1e9 / repeats, after * 1e9 / repeats);
+	}
+
+	//Real samples through the complex transform with zero imaginary parts against the half length real transform
+	std::cout << "Real input FFT, ns per transform" << std::endl;
+
+	for (int length = 64; length <= 65536; length *= 2) {
+		std::vector<double> input(length);
+		std::vector<std::complex<double>> data(length), spectrum(length / 2 + 1);
+		FFTPlan plan = FFTPlan(length);
+		RealFFTPlan real = RealFFTPlan(length);
+		int repeats = iterations * 1024 / length > 4 ? iterations * 1024 / length : 4;
+
+		for (int i = 0; i < length; i++) input[i] = value(generator);
+
+		double before = Time([&]() {
+			for (int r = 0; r < repeats; r++) {
+				FastFourierTransform::SetRealValues(data.data(), input.data(), length);
+				plan.Forward(data.data());
+			}
+		});
+		double after = Time([&]() {
+			for (int r = 0; r < repeats; r++) {
+				real.Forward(input.data(), spectrum.data());
+			}
+		});
+
+		sink = data[1].real() + spectrum[1].real();
+
+		Compare("Real FFT " + std::to_string(length), before * 1e9 / repeats, after * 1e9 / repeats);
+	}
+
+	//Welch spectrum of a vibration log of iterations * 1024 samples in half overlapped segments. Before is the
+	//spectrum as the filters took it, zero imaginary parts set and the parts pulled back out into new arrays
+	std::cout << "Welch PSD, ns per sample" << std::endl;
+
+	int count = iterations * 1024;
+	std::vector<double> vibration(count);
+
+	for (int i = 0; i < count; i++) vibration[i] = sin(0.3 * i) + 0.1 * value(generator);
+
+	for (int segmentLength = 256; segmentLength <= 4096; segmentLength *= 4) {
+		PowerSpectralDensity psd = PowerSpectralDensity(segmentLength, segmentLength / 2, 1000.0);
+		std::vector<double> density(psd.GetBins()), window(segmentLength), segment(segmentLength);
+		int segments = psd.GetSegments(count);
+
+		for (int i = 0; i < segmentLength; i++) window[i] = 0.5 - 0.5 * cos(2.0 * Mathematics::PI * i / segmentLength);
+
+		double before = Time([&]() {
+			for (int k = 0; k < psd.GetBins(); k++) density[k] = 0.0;
+
+			for (int s = 0; s < segments; s++) {
+				const double *start = &vibration[s * (segmentLength / 2)];
+				std::complex<double> *complex = new std::complex<double>[segmentLength];
+				double mean = 0.0;
+
+				for (int i = 0; i < segmentLength; i++) mean += start[i];
+
+				mean /= segmentLength;
+
+				for (int i = 0; i < segmentLength; i++) segment[i] = (start[i] - mean) * window[i];
+
+				FastFourierTransform::SetRealValues(complex, segment.data(), segmentLength);
+				FastFourierTransform::FFT(complex, segmentLength);
+
+				double *real = FastFourierTransform::GetRealValues(complex, segmentLength);
+				double *imaginary = FastFourierTransform::GetImagValues(complex, segmentLength);
+
+				for (int k = 0; k < psd.GetBins(); k++) density[k] += real[k] * real[k] + imaginary[k] * imaginary[k];
+
+				delete[] real;
+				delete[] imaginary;
+				delete[] complex;
+			}
+		});
+		double after = Time([&]() { psd.Estimate(vibration.data(), count, density.data()); });
+
+		sink = density[1];
+
+		Compare("Welch PSD " + std::to_string(segmentLength), before * 1e9 / count, after * 1e9 / count);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+
+	if (!ParseArguments(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+
+	if (options.Suite == "all" || options.Suite == "vector") RunVectorSuite(options.Iterations);
+	if (options.Suite == "all" || options.Suite == "precision") RunPrecisionSuite(options.Seconds);
+	if (options.Suite == "all" || options.Suite == "step") RunStepSuite(options.Iterations);
+	if (options.Suite == "all" || options.Suite == "batch") RunBatchSuite(options.Samples);
+	if (options.Suite == "all" || options.Suite == "fft") RunFFTSuite(options.Iterations);
+
+	return 0;
+}
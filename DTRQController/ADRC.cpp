@@ -5,6 +5,7 @@ ADRC::ADRC(double amplification, double damping, double plant, double precisionM
 	this->damping = damping;
 	this->plant = plant;
 	this->precisionModifier = precisionModifier;
+	this->precision = 0;
 	this->pid = pid;
 }
 
@@ -29,3 +30,35 @@ double ADRC::Calculate(double setpoint, double processVariable, double dT) {
 
 	return output.Current;
 }
+
+FeedbackController* ADRC::Clone() const {
+	return new ADRC(*this);
+}
+
+int ADRC::GetStateSize() {
+	return StateSize;
+}
+
+void ADRC::SaveState(double *state) {
+	ExtendedStateObserver::State observed = eso.GetState();
+
+	state[0] = output.Current;
+	state[1] = output.Previous;
+	state[2] = precision;
+
+	pid.SaveState(&state[3]);
+
+	state[3 + PID::StateSize] = observed.Z1;
+	state[4 + PID::StateSize] = observed.Z2;
+	state[5 + PID::StateSize] = observed.Z3;
+}
+
+void ADRC::LoadState(const double *state) {
+	output.Current = state[0];
+	output.Previous = state[1];
+	precision = state[2];
+
+	pid.LoadState(&state[3]);
+
+	eso.SetState(ExtendedStateObserver::State(state[3 + PID::StateSize], state[4 + PID::StateSize], state[5 + PID::StateSize]));
+}
@@ -21,4 +21,12 @@ public:
 	ADRC(double amplification, double damping, double plant, double precisionModifier, PID pid);
 	~ADRC();
 	double Calculate(double setpoint, double processVariable, double dT);
+
+	//Output, precision, PID and observer state
+	static const int StateSize = 3 + PID::StateSize + 3;
+
+	FeedbackController* Clone() const;
+	int GetStateSize();
+	void SaveState(double *state);
+	void LoadState(const double *state);
 };
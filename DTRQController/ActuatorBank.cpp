@@ -0,0 +1,141 @@
+#include "ActuatorBank.h"
+
+ActuatorBank::ActuatorBank() : ActuatorBank(0, 0, 0.0) {}
+
+ActuatorBank::ActuatorBank(int channels, int count, double dT) {
+	this->channels = channels;
+	this->count = count;
+	this->dT = dT;
+
+	springConstant.assign(channels, 0.0);
+
+	position.assign(channels * count, 0.0);
+	velocity.assign(channels * count, 0.0);
+	target.assign(channels * count, 0.0);
+
+	ee.assign(channels * count, 1.0);
+	ev.assign(channels * count, dT);
+	ve.assign(channels * count, 0.0);
+	vv.assign(channels * count, 1.0);
+}
+
+void ActuatorBank::CalculateCoefficients(int channel) {
+	//x'' = -k * e - 2 * sqrt(k) * x' has the repeated root -w, so over one step of length h
+	//e(h) = (e + (v + w * e) * h) * exp(-w * h) and v(h) = (v - w * (v + w * e) * h) * exp(-w * h)
+	double w = sqrt(springConstant[channel]);
+	double decay = exp(-w * dT);
+
+	for (int i = channel * count; i < (channel + 1) * count; i++) {
+		ee[i] = (1.0 + w * dT) * decay;
+		ev[i] = dT * decay;
+		ve[i] = -w * w * dT * decay;
+		vv[i] = (1.0 - w * dT) * decay;
+	}
+}
+
+void ActuatorBank::SetSpringConstant(int channel, double springConstant) {
+	this->springConstant[channel] = springConstant;
+
+	CalculateCoefficients(channel);
+}
+
+void ActuatorBank::SetTimeStep(double dT) {
+	if (this->dT == dT) return;
+
+	this->dT = dT;
+
+	for (int channel = 0; channel < channels; channel++) {
+		CalculateCoefficients(channel);
+	}
+}
+
+void ActuatorBank::SetTarget(int channel, int vehicle, double target) {
+	this->target[channel * count + vehicle] = target;
+}
+
+void ActuatorBank::Reset() {
+	std::fill(position.begin(), position.end(), 0.0);
+	std::fill(velocity.begin(), velocity.end(), 0.0);
+	std::fill(target.begin(), target.end(), 0.0);
+}
+
+void ActuatorBank::Step() {
+	Step(0, channels);
+}
+
+void ActuatorBank::Step(int first, int number) {
+	int begin = first * count;
+	int end = (first + number) * count;
+	double *p = position.data();
+	double *v = velocity.data();
+	const double *t = target.data();
+	const double *a = ee.data(), *b = ev.data(), *c = ve.data(), *d = vv.data();
+
+	for (int i = begin; i < end; i++) {
+		double error = p[i] - t[i];
+		double rate = v[i];
+
+		p[i] = t[i] + a[i] * error + b[i] * rate;
+		v[i] = c[i] * error + d[i] * rate;
+	}
+}
+
+int ActuatorBank::GetStateSize() {
+	return 3 * channels * count;
+}
+
+void ActuatorBank::SaveState(double *state) {
+	int size = channels * count;
+
+	std::copy(position.begin(), position.end(), state);
+	std::copy(velocity.begin(), velocity.end(), state + size);
+	std::copy(target.begin(), target.end(), state + 2 * size);
+}
+
+void ActuatorBank::LoadState(const double *state) {
+	int size = channels * count;
+
+	std::copy(state, state + size, position.begin());
+	std::copy(state + size, state + 2 * size, velocity.begin());
+	std::copy(state + 2 * size, state + 3 * size, target.begin());
+}
+
+int ActuatorBank::GetChannels() {
+	return channels;
+}
+
+int ActuatorBank::GetCount() {
+	return count;
+}
+
+double ActuatorBank::GetTimeStep() {
+	return dT;
+}
+
+double ActuatorBank::GetPosition(int channel, int vehicle) {
+	return position[channel * count + vehicle];
+}
+
+double ActuatorBank::GetVelocity(int channel, int vehicle) {
+	return velocity[channel * count + vehicle];
+}
+
+double ActuatorBank::GetTarget(int channel, int vehicle) {
+	return target[channel * count + vehicle];
+}
+
+void ActuatorBank::SetState(int channel, int vehicle, double position, double velocity, double target) {
+	int i = channel * count + vehicle;
+
+	this->position[i] = position;
+	this->velocity[i] = velocity;
+	this->target[i] = target;
+}
+
+double* ActuatorBank::GetPositions() {
+	return position.data();
+}
+
+double* ActuatorBank::GetTargets() {
+	return target.data();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "Mathematics.h"
+
+//Steps a set of critically damped springs with the closed form discrete solution, exact for a target held over
+//the step so it is stable for any dT. Values are indexed [channel * count + vehicle] and the coefficients are
+//expanded per value so the whole bank is updated in one contiguous pass.
+class ActuatorBank {
+private:
+	int channels;
+	int count;
+	double dT;
+
+	std::vector<double> springConstant;//per channel
+
+	std::vector<double> position;
+	std::vector<double> velocity;
+	std::vector<double> target;
+
+	//position error and velocity transition, e' = ee * e + ev * v and v' = ve * e + vv * v
+	std::vector<double> ee, ev, ve, vv;
+
+	void CalculateCoefficients(int channel);
+
+public:
+	ActuatorBank();
+	ActuatorBank(int channels, int count, double dT);
+
+	void SetSpringConstant(int channel, double springConstant);
+	void SetTimeStep(double dT);
+	void SetTarget(int channel, int vehicle, double target);
+	void Reset();
+	void Step();
+
+	//Steps only the springs of channels first to first + number - 1, for owners that command a subset on its own
+	void Step(int first, int number);
+
+	//Position, velocity and target of every spring, GetStateSize() values
+	int GetStateSize();
+	void SaveState(double *state);
+	void LoadState(const double *state);
+
+	int GetChannels();
+	int GetCount();
+	double GetTimeStep();
+	double GetPosition(int channel, int vehicle);
+	double GetVelocity(int channel, int vehicle);
+	double GetTarget(int channel, int vehicle);
+	void SetState(int channel, int vehicle, double position, double velocity, double target);
+	double* GetPositions();
+	double* GetTargets();
+};
@@ -1,20 +1,26 @@
 #include "AxisAngle.h"
 
-AxisAngle::AxisAngle(double rotation, double x, double y, double z) {
+template <typename T>
+AxisAngleT<T>::AxisAngleT(T rotation, T x, T y, T z) {
 	Rotation = rotation;
-	Axis = Vector3D(x, y, z);
+	Axis = Vector3<T>(x, y, z);
 }
 
-AxisAngle::AxisAngle(double rotation, Vector3D axis) {
+template <typename T>
+AxisAngleT<T>::AxisAngleT(T rotation, Vector3<T> axis) {
 	Rotation = rotation;
 	Axis = axis;
 }
 
-std::string AxisAngle::ToString() {
+template <typename T>
+std::string AxisAngleT<T>::ToString() {
 	std::string r = Mathematics::DoubleToCleanString(Rotation);
 	std::string x = Mathematics::DoubleToCleanString(Axis.X);
 	std::string y = Mathematics::DoubleToCleanString(Axis.Y);
 	std::string z = Mathematics::DoubleToCleanString(Axis.Z);
 
 	return r + ": [" + x + " " + y + " " + z + "]";
-}
\ No newline at end of file
+}
+
+template struct AxisAngleT<double>;
+template struct AxisAngleT<float>;
@@ -3,13 +3,18 @@
 #include "Mathematics.h"
 #include "Vector.h"
 
-typedef struct AxisAngle {
+//Scalar type as in Vector3, the double alias keeps the AxisAngle name
+template <typename T>
+struct AxisAngleT {
 public:
-	double Rotation;
-	Vector3D Axis;
+	T Rotation;
+	Vector3<T> Axis;
 
-	AxisAngle(double rotation, double x, double y, double z);
-	AxisAngle(double rotation, Vector3D axis);
+	AxisAngleT(T rotation, T x, T y, T z);
+	AxisAngleT(T rotation, Vector3<T> axis);
 
 	std::string ToString();
-} AxisAngle;
+};
+
+typedef AxisAngleT<double> AxisAngle;
+typedef AxisAngleT<float> AxisAngleF;
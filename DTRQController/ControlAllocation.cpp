@@ -0,0 +1,152 @@
+#include "ControlAllocation.h"
+
+ControlAllocation::ControlAllocation() : ControlAllocation(0.3, 55) {}
+
+ControlAllocation::ControlAllocation(double armLength, double armAngle) {
+	SetGeometry(armLength, armAngle);
+}
+
+void ControlAllocation::SetGeometry(double armLength, double armAngle) {
+	this->armLength = armLength;
+	this->armAngle = armAngle;
+	this->torque = CalculateTorque(armLength, armAngle);
+
+	CalculateEffectiveness();
+	CalculateAllocation();
+}
+
+double ControlAllocation::CalculateTorque(double armLength, double armAngle) {
+	return armLength * sin(Mathematics::DegreesToRadians(180 - armAngle)) * 5;
+}
+
+void ControlAllocation::CalculateEffectiveness() {
+	double t = torque;
+
+	//Arm torque pattern of the thrust components, TB and TC forward, TB and TE on the same side
+	const double arm[Axes][Thrusters * 3] = {
+		{ 0,  t,  0,    0,  t,  0,    0, -t,  0,    0, -t,  0 },
+		{ t,  0,  t,    t,  0, -t,   -t,  0, -t,   -t,  0,  t },
+		{ 0, -t,  0,    0,  t,  0,    0,  t,  0,    0, -t,  0 }
+	};
+
+	//Differential thrust, TB + TD - (TC + TE) added on every axis
+	const double differential[Thrusters] = { 1, -1, 1, -1 };
+
+	for (int axis = 0; axis < Axes; axis++) {
+		for (int thruster = 0; thruster < Thrusters; thruster++) {
+			for (int component = 0; component < 3; component++) {
+				int column = thruster * 3 + component;
+
+				effectiveness[axis][column] = arm[axis][column] + (component == axis ? differential[thruster] : 0);
+			}
+		}
+	}
+}
+
+bool ControlAllocation::CalculateAllocation() {
+	//Rotor effectiveness, the thrust Y column of each thruster
+	double rotor[Axes][Thrusters];
+
+	for (int axis = 0; axis < Axes; axis++) {
+		for (int thruster = 0; thruster < Thrusters; thruster++) {
+			rotor[axis][thruster] = effectiveness[axis][thruster * 3 + 1];
+		}
+	}
+
+	//Moore-Penrose inverse of the 3x4 rotor effectiveness, R^T * (R * R^T)^-1
+	double square[Axes][Axes];
+
+	for (int i = 0; i < Axes; i++) {
+		for (int j = 0; j < Axes; j++) {
+			square[i][j] = 0;
+
+			for (int thruster = 0; thruster < Thrusters; thruster++) {
+				square[i][j] += rotor[i][thruster] * rotor[j][thruster];
+			}
+		}
+	}
+
+	double inverse[Axes][Axes];
+	double determinant = square[0][0] * (square[1][1] * square[2][2] - square[1][2] * square[2][1]) -
+						 square[0][1] * (square[1][0] * square[2][2] - square[1][2] * square[2][0]) +
+						 square[0][2] * (square[1][0] * square[2][1] - square[1][1] * square[2][0]);
+
+	bool invertible = std::abs(determinant) > 1e-12;
+
+	if (!invertible) {
+		std::cout << "Control allocation is singular for arm length " << armLength << " and angle " << armAngle << ", using the transpose." << std::endl;
+	}
+
+	for (int i = 0; i < Axes; i++) {
+		for (int j = 0; j < Axes; j++) {
+			if (invertible) {
+				int i1 = (j + 1) % 3, i2 = (j + 2) % 3, j1 = (i + 1) % 3, j2 = (i + 2) % 3;
+
+				inverse[i][j] = (square[i1][j1] * square[i2][j2] - square[i1][j2] * square[i2][j1]) / determinant;
+			}
+			else {
+				inverse[i][j] = i == j ? 1 : 0;
+			}
+		}
+	}
+
+	for (int thruster = 0; thruster < Thrusters; thruster++) {
+		for (int axis = 0; axis < Axes; axis++) {
+			allocation[thruster][axis] = 0;
+
+			for (int k = 0; k < Axes; k++) {
+				allocation[thruster][axis] += rotor[k][thruster] * inverse[k][axis];
+			}
+		}
+	}
+
+	//The feedback controllers output the negated correction, so columns are flipped and scaled to unit peaks to
+	//keep the controller gains independent of the arm geometry
+	for (int axis = 0; axis < Axes; axis++) {
+		double peak = 0;
+
+		for (int thruster = 0; thruster < Thrusters; thruster++) {
+			peak = std::max(peak, std::abs(allocation[thruster][axis]));
+		}
+
+		for (int thruster = 0; thruster < Thrusters; thruster++) {
+			allocation[thruster][axis] = peak > 0 ? -allocation[thruster][axis] / peak : 0;
+		}
+	}
+
+	return invertible;
+}
+
+void ControlAllocation::Allocate(Vector3D command, double *rotorOutputs) {
+	for (int thruster = 0; thruster < Thrusters; thruster++) {
+		rotorOutputs[thruster] = allocation[thruster][0] * command.X + allocation[thruster][1] * command.Y + allocation[thruster][2] * command.Z;
+	}
+}
+
+Vector3D ControlAllocation::CalculateAngularAcceleration(const Vector3D *thrust) {
+	double acceleration[Axes] = { 0, 0, 0 };
+
+	for (int axis = 0; axis < Axes; axis++) {
+		const double *row = effectiveness[axis];
+
+		for (int thruster = 0; thruster < Thrusters; thruster++) {
+			acceleration[axis] += row[thruster * 3 + 0] * thrust[thruster].X +
+								  row[thruster * 3 + 1] * thrust[thruster].Y +
+								  row[thruster * 3 + 2] * thrust[thruster].Z;
+		}
+	}
+
+	return Vector3D::DegreesToRadians(Vector3D(acceleration[0], acceleration[1], acceleration[2]));
+}
+
+double ControlAllocation::GetTorque() {
+	return torque;
+}
+
+double ControlAllocation::GetEffectiveness(int axis, int column) {
+	return effectiveness[axis][column];
+}
+
+double ControlAllocation::GetAllocation(int thruster, int axis) {
+	return allocation[thruster][axis];
+}
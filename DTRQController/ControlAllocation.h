@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include "Mathematics.h"
+#include "Vector.h"
+
+//Thruster geometry compiled once into an effectiveness matrix and its normalized pseudo-inverse. The effectiveness
+//matrix maps the four thrust vectors to angular acceleration in the simulation and the allocation matrix maps a
+//roll, pitch and yaw command to the four rotor outputs.
+class ControlAllocation {
+public:
+	static const int Thrusters = 4;//TB, TC, TD, TE
+	static const int Axes = 3;
+
+private:
+	double armLength;
+	double armAngle;
+	double torque;
+
+	//Angular acceleration in degrees per thrust component, columns are X, Y, Z of TB then TC, TD, TE
+	double effectiveness[Axes][Thrusters * 3];
+
+	//Rotor output per unit of command on each axis, every column scaled to a largest magnitude of one
+	double allocation[Thrusters][Axes];
+
+	void CalculateEffectiveness();
+	bool CalculateAllocation();
+
+public:
+	ControlAllocation();
+	ControlAllocation(double armLength, double armAngle);
+
+	void SetGeometry(double armLength, double armAngle);
+	static double CalculateTorque(double armLength, double armAngle);
+
+	void Allocate(Vector3D command, double *rotorOutputs);
+	Vector3D CalculateAngularAcceleration(const Vector3D *thrust);
+
+	double GetTorque();
+	double GetEffectiveness(int axis, int column);
+	double GetAllocation(int thruster, int axis);
+};
@@ -1,20 +1,43 @@
 #include "CriticallyDampedSpring.h"
 
-CriticallyDampedSpring::CriticallyDampedSpring(double dT, double springConstant, std::string name) {
+CriticallyDampedSpring::CriticallyDampedSpring(double dT, double springConstant) {
 	this->dT = dT;
 	this->springConstant = springConstant;
 
-	std::cout << "    CDS for " << name << " initializing with: dT:" << dT << " K:" << springConstant << std::endl;
+	CalculateCoefficients();
+}
+
+void CriticallyDampedSpring::CalculateCoefficients() {
+	double w = sqrt(springConstant);
+	double decay = exp(-w * dT);
+
+	errorToError = (1.0 + w * dT) * decay;
+	velocityToError = dT * decay;
+	errorToVelocity = -w * w * dT * decay;
+	velocityToVelocity = (1.0 - w * dT) * decay;
 }
 
 double CriticallyDampedSpring::Calculate(double target) {
-	double currentToTarget = target - currentPosition;
-	double springForce = currentToTarget * springConstant;
-	double dampingForce = -currentVelocity * 2 * sqrt(springConstant);
-	double force = springForce + dampingForce;
+	double error = currentPosition - target;
 
-	currentVelocity += force * dT;
-	currentPosition += currentVelocity * dT;
+	currentPosition = target + errorToError * error + velocityToError * currentVelocity;
+	currentVelocity = errorToVelocity * error + velocityToVelocity * currentVelocity;
 
 	return currentPosition;
-}
\ No newline at end of file
+}
+
+void CriticallyDampedSpring::SetTimeStep(double dT) {
+	this->dT = dT;
+
+	CalculateCoefficients();
+}
+
+void CriticallyDampedSpring::SaveState(double *state) {
+	state[0] = currentPosition;
+	state[1] = currentVelocity;
+}
+
+void CriticallyDampedSpring::LoadState(const double *state) {
+	currentPosition = state[0];
+	currentVelocity = state[1];
+}
@@ -2,17 +2,27 @@
 
 #include "Mathematics.h"
 
+//Single critically damped spring using the same closed form step as ActuatorBank
 typedef struct CriticallyDampedSpring {
 private:
 	double dT;
 	double currentVelocity = 0.0;
 	double currentPosition = 0.0;
 	double springConstant;
-	std::string name;
+	double errorToError, velocityToError, errorToVelocity, velocityToVelocity;
+
+	void CalculateCoefficients();
 
 public:
-	CriticallyDampedSpring(double dT, double springConstant, std::string name);
+	CriticallyDampedSpring(double dT, double springConstant);
 
 	double Calculate(double target);
+	void SetTimeStep(double dT);
+
+	//Position then velocity
+	static const int StateSize = 2;
+
+	void SaveState(double *state);
+	void LoadState(const double *state);
 	
 } CriticallyDampedSpring;
@@ -1,20 +1,26 @@
 #include "DirectionAngle.h"
 
-DirectionAngle::DirectionAngle(double rotation, double x, double y, double z) {
+template <typename T>
+DirectionAngleT<T>::DirectionAngleT(T rotation, T x, T y, T z) {
 	Rotation = rotation;
-	Direction = Vector3D(x, y, z);
+	Direction = Vector3<T>(x, y, z);
 }
 
-DirectionAngle::DirectionAngle(double rotation, Vector3D direction) {
+template <typename T>
+DirectionAngleT<T>::DirectionAngleT(T rotation, Vector3<T> direction) {
 	Rotation = rotation;
 	Direction = direction;
 }
 
-std::string DirectionAngle::ToString() {
+template <typename T>
+std::string DirectionAngleT<T>::ToString() {
 	std::string r = Mathematics::DoubleToCleanString(Rotation);
 	std::string x = Mathematics::DoubleToCleanString(Direction.X);
 	std::string y = Mathematics::DoubleToCleanString(Direction.Y);
 	std::string z = Mathematics::DoubleToCleanString(Direction.Z);
 
 	return r + ": [" + x + " " + y + " " + z + "]";
-}
\ No newline at end of file
+}
+
+template struct DirectionAngleT<double>;
+template struct DirectionAngleT<float>;
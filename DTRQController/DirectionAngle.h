@@ -2,13 +2,18 @@
 
 #include "Vector.h"
 
-typedef struct DirectionAngle {
+//Scalar type as in Vector3, the double alias keeps the DirectionAngle name
+template <typename T>
+struct DirectionAngleT {
 public:
-	double Rotation;
-	Vector3D Direction;
+	T Rotation;
+	Vector3<T> Direction;
 
-	DirectionAngle(double rotation, double x, double y, double z);
-	DirectionAngle(double rotation, Vector3D direction);
+	DirectionAngleT(T rotation, T x, T y, T z);
+	DirectionAngleT(T rotation, Vector3<T> direction);
 
 	std::string ToString();
-} DirectionAngle;
\ No newline at end of file
+};
+
+typedef DirectionAngleT<double> DirectionAngle;
+typedef DirectionAngleT<float> DirectionAngleF;
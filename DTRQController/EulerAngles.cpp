@@ -1,18 +1,24 @@
 #include "EulerAngles.h"
 
-EulerAngles::EulerAngles() {
-	Angles = Vector3D(0, 0, 0);
+template <typename T>
+EulerAnglesT<T>::EulerAnglesT() {
+	Angles = Vector3<T>(0, 0, 0);
 	Order = EulerConstants::EulerOrderXYZS;
 }
 
-EulerAngles::EulerAngles(Vector3D angles, EulerOrder order) {
+template <typename T>
+EulerAnglesT<T>::EulerAnglesT(Vector3<T> angles, EulerOrder order) {
 	Angles = angles;
 	Order = order;
 }
 
-std::string EulerAngles::ToString() {
+template <typename T>
+std::string EulerAnglesT<T>::ToString() {
 	std::string angles = Angles.ToString();
 	std::string order = Order.ToString();
 
 	return "[ " + angles + ", " + order + " ]";
-}
\ No newline at end of file
+}
+
+template struct EulerAnglesT<double>;
+template struct EulerAnglesT<float>;
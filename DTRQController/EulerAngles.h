@@ -5,13 +5,18 @@
 #include "Mathematics.h"
 #include "Vector.h"
 
-typedef struct EulerAngles {
+//Scalar type as in Vector3, the double alias keeps the EulerAngles name
+template <typename T>
+struct EulerAnglesT {
 public:
-	Vector3D Angles;
+	Vector3<T> Angles;
 	EulerOrder Order;
 
-	EulerAngles();
-	EulerAngles(Vector3D angles, EulerOrder order);
+	EulerAnglesT();
+	EulerAnglesT(Vector3<T> angles, EulerOrder order);
 
 	std::string ToString();
-} EulerAngles;
\ No newline at end of file
+};
+
+typedef EulerAnglesT<double> EulerAngles;
+typedef EulerAnglesT<float> EulerAnglesF;
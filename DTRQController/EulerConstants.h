@@ -31,4 +31,32 @@ typedef struct EulerConstants {
 	static EulerOrder EulerOrderXYZR;
 	static EulerOrder EulerOrderZYZR;
 
+
+	//Compile time tags for the orders above, for EulerConversion
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderXYZSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderXYXSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderXZYSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderXZXSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderYZXSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderYZYSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderYXZSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderYXYSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderZXYSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderZXZSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static> EulerOrderZYXSTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static> EulerOrderZYZSTag;
+
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderZYXRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderXYXRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderYZXRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::X, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderXZXRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderXZYRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderYZYRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderZXYRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Y, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderYXYRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderYXZRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderZXZRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating> EulerOrderXYZRTag;
+	typedef EulerOrderTag<EulerOrder::Axis::Z, EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating> EulerOrderZYZRTag;
+
 } EulerConstants;
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "EulerConversion.h"
+
+//The double and float overloads share these
+template <typename T>
+static QuaternionT<T> DispatchToQuaternion(EulerAnglesT<T> eulerAngles) {
+	return EulerConversion::Dispatch(eulerAngles.Order, [&](auto tag) {
+		return EulerConversion::ToQuaternion<decltype(tag)>(eulerAngles.Angles);
+	});
+}
+
+template <typename T>
+static RotationMatrixT<T> DispatchToRotationMatrix(EulerAnglesT<T> eulerAngles) {
+	return EulerConversion::Dispatch(eulerAngles.Order, [&](auto tag) {
+		return EulerConversion::ToRotationMatrix<decltype(tag)>(eulerAngles.Angles);
+	});
+}
+
+template <typename T>
+static EulerAnglesT<T> DispatchToEulerAngles(RotationMatrixT<T> rM, EulerOrder order) {
+	Vector3<T> angles = EulerConversion::Dispatch(order, [&](auto tag) {
+		return EulerConversion::ToAngles<decltype(tag)>(rM);
+	});
+
+	return EulerAnglesT<T>(angles, order);
+}
+
+Quaternion EulerConversion::ToQuaternion(EulerAngles eulerAngles) {
+	return DispatchToQuaternion(eulerAngles);
+}
+
+RotationMatrix EulerConversion::ToRotationMatrix(EulerAngles eulerAngles) {
+	return DispatchToRotationMatrix(eulerAngles);
+}
+
+EulerAngles EulerConversion::ToEulerAngles(RotationMatrix rM, EulerOrder order) {
+	return DispatchToEulerAngles(rM, order);
+}
+
+QuaternionF EulerConversion::ToQuaternion(EulerAnglesF eulerAngles) {
+	return DispatchToQuaternion(eulerAngles);
+}
+
+RotationMatrixF EulerConversion::ToRotationMatrix(EulerAnglesF eulerAngles) {
+	return DispatchToRotationMatrix(eulerAngles);
+}
+
+EulerAnglesF EulerConversion::ToEulerAngles(RotationMatrixF rM, EulerOrder order) {
+	return DispatchToEulerAngles(rM, order);
+}
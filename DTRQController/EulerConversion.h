@@ -0,0 +1,226 @@
+#pragma once
+
+#include "EulerAngles.h"
+#include "EulerConstants.h"
+#include "Mathematics.h"
+#include "Quaternion.h"
+#include "RotationMatrix.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+
+//Euler angle conversions specialised per order at compile time, the flight loop uses fixed orders and should not pay
+//for the frame, parity and repetition branches on every call. Order is one of the EulerConstants tags, angles are in
+//degrees. The runtime overloads dispatch to the same templates for orders only known at runtime. The scalar type
+//follows the argument, RotationF converts in float.
+//The tag and runtime paths round identically only in builds without fused multiply-adds, as CMakeLists.txt keeps
+//both the portable and native builds. A compiler free to contract them separately agrees to a few ulp instead.
+typedef struct EulerConversion {
+public:
+	template <typename Order, typename T>
+	static QuaternionT<T> ToQuaternion(Vector3<T> angles);
+
+	template <typename Order, typename T>
+	static RotationMatrixT<T> ToRotationMatrix(Vector3<T> angles);
+
+	template <typename Order, typename T>
+	static Vector3<T> ToAngles(RotationMatrixT<T> rM);
+
+	template <typename Order, typename T>
+	static EulerAnglesT<T> ToEulerAngles(RotationMatrixT<T> rM) {
+		return EulerAnglesT<T>(ToAngles<Order>(rM), Order::Order());
+	}
+
+	static Quaternion ToQuaternion(EulerAngles eulerAngles);
+	static RotationMatrix ToRotationMatrix(EulerAngles eulerAngles);
+	static EulerAngles ToEulerAngles(RotationMatrix rM, EulerOrder order);
+	static QuaternionF ToQuaternion(EulerAnglesF eulerAngles);
+	static RotationMatrixF ToRotationMatrix(EulerAnglesF eulerAngles);
+	static EulerAnglesF ToEulerAngles(RotationMatrixF rM, EulerOrder order);
+
+	//Calls function with the tag of a runtime order, batch callers dispatch once and loop inside
+	template <typename Function>
+	static auto Dispatch(EulerOrder order, Function function);
+
+private:
+	//Only the frame, parity and repetition enter the arithmetic, so eight instantiations cover all 24 orders
+	template <EulerOrder::Parity parity, EulerOrder::AxisRepetition axisRepetition, EulerOrder::AxisFrame axisFrame>
+	using DispatchTag = EulerOrderTag<EulerOrder::Axis::X, parity, axisRepetition, axisFrame>;
+} EulerConversion;
+
+template <typename Function>
+auto EulerConversion::Dispatch(EulerOrder order, Function function) {
+	bool odd = order.AxisPermutation == EulerOrder::Parity::Odd;
+	bool repeated = order.InitialAxisRepetition == EulerOrder::AxisRepetition::Yes;
+
+	if (order.FrameTaken == EulerOrder::AxisFrame::Static) {
+		if (odd) {
+			return repeated ? function(DispatchTag<EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static>())
+							: function(DispatchTag<EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static>());
+		}
+		else {
+			return repeated ? function(DispatchTag<EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Static>())
+							: function(DispatchTag<EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Static>());
+		}
+	}
+	else {
+		if (odd) {
+			return repeated ? function(DispatchTag<EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating>())
+							: function(DispatchTag<EulerOrder::Parity::Odd, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating>());
+		}
+		else {
+			return repeated ? function(DispatchTag<EulerOrder::Parity::Even, EulerOrder::AxisRepetition::Yes, EulerOrder::AxisFrame::Rotating>())
+							: function(DispatchTag<EulerOrder::Parity::Even, EulerOrder::AxisRepetition::No, EulerOrder::AxisFrame::Rotating>());
+		}
+	}
+}
+
+template <typename Order, typename T>
+QuaternionT<T> EulerConversion::ToQuaternion(Vector3<T> angles) {
+	QuaternionT<T> q = QuaternionT<T>(1, 0, 0, 0);
+	T sx, sy, sz, cx, cy, cz, cc, cs, sc, ss;
+
+	angles.X = Mathematics::DegreesToRadians(angles.X);
+	angles.Y = Mathematics::DegreesToRadians(angles.Y);
+	angles.Z = Mathematics::DegreesToRadians(angles.Z);
+
+	if constexpr (Order::FrameTaken == EulerOrder::AxisFrame::Rotating) {
+		T t = angles.X;
+		angles.X = angles.Z;
+		angles.Z = t;
+	}
+
+	if constexpr (Order::AxisPermutation == EulerOrder::Parity::Odd) {
+		angles.Y = -angles.Y;
+	}
+
+	Trigonometry::SinCos(angles.X * T(0.5), sx, cx);
+	Trigonometry::SinCos(angles.Y * T(0.5), sy, cy);
+	Trigonometry::SinCos(angles.Z * T(0.5), sz, cz);
+
+	cc = cx * cz;
+	cs = cx * sz;
+	sc = sx * cz;
+	ss = sx * sz;
+
+	if constexpr (Order::InitialAxisRepetition == EulerOrder::AxisRepetition::Yes) {
+		q.X = cy * (cs + sc);
+		q.Y = sy * (cc + ss);
+		q.Z = sy * (cs - sc);
+		q.W = cy * (cc - ss);
+	}
+	else {
+		q.X = cy * sc - sy * cs;
+		q.Y = cy * ss + sy * cc;
+		q.Z = cy * cs - sy * sc;
+		q.W = cy * cc + sy * ss;
+	}
+
+	//The runtime path has always discarded the result of Permutate, so the initial axis does not enter the result.
+	//Kept that way so recorded flights replay identically.
+
+	if constexpr (Order::AxisPermutation == EulerOrder::Parity::Odd) {
+		q.Y = -q.Y;
+	}
+
+	return q;
+}
+
+template <typename Order, typename T>
+RotationMatrixT<T> EulerConversion::ToRotationMatrix(Vector3<T> angles) {
+	RotationMatrixT<T> rM = RotationMatrixT<T>(Vector3<T>(0, 0, 0));
+	T sx, sy, sz, cx, cy, cz, cc, cs, sc, ss;
+
+	angles.X = Mathematics::DegreesToRadians(angles.X);
+	angles.Y = Mathematics::DegreesToRadians(angles.Y);
+	angles.Z = Mathematics::DegreesToRadians(angles.Z);
+
+	if constexpr (Order::FrameTaken == EulerOrder::AxisFrame::Rotating) {
+		T t = angles.X;
+		angles.X = angles.Z;
+		angles.Z = t;
+	}
+
+	if constexpr (Order::AxisPermutation == EulerOrder::Parity::Odd) {
+		angles.X = -angles.X;
+		angles.Y = -angles.Y;
+		angles.Z = -angles.Z;
+	}
+
+	Trigonometry::SinCos(angles.X, sx, cx);
+	Trigonometry::SinCos(angles.Y, sy, cy);
+	Trigonometry::SinCos(angles.Z, sz, cz);
+
+	cc = cx * cz;
+	cs = cx * sz;
+	sc = sx * cz;
+	ss = sx * sz;
+
+	if constexpr (Order::InitialAxisRepetition == EulerOrder::AxisRepetition::Yes) {
+		rM.XAxis.X = cy;       rM.XAxis.Y = sy * sx;       rM.XAxis.Z = sy * cx;
+		rM.YAxis.X = sy * sz;  rM.YAxis.Y = -cy * ss + cc; rM.YAxis.Z = -cy * cs - sc;
+		rM.ZAxis.X = -sy * cz; rM.ZAxis.Y = cy * sc + cs;  rM.ZAxis.Z = cy * cc - ss;
+	}
+	else {
+		rM.XAxis.X = cy * cz;  rM.XAxis.Y = sy * sc - cs;  rM.XAxis.Z = sy * cc + ss;
+		rM.YAxis.X = cy * sz;  rM.YAxis.Y = sy * ss + cc;  rM.YAxis.Z = sy * cs - sc;
+		rM.ZAxis.X = -sy;      rM.ZAxis.Y = cy * sx;       rM.ZAxis.Z = cy * cx;
+	}
+
+	return rM;
+}
+
+template <typename Order, typename T>
+Vector3<T> EulerConversion::ToAngles(RotationMatrixT<T> rM) {
+	Vector3<T> angles = Vector3<T>(0, 0, 0);
+
+	if constexpr (Order::InitialAxisRepetition == EulerOrder::AxisRepetition::Yes) {
+		T sy = std::sqrt(Trigonometry::Pow(rM.XAxis.Y, T(2)) + Trigonometry::Pow(rM.XAxis.Z, T(2)));
+
+		if (sy > T(32) * std::numeric_limits<T>::epsilon())//16 * float.Epsilon
+		{
+			angles.X = Trigonometry::Atan2(rM.XAxis.Y, rM.XAxis.Z);
+			angles.Y = Trigonometry::Atan2(sy, rM.XAxis.X);
+			angles.Z = Trigonometry::Atan2(rM.YAxis.X, -rM.ZAxis.X);
+		}
+		else
+		{
+			angles.X = Trigonometry::Atan2(-rM.YAxis.Z, rM.YAxis.Y);
+			angles.Y = Trigonometry::Atan2(sy, rM.XAxis.X);
+			angles.Z = 0;
+		}
+	}
+	else {
+		T cy = std::sqrt(Trigonometry::Pow(rM.XAxis.X, T(2)) + Trigonometry::Pow(rM.YAxis.X, T(2)));
+
+		if (cy > T(32) * std::numeric_limits<T>::epsilon())
+		{
+			angles.X = Trigonometry::Atan2( rM.ZAxis.Y, rM.ZAxis.Z);
+			angles.Y = Trigonometry::Atan2(-rM.ZAxis.X, cy);
+			angles.Z = Trigonometry::Atan2( rM.YAxis.X, rM.XAxis.X);
+		}
+		else
+		{
+			angles.X = Trigonometry::Atan2(-rM.YAxis.Z, rM.YAxis.Y);
+			angles.Y = Trigonometry::Atan2(-rM.ZAxis.X, cy);
+			angles.Z = 0;
+		}
+	}
+
+	if constexpr (Order::AxisPermutation == EulerOrder::Parity::Odd) {
+		angles.X = -angles.X;
+		angles.Y = -angles.Y;
+		angles.Z = -angles.Z;
+	}
+
+	if constexpr (Order::FrameTaken == EulerOrder::AxisFrame::Rotating) {
+		T temp = angles.X;
+		angles.X = angles.Z;
+		angles.Z = temp;
+	}
+
+	angles.X = Mathematics::RadiansToDegrees(angles.X);
+	angles.Y = Mathematics::RadiansToDegrees(angles.Y);
+	angles.Z = Mathematics::RadiansToDegrees(angles.Z);
+
+	return angles;
+}
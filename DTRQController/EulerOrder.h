@@ -38,4 +38,26 @@ public:
 	EulerOrder();
 	EulerOrder(Axis axis, Parity parity, AxisRepetition axisRepetition, AxisFrame axisFrame, Vector3D permutation);
 	std::string ToString();
-} EulerOrder;
\ No newline at end of file
+} EulerOrder;
+
+//Compile time form of an EulerOrder, the conversions in EulerConversion are generated per tag without branching on
+//the order
+template <EulerOrder::Axis axis, EulerOrder::Parity parity, EulerOrder::AxisRepetition axisRepetition, EulerOrder::AxisFrame axisFrame>
+struct EulerOrderTag {
+	static constexpr EulerOrder::Axis InitialAxis = axis;
+	static constexpr EulerOrder::Parity AxisPermutation = parity;
+	static constexpr EulerOrder::AxisRepetition InitialAxisRepetition = axisRepetition;
+	static constexpr EulerOrder::AxisFrame FrameTaken = axisFrame;
+
+	//Runtime equivalent, the permutation follows from the initial axis and parity as in EulerConstants
+	static EulerOrder Order() {
+		const int permutations[3][2][3] = {
+			{ { 0, 1, 2 }, { 0, 2, 1 } },
+			{ { 1, 2, 0 }, { 1, 0, 2 } },
+			{ { 2, 0, 1 }, { 2, 1, 0 } }
+		};
+		const int *p = permutations[axis][parity];
+
+		return EulerOrder(axis, parity, axisRepetition, axisFrame, Vector3D(p[0], p[1], p[2]));
+	}
+};
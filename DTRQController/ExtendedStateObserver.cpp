@@ -41,6 +41,14 @@ ExtendedStateObserver::State ExtendedStateObserver::ObserveState(double sampling
 	return state;
 }
 
+ExtendedStateObserver::State ExtendedStateObserver::GetState() {
+	return state;
+}
+
+void ExtendedStateObserver::SetState(State state) {
+	this->state = state;
+}
+
 double ExtendedStateObserver::NonlinearFunction(double eta, double alpha, double delta) {
 	if (std::abs(eta) <= delta)
 	{
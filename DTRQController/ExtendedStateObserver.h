@@ -25,6 +25,8 @@ public:
 	ExtendedStateObserver();
 	ExtendedStateObserver(bool linear);
 	State ObserveState(double samplingPeriod, double u, double b0, double processVariable);
+	State GetState();
+	void SetState(State state);
 
 
 private:
@@ -0,0 +1,152 @@
+#include "FFTPlan.h"
+#include "Mathematics.h"
+
+FFTPlan::FFTPlan() {
+	this->length = 0;
+	this->stages = 0;
+}
+
+FFTPlan::FFTPlan(int length) {
+	this->length = 0;
+	this->stages = 0;
+
+	if (!IsPowerOfTwo(length)) {
+		std::cout << "FFT length " << length << " is not a power of two." << std::endl;
+		return;
+	}
+
+	this->length = length;
+
+	while ((1 << stages) < length) stages++;
+
+	for (int i = 0; i < length; i++) {
+		int reversed = 0;
+
+		for (int bit = 0; bit < stages; bit++) {
+			reversed |= ((i >> bit) & 1) << (stages - 1 - bit);
+		}
+
+		if (i < reversed) {
+			swaps.push_back(i);
+			swaps.push_back(reversed);
+		}
+	}
+
+	twiddles.resize(length);
+
+	for (int k = 0; k < length / 2; k++) {
+		double angle = 2.0 * Mathematics::PI * k / length;
+
+		twiddles[k * 2] = cos(angle);
+		twiddles[k * 2 + 1] = -sin(angle);
+	}
+}
+
+bool FFTPlan::IsPowerOfTwo(int length) {
+	return length > 0 && (length & (length - 1)) == 0;
+}
+
+bool FFTPlan::Forward(std::complex<double> *data) {
+	if (length == 0) return false;
+
+	Perform(reinterpret_cast<double *>(data), false);
+
+	return true;
+}
+
+bool FFTPlan::Inverse(std::complex<double> *data, bool scale) {
+	if (length == 0) return false;
+
+	double *values = reinterpret_cast<double *>(data);
+
+	Perform(values, true);
+
+	//scales outputs of transform due to change in size during forward pass
+	if (scale) {
+		const double factor = 1.0 / (double)length;
+
+		for (int i = 0; i < length * 2; i++) {
+			values[i] *= factor;
+		}
+	}
+
+	return true;
+}
+
+int FFTPlan::GetLength() {
+	return length;
+}
+
+bool FFTPlan::IsValid() {
+	return length > 0;
+}
+
+//Decimation in time on interleaved real and imaginary parts. The products are written out, std::complex multiplies
+//go through the library's NaN and infinity recovery
+void FFTPlan::Perform(double *data, bool inverse) {
+	double sign = inverse ? -1.0 : 1.0;//conjugates the twiddles
+	int span = 1;
+
+	for (int i = 0; i < (int)swaps.size(); i += 2) {
+		int a = swaps[i] * 2, b = swaps[i + 1] * 2;
+		double real = data[a], imag = data[a + 1];
+
+		data[a] = data[b];
+		data[a + 1] = data[b + 1];
+		data[b] = real;
+		data[b + 1] = imag;
+	}
+
+	//An odd number of stages starts with a single radix-2 pass, its twiddles are all one
+	if (stages % 2 == 1) {
+		for (int i = 0; i < length * 2; i += 4) {
+			double real = data[i], imag = data[i + 1];
+
+			data[i] = real + data[i + 2];
+			data[i + 1] = imag + data[i + 3];
+			data[i + 2] = real - data[i + 2];
+			data[i + 3] = imag - data[i + 3];
+		}
+
+		span = 2;
+	}
+
+	//Butterflies of span and of twice span at once. The first uses w1 = W(2 span)^j on both halves, the second w2 =
+	//W(4 span)^j and, for the odd quarter, w2 * W(4 span)^span which is w2 times -i, or i for the inverse
+	for (; span < length; span *= 4) {
+		int first = length / (2 * span);
+		int second = length / (4 * span);
+
+		for (int start = 0; start < length; start += 4 * span) {
+			for (int j = 0; j < span; j++) {
+				double w1r = twiddles[j * first * 2], w1i = sign * twiddles[j * first * 2 + 1];
+				double w2r = twiddles[j * second * 2], w2i = sign * twiddles[j * second * 2 + 1];
+				double *x0 = data + (start + j) * 2;
+				double *x1 = x0 + span * 2;
+				double *x2 = x1 + span * 2;
+				double *x3 = x2 + span * 2;
+
+				double t1r = w1r * x1[0] - w1i * x1[1], t1i = w1r * x1[1] + w1i * x1[0];
+				double t3r = w1r * x3[0] - w1i * x3[1], t3i = w1r * x3[1] + w1i * x3[0];
+
+				double a0r = x0[0] + t1r, a0i = x0[1] + t1i;
+				double a1r = x0[0] - t1r, a1i = x0[1] - t1i;
+				double a2r = x2[0] + t3r, a2i = x2[1] + t3i;
+				double a3r = x2[0] - t3r, a3i = x2[1] - t3i;
+
+				double u2r = w2r * a2r - w2i * a2i, u2i = w2r * a2i + w2i * a2r;
+				double v3r = w2r * a3r - w2i * a3i, v3i = w2r * a3i + w2i * a3r;
+				double u3r = sign * v3i, u3i = -sign * v3r;
+
+				x0[0] = a0r + u2r;
+				x0[1] = a0i + u2i;
+				x2[0] = a0r - u2r;
+				x2[1] = a0i - u2i;
+				x1[0] = a1r + u3r;
+				x1[1] = a1i + u3i;
+				x3[0] = a1r - u3r;
+				x3[1] = a1i - u3i;
+			}
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <complex>
+#include <iostream>
+#include <vector>
+
+//Bit reversal and twiddle tables for one power of two length, built once and reused by every transform. Transforms
+//run iteratively in place, two radix-2 stages fused into each radix-4 pass, and allocate nothing
+class FFTPlan {
+private:
+	int length;
+	int stages;//log2 of the length
+	std::vector<int> swaps;//index pairs exchanged by the bit reversal
+	std::vector<double> twiddles;//cos and -sin of 2 pi k / length for k below length / 2, interleaved
+
+	void Perform(double *data, bool inverse);
+
+public:
+	FFTPlan();
+	FFTPlan(int length);
+
+	static bool IsPowerOfTwo(int length);
+
+	bool Forward(std::complex<double> *data);
+	bool Inverse(std::complex<double> *data, bool scale);
+
+	int GetLength();
+	bool IsValid();
+
+};
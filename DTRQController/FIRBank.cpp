@@ -0,0 +1,105 @@
+#include "FIRBank.h"
+
+template <typename T>
+FIRBankT<T>::FIRBankT() {
+	this->channels = 0;
+	this->numberTaps = 0;
+
+	Setup(nullptr);
+}
+
+template <typename T>
+FIRBankT<T>::FIRBankT(FiniteImpulseResponse::Type type, int numberTaps, double fs, double fx, double fxb, int channels) {
+	FiniteImpulseResponse design = FiniteImpulseResponse(type, numberTaps, fs, fx, fxb);
+	std::vector<T> designed(design.GetTaps().begin(), design.GetTaps().end());
+
+	this->channels = channels > 0 ? channels : 0;
+	this->numberTaps = (int)designed.size();//the design limits its taps
+
+	Setup(designed.data());
+}
+
+template <typename T>
+FIRBankT<T>::FIRBankT(const T *taps, int numberTaps, int channels) {
+	this->channels = channels > 0 ? channels : 0;
+	this->numberTaps = numberTaps > 0 ? numberTaps : 0;
+
+	Setup(taps);
+}
+
+template <typename T>
+void FIRBankT<T>::Filter(const T *input, T *output) {
+	if (numberTaps == 0) {
+		for (int c = 0; c < channels; c++) output[c] = 0.0;
+
+		return;
+	}
+
+	//As FiniteImpulseResponse::Filter, the first sample never enters the delay line
+	bool first = !primed;
+
+	primed = true;
+	head = head == 0 ? numberTaps - 1 : head - 1;
+
+	for (int g = 0; g < groups; g++) {
+		T *line = &delay[g * numberTaps * 16];
+		T *row = line + head * 8;
+		T *mirror = line + (head + numberTaps) * 8;
+		T lanes[8];
+		int width = channels - g * 8 < 8 ? channels - g * 8 : 8;
+
+		for (int j = 0; j < width; j++) {
+			row[j] = mirror[j] = first ? T(0) : input[g * 8 + j];
+		}
+
+		if (folded) {
+			SIMD::FoldedDot(row, taps.data(), numberTaps, lanes);
+		}
+		else {
+			for (int j = 0; j < width; j++) {
+				lanes[j] = 0.0;
+
+				for (int i = 0; i < numberTaps; i++) {
+					lanes[j] += row[i * 8 + j] * taps[i];
+				}
+			}
+		}
+
+		std::copy(lanes, lanes + width, output + g * 8);
+	}
+}
+
+template <typename T>
+int FIRBankT<T>::GetChannels() {
+	return channels;
+}
+
+template <typename T>
+int FIRBankT<T>::GetNumberTaps() {
+	return numberTaps;
+}
+
+template <typename T>
+bool FIRBankT<T>::IsFolded() {
+	return folded;
+}
+
+template <typename T>
+void FIRBankT<T>::Setup(const T *taps) {
+	groups = (channels + 7) / 8;
+	head = 0;
+	primed = false;
+	folded = numberTaps > 0;
+
+	for (int i = 0; i < numberTaps / 2; i++) {
+		if (taps[i] != taps[numberTaps - 1 - i]) folded = false;
+	}
+
+	this->taps.assign(taps, taps + (folded ? (numberTaps + 1) / 2 : numberTaps));
+
+	delay.assign(groups * numberTaps * 16, 0.0);
+}
+
+//Double for the simulation and offline tools, float for the flight build
+template class FIRBankT<double>;
+template class FIRBankT<float>;
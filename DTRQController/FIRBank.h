@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include "FiniteImpulseResponse.h"
+#include "SIMD.h"
+
+//Any number of channels through one set of taps, such as X, Y, Z of the front and back accelerometers. Channels are
+//grouped in eights, each group has a mirrored delay line as FiniteImpulseResponse with a row of eight per sample, so
+//one vector multiply-add per tap filters four or eight channels. Windowed sinc taps are symmetric, the two samples
+//sharing a tap are added first and multiplied once, which rounds differently from FiniteImpulseResponse::Filter.
+//Taps that are not symmetric are applied one at a time and give FiniteImpulseResponse::Filter's result exactly.
+//The scalar type is as in Vector3, FIRBankF rounds the designed taps to float and fills a float row in one vector.
+template <typename T>
+class FIRBankT {
+private:
+	int channels;
+	int groups;
+	int numberTaps;
+	bool folded;
+	std::vector<T> taps;//first (numberTaps + 1) / 2 when folded
+	std::vector<T> delay;//groups delay lines of 2 * numberTaps rows of eight
+	int head;
+	bool primed;
+
+	void Setup(const T *taps);
+
+public:
+	FIRBankT();
+	FIRBankT(FiniteImpulseResponse::Type type, int numberTaps, double fs, double fx, double fxb, int channels);
+	FIRBankT(const T *taps, int numberTaps, int channels);
+
+	//Reads one sample per channel from input and writes one per channel to output, both may be the same array
+	void Filter(const T *input, T *output);
+
+	int GetChannels();
+	int GetNumberTaps();
+	bool IsFolded();
+
+};
+
+typedef FIRBankT<double> FIRBank;
+typedef FIRBankT<float> FIRBankF;
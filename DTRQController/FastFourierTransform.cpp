@@ -1,63 +1,29 @@
 #include "FastFourierTransform.h"
 
 //Cooley-Tukey method
-void FastFourierTransform::FFT(std::complex<double> *real, int length) {
-	Perform(real, length, false);
+bool FastFourierTransform::FFT(std::complex<double> *real, int length) {
+	return Perform(real, length, false);
 }
 
-void FastFourierTransform::IFFT(std::complex<double> *imag, int length, bool scale) {
-	Perform(imag, length, true);
+bool FastFourierTransform::IFFT(std::complex<double> *imag, int length, bool scale) {
+	if (!Perform(imag, length, true)) return false;
 
 	//scales outputs of transform due to change in size during forward pass
 	if (scale) {
 		Scale(imag, length);
 	}
-}
-
-void FastFourierTransform::Perform(std::complex<double> *data, int length, bool inverse) {
-	double flip = 1.0;//forward Fourier transform
-
-	//inverse Fourier transform
-	if (inverse) {
-		flip = -1.0;
-	}
-
-	if (length >= 2) {
-		Rearrange(data, length);//rearranges data
-		Perform(data, length / 2, inverse);//recursion on even data
-		Perform(data + length / 2, length / 2, inverse);//recursion on odd data
-
-		//Joint two bottom recursions
-		for (int k = 0; k < length / 2; k++) {
-			std::complex<double> even = data[k];
-			std::complex<double> odd = data[k + length / 2];
-			std::complex<double> twiddle = exp(std::complex<double>(0, -2.0 * Mathematics::PI * flip * k / length));
 
-			data[k] = even + twiddle * odd;
-			data[k + length / 2] = even - twiddle * odd;
-		}
-	}
-
-	//else the recursion ends, x at zero is x at zero
+	return true;
 }
 
-void FastFourierTransform::Rearrange(std::complex<double> *a, int length) {
-	std::complex<double>* b = new std::complex<double>[length / 2];
+bool FastFourierTransform::Perform(std::complex<double> *data, int length, bool inverse) {
+	static thread_local FFTPlan plan;
 
-	//Splits odd an even elements into the lower and upper halves of the output data, respectively
-	for (int i = 0; i < length / 2; i++) {
-		b[i] = a[i * 2 + 1];
+	if (plan.GetLength() != length) {
+		plan = FFTPlan(length);
 	}
 
-	for (int i = 0; i < length / 2; i++) {
-		a[i] = a[i * 2];
-	}
-
-	for (int i = 0; i < length / 2; i++) {
-		a[i + length / 2] = b[i];
-	}    
-
-	delete[] b;
+	return inverse ? plan.Inverse(data, false) : plan.Forward(data);
 }
 
 void FastFourierTransform::Scale(std::complex<double> *imag, int length) {
@@ -3,15 +3,17 @@
 #include <complex>
 #include <iostream>
 #include <valarray>
+#include "FFTPlan.h"
 #include "Mathematics.h"
 #include <vector>
 
+//Convenience wrappers over FFTPlan, the last plan is kept per thread so repeated transforms of one length build it
+//once. Lengths that are not a power of two are rejected and the data is left untouched.
 class FastFourierTransform {
 public:
-	static void FFT(std::complex<double> *real, int length);
-	static void IFFT(std::complex<double> *imag, int length, bool scale);
-	static void Perform(std::complex<double> *data, int length, bool inverse);
-	static void Rearrange(std::complex<double> *data, int length);
+	static bool FFT(std::complex<double> *real, int length);
+	static bool IFFT(std::complex<double> *imag, int length, bool scale);
+	static bool Perform(std::complex<double> *data, int length, bool inverse);
 	static void Scale(std::complex<double> *imag, int length);
 	
 	static double* GetRealValues(std::complex<double>* complex, int length);
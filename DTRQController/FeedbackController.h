@@ -6,4 +6,12 @@ public:
 	virtual ~FeedbackController() {};
 	FeedbackController(const FeedbackController& feedbackController) { *this = feedbackController; }
 	virtual double Calculate(double setpoint, double processVariable, double dT) = 0;
+
+	//Deep copy including the internal state
+	virtual FeedbackController* Clone() const = 0;
+
+	//Internal state as a flat array of GetStateSize() values for snapshots
+	virtual int GetStateSize() = 0;
+	virtual void SaveState(double *state) = 0;
+	virtual void LoadState(const double *state) = 0;
 };
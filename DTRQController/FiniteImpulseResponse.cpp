@@ -11,6 +11,7 @@ FiniteImpulseResponse::FiniteImpulseResponse() {
 	this->phi = Mathematics::PI * fxb / (fs / 2.0);
 
 	SetupHighPassTaps();
+	SetupDelayLine();
 }
 
 FiniteImpulseResponse::FiniteImpulseResponse(Type filter, int numberTaps, double fs, double fx, double fxb) {
@@ -21,7 +22,7 @@ FiniteImpulseResponse::FiniteImpulseResponse(Type filter, int numberTaps, double
 
 	if (numberTaps > 1000) {
 		std::cout << "FIR taps limited to 1000." << std::endl;
-		numberTaps = 1000;
+		this->numberTaps = 1000;
 	}
 
 	this->lambda = Mathematics::PI * fx / (fs / 2.0);
@@ -36,21 +37,136 @@ FiniteImpulseResponse::FiniteImpulseResponse(Type filter, int numberTaps, double
 	else {
 		SetupBandPassTaps();
 	}
+
+	SetupDelayLine();
 }
 
 double FiniteImpulseResponse::Filter(double sample) {
 	double output = 0.0;
 
-	sr.insert(sr.begin(), sample);
-	sr.pop_back();
+	if (numberTaps <= 0) return output;
+
+	//The shift register this replaced dropped the first sample, kept so recorded flights replay identically
+	if (!primed) {
+		sample = 0.0;
+		primed = true;
+	}
+
+	Push(sample);
+
+	//Summed newest first, the order recorded flights were filtered in
+	output = SIMD::OrderedDot(&delay[head], taps.data(), numberTaps);
+
+	return output;
+}
+
+void FiniteImpulseResponse::FilterBlock(const double *input, double *output, int count) {
+	if (numberTaps < BlockCrossover) {
+		for (int i = 0; i < count; i++) {
+			output[i] = Filter(input[i]);
+		}
+
+		return;
+	}
+
+	if (fftLength == 0) SetupBlock();
+
+	//Each block holds the numberTaps - 1 samples before it then up to hop new ones, the outputs past the history are
+	//free of circular wrap. A short last block is zero padded, every input gets its output within the call
+	int history = numberTaps - 1;
+	int hop = fftLength - history;
+
+	for (int i = 0; i < count; i += hop) {
+		int samples = count - i < hop ? count - i : hop;
+
+		for (int k = 0; k < history; k++) {
+			block[history - 1 - k] = delay[head + k];
+		}
+
+		for (int k = 0; k < samples; k++) {
+			block[history + k] = input[i + k];
+		}
+
+		for (int k = history + samples; k < fftLength; k++) {
+			block[k] = 0.0;
+		}
+
+		//As Filter, the first sample never enters the delay line
+		if (!primed) {
+			block[history] = 0.0;
+			primed = true;
+		}
+
+		//The newest samples carry over to Filter and the next block
+		for (int k = samples > numberTaps ? samples - numberTaps : 0; k < samples; k++) {
+			Push(block[history + k]);
+		}
+
+		plan.Forward(block.data(), spectrum.data());
+
+		for (int k = 0; k < plan.GetBins(); k++) {
+			double a = spectrum[k].real(), b = spectrum[k].imag();
+			double c = response[k].real(), d = response[k].imag();
+
+			spectrum[k] = std::complex<double>(a * c - b * d, a * d + b * c);
+		}
+
+		plan.Inverse(spectrum.data(), block.data());
+
+		for (int k = 0; k < samples; k++) {
+			output[i + k] = block[history + k];
+		}
+	}
+}
+
+int FiniteImpulseResponse::GetNumberTaps() {
+	return numberTaps;
+}
+
+const std::vector<double>& FiniteImpulseResponse::GetTaps() {
+	return taps;
+}
 
-	sr.resize(numberTaps);
+void FiniteImpulseResponse::Push(double sample) {
+	head = head == 0 ? numberTaps - 1 : head - 1;
+
+	delay[head] = sample;
+	delay[head + numberTaps] = sample;
+}
+
+void FiniteImpulseResponse::SetupDelayLine() {
+	delay.assign(numberTaps > 0 ? 2 * numberTaps : 0, 0.0);
+	head = 0;
+	primed = false;
+	fftLength = 0;
+}
+
+//Power of two length with the least transform work per output, each block costs about n log n and yields
+//n - numberTaps + 1 outputs
+void FiniteImpulseResponse::SetupBlock() {
+	double best = 0.0;
+
+	for (int n = 2; n <= 64 * numberTaps; n *= 2) {
+		if (n < 2 * numberTaps) continue;
+
+		double cost = n * log2((double)n) / (n - numberTaps + 1);
+
+		if (fftLength == 0 || cost < best) {
+			fftLength = n;
+			best = cost;
+		}
+	}
+
+	plan = RealFFTPlan(fftLength);
+	response.assign(plan.GetBins(), 0.0);
+	spectrum.assign(plan.GetBins(), 0.0);
+	block.assign(fftLength, 0.0);
 
 	for (int i = 0; i < numberTaps; i++) {
-		output += (double)sr.at(i) * (double)taps.at(i);
+		block[i] = taps[i];
 	}
 
-	return output;
+	plan.Forward(block.data(), response.data());
 }
 
 void FiniteImpulseResponse::SetupLowPassTaps() {
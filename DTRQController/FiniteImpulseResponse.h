@@ -1,6 +1,8 @@
 #pragma once
 
+#include "RealFFTPlan.h"
 #include "Mathematics.h"
+#include "SIMD.h"
 
 class FiniteImpulseResponse {
 public:
@@ -15,6 +17,17 @@ public:
 
 	double Filter(double sample);
 
+	//Filters count samples as count calls to Filter would, the two can be mixed on one filter. From BlockCrossover
+	//taps on the samples go through overlap-save FFT convolution, which agrees with Filter to rounding, not bit for bit
+	void FilterBlock(const double *input, double *output, int count);
+
+	int GetNumberTaps();
+	const std::vector<double>& GetTaps();
+
+	//Taps from which FilterBlock convolves through the FFT, where a long log filtered one sample at a time and through
+	//RealFFTPlan blocks measured the same time per sample
+	static const int BlockCrossover = 24;
+
 private:
 	int numberTaps;
 	double fs;//sampling frequency
@@ -23,10 +36,25 @@ private:
 	double lambda;
 	double phi;
 	std::vector<double> taps;
-	std::vector<double> sr;
 
+	//Mirrored delay line of twice the taps, every sample is written at head and head + numberTaps so the newest
+	//numberTaps samples always sit contiguously from head, newest first
+	std::vector<double> delay;
+	int head;
+	bool primed;
+
+	//Overlap-save state, sized on the first FFT block
+	int fftLength;
+	RealFFTPlan plan;
+	std::vector<std::complex<double>> response;//one sided transform of the zero padded taps
+	std::vector<std::complex<double>> spectrum;
+	std::vector<double> block;
+
+	void Push(double sample);
 	void SetupLowPassTaps();
 	void SetupHighPassTaps();
 	void SetupBandPassTaps();
+	void SetupDelayLine();
+	void SetupBlock();
 
 };
@@ -0,0 +1,87 @@
+#include "FixedPoint.h"
+
+static const double Q14Scale = 1.0 / (double)((int32_t)1 << FixedPoint::Q14);
+static const double Q30Scale = 1.0 / (double)((int32_t)1 << FixedPoint::Q30);
+
+uint32_t FixedPoint::SquareRoot(uint64_t value) {
+	uint64_t result = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+
+	while (bit > value) bit >>= 2;
+
+	while (bit != 0) {
+		if (value >= result + bit) {
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else {
+			result >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return (uint32_t)result;
+}
+
+std::string Vector3Q14::ToString() const {
+	return ToVector3D().ToString();
+}
+
+Vector3Q14 Vector3Q14::FromVector3D(Vector3D vector) {
+	return Vector3Q14((int32_t)llround(vector.X / Q14Scale), (int32_t)llround(vector.Y / Q14Scale), (int32_t)llround(vector.Z / Q14Scale));
+}
+
+void Vector3Q14::ToVector3D(const Vector3Q14 *vectors, Vector3D *result, int count) {
+	for (int i = 0; i < count; i++) {
+		result[i] = vectors[i].ToVector3D();
+	}
+}
+
+void QuaternionQ30::RotationMatrix(int32_t *matrix) const {
+	int64_t w = W, x = X, y = Y, z = Z;
+	int32_t one = (int32_t)1 << FixedPoint::Q30;
+
+	//Twice a Q60 product is a shift by 29 back to Q30
+	matrix[0] = one - FixedPoint::Round(y * y + z * z, FixedPoint::Q30 - 1);
+	matrix[1] = FixedPoint::Round(x * y - w * z, FixedPoint::Q30 - 1);
+	matrix[2] = FixedPoint::Round(x * z + w * y, FixedPoint::Q30 - 1);
+	matrix[3] = FixedPoint::Round(x * y + w * z, FixedPoint::Q30 - 1);
+	matrix[4] = one - FixedPoint::Round(x * x + z * z, FixedPoint::Q30 - 1);
+	matrix[5] = FixedPoint::Round(y * z - w * x, FixedPoint::Q30 - 1);
+	matrix[6] = FixedPoint::Round(x * z - w * y, FixedPoint::Q30 - 1);
+	matrix[7] = FixedPoint::Round(y * z + w * x, FixedPoint::Q30 - 1);
+	matrix[8] = one - FixedPoint::Round(x * x + y * y, FixedPoint::Q30 - 1);
+}
+
+//One matrix per quaternion, then three multiply accumulates per output lane
+void QuaternionQ30::RotateVectors(const Vector3Q14 *coordinates, Vector3Q14 *result, int count) const {
+	int32_t m[9];
+
+	RotationMatrix(m);
+
+	for (int i = 0; i < count; i++) {
+		int64_t x = coordinates[i].X, y = coordinates[i].Y, z = coordinates[i].Z;
+
+		result[i] = Vector3Q14(
+			FixedPoint::Round(m[0] * x + m[1] * y + m[2] * z, FixedPoint::Q30),
+			FixedPoint::Round(m[3] * x + m[4] * y + m[5] * z, FixedPoint::Q30),
+			FixedPoint::Round(m[6] * x + m[7] * y + m[8] * z, FixedPoint::Q30)
+		);
+	}
+}
+
+std::string QuaternionQ30::ToString() const {
+	return ToQuaternion().ToString();
+}
+
+QuaternionQ30 QuaternionQ30::FromQuaternion(Quaternion quaternion) {
+	return QuaternionQ30((int32_t)llround(quaternion.W / Q30Scale), (int32_t)llround(quaternion.X / Q30Scale),
+		(int32_t)llround(quaternion.Y / Q30Scale), (int32_t)llround(quaternion.Z / Q30Scale));
+}
+
+void QuaternionQ30::ToQuaternion(const QuaternionQ30 *quaternions, Quaternion *result, int count) {
+	for (int i = 0; i < count; i++) {
+		result[i] = quaternions[i].ToQuaternion();
+	}
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stdint.h>
+#include "Quaternion.h"
+#include "Vector.h"
+
+//Integer Q format math for the DMP samples. The DMP reports its quaternion as int32 words in Q30 (1.0 = 2^30) and
+//acceleration as int16 in Q14 at the 2g range (1g = 16384). The sensor fusion stays in these formats and only converts
+//to floating point at the controller boundary. Products widen to int64 and round to nearest when shifted back. The per
+//sample functions are inline, returning the packed structs through a call costs more than the arithmetic.
+class FixedPoint {
+public:
+	static const int Q14 = 14;
+	static const int Q30 = 30;
+
+	static int32_t Round(int64_t value, int shift) {
+		return (int32_t)((value + ((int64_t)1 << (shift - 1))) >> shift);
+	}
+
+	static uint32_t SquareRoot(uint64_t value);//floor of the root, bit by bit
+};
+
+typedef struct Vector3Q14 {
+public:
+	int32_t X;
+	int32_t Y;
+	int32_t Z;
+
+	constexpr Vector3Q14() noexcept : X(0), Y(0), Z(0) {}
+	constexpr Vector3Q14(int32_t x, int32_t y, int32_t z) noexcept : X(x), Y(y), Z(z) {}
+
+	constexpr Vector3Q14 operator +(const Vector3Q14& vector) const noexcept {
+		return Vector3Q14(X + vector.X, Y + vector.Y, Z + vector.Z);
+	}
+
+	constexpr Vector3Q14 operator -(const Vector3Q14& vector) const noexcept {
+		return Vector3Q14(X - vector.X, Y - vector.Y, Z - vector.Z);
+	}
+
+	constexpr bool operator ==(const Vector3Q14& vector) const noexcept {
+		return X == vector.X && Y == vector.Y && Z == vector.Z;
+	}
+
+	//In units of one, g for acceleration
+	Vector3D ToVector3D() const {
+		const double scale = 1.0 / (1 << FixedPoint::Q14);
+
+		return Vector3D(X * scale, Y * scale, Z * scale);
+	}
+
+	std::string ToString() const;
+
+	static Vector3Q14 FromVector3D(Vector3D vector);
+	static void ToVector3D(const Vector3Q14 *vectors, Vector3D *result, int count);
+} Vector3Q14;
+
+typedef struct QuaternionQ30 {
+public:
+	int32_t W;
+	int32_t X;
+	int32_t Y;
+	int32_t Z;
+
+	constexpr QuaternionQ30() noexcept : W((int32_t)1 << FixedPoint::Q30), X(0), Y(0), Z(0) {}
+	constexpr QuaternionQ30(int32_t w, int32_t x, int32_t y, int32_t z) noexcept : W(w), X(x), Y(y), Z(z) {}
+
+	constexpr QuaternionQ30 Conjugate() const noexcept {
+		return QuaternionQ30(W, -X, -Y, -Z);
+	}
+
+	constexpr bool operator ==(const QuaternionQ30& quaternion) const noexcept {
+		return W == quaternion.W && X == quaternion.X && Y == quaternion.Y && Z == quaternion.Z;
+	}
+
+	//Hamilton product
+	QuaternionQ30 Multiply(const QuaternionQ30& q) const {
+		int64_t w = (int64_t)W * q.W - (int64_t)X * q.X - (int64_t)Y * q.Y - (int64_t)Z * q.Z;
+		int64_t x = (int64_t)W * q.X + (int64_t)X * q.W + (int64_t)Y * q.Z - (int64_t)Z * q.Y;
+		int64_t y = (int64_t)W * q.Y - (int64_t)X * q.Z + (int64_t)Y * q.W + (int64_t)Z * q.X;
+		int64_t z = (int64_t)W * q.Z + (int64_t)X * q.Y - (int64_t)Y * q.X + (int64_t)Z * q.W;
+
+		return QuaternionQ30(FixedPoint::Round(w, FixedPoint::Q30), FixedPoint::Round(x, FixedPoint::Q30),
+			FixedPoint::Round(y, FixedPoint::Q30), FixedPoint::Round(z, FixedPoint::Q30));
+	}
+
+	//Identity for the zero quaternion
+	QuaternionQ30 UnitQuaternion() const {
+		//Squares in Q58 so four full range components cannot overflow
+		uint64_t normal = ((uint64_t)((int64_t)W * W) >> 2) + ((uint64_t)((int64_t)X * X) >> 2) +
+			((uint64_t)((int64_t)Y * Y) >> 2) + ((uint64_t)((int64_t)Z * Z) >> 2);
+		int64_t n = (int64_t)(normal >> (FixedPoint::Q30 - 2));//Q30
+		int64_t one = (int64_t)1 << FixedPoint::Q30;
+		int64_t scale;//1 / norm in Q30
+
+		if (n > one - (one >> 10) && n < one + (one >> 10)) {
+			//DMP samples sit within 1e-3 of unit, a linear start and one Newton step of 1 / sqrt(n), no divide
+			scale = 3 * (one >> 1) - (n >> 1);
+			scale = FixedPoint::Round(scale * (3 * one - FixedPoint::Round(n * FixedPoint::Round(scale * scale, FixedPoint::Q30), FixedPoint::Q30)), FixedPoint::Q30 + 1);
+		}
+		else {
+			uint32_t norm = FixedPoint::SquareRoot(normal);//Q29
+
+			if (norm == 0) return QuaternionQ30();
+
+			scale = (int64_t)(((uint64_t)1 << 59) / norm);
+		}
+
+		return QuaternionQ30(FixedPoint::Round(W * scale, FixedPoint::Q30), FixedPoint::Round(X * scale, FixedPoint::Q30),
+			FixedPoint::Round(Y * scale, FixedPoint::Q30), FixedPoint::Round(Z * scale, FixedPoint::Q30));
+	}
+
+	//The rotation functions assume a unit quaternion, normalise DMP samples once with UnitQuaternion first
+	void RotationMatrix(int32_t *matrix) const;//row major 3x3 in Q30
+	void RotateVectors(const Vector3Q14 *coordinates, Vector3Q14 *result, int count) const;
+
+	//v + 2w(u x v) + 2u x (u x v) as SIMD::RotateUnitVector, the cross product is kept in Q22 so one rounding dominates
+	Vector3Q14 RotateVector(const Vector3Q14& coordinate) const {
+		int64_t w = W, x = X, y = Y, z = Z;
+		int64_t vx = coordinate.X, vy = coordinate.Y, vz = coordinate.Z;
+		const int shift = FixedPoint::Q30 + FixedPoint::Q14 - 22 - 1;//Q44 to twice the product in Q22
+
+		int64_t tx = FixedPoint::Round(y * vz - z * vy, shift);
+		int64_t ty = FixedPoint::Round(z * vx - x * vz, shift);
+		int64_t tz = FixedPoint::Round(x * vy - y * vx, shift);
+
+		return Vector3Q14(
+			coordinate.X + FixedPoint::Round(w * tx + y * tz - z * ty, FixedPoint::Q30 + 22 - FixedPoint::Q14),
+			coordinate.Y + FixedPoint::Round(w * ty + z * tx - x * tz, FixedPoint::Q30 + 22 - FixedPoint::Q14),
+			coordinate.Z + FixedPoint::Round(w * tz + x * ty - y * tx, FixedPoint::Q30 + 22 - FixedPoint::Q14)
+		);
+	}
+
+	//Gravity direction in the sensor frame, as MPU6050::dmpGetGravity
+	Vector3Q14 Gravity() const {
+		int64_t w = W, x = X, y = Y, z = Z;
+		const int shift = 2 * FixedPoint::Q30 - FixedPoint::Q14;//Q60 products to Q14
+
+		return Vector3Q14(
+			FixedPoint::Round(x * z - w * y, shift - 1),
+			FixedPoint::Round(w * x + y * z, shift - 1),
+			FixedPoint::Round(w * w - x * x - y * y + z * z, shift)
+		);
+	}
+
+	//Raw accelerometer minus gravity, as MPU6050::dmpGetLinearAccel
+	Vector3Q14 LinearAcceleration(const Vector3Q14& acceleration) const {
+		return acceleration - Gravity();
+	}
+
+	Quaternion ToQuaternion() const {
+		const double scale = 1.0 / (1 << FixedPoint::Q30);
+
+		return Quaternion(W * scale, X * scale, Y * scale, Z * scale);
+	}
+
+	std::string ToString() const;
+
+	//w, x, y, z as MPU6050::dmpGetQuaternion(int32_t *)
+	static QuaternionQ30 FromDMP(const int32_t *words) {
+		return QuaternionQ30(words[0], words[1], words[2], words[3]);
+	}
+
+	static QuaternionQ30 FromQuaternion(Quaternion quaternion);
+	static void ToQuaternion(const QuaternionQ30 *quaternions, Quaternion *result, int count);
+} QuaternionQ30;
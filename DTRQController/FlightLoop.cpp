@@ -0,0 +1,79 @@
+#include "FlightLoop.h"
+
+FlightLoop::FlightLoop(Vector3D forwardOffset, Vector3D backOffset) {
+	VectorFeedbackController *pos = new VectorFeedbackController{
+		new PID{ 10, 0, 12.5 },
+		new PID{ 1, 0, 0.2 },
+		new PID{ 10, 0, 12.5 }
+	};
+
+	VectorFeedbackController *rot = new VectorFeedbackController{
+		new PID{ 0.05, 0, 0.325 },
+		new PID{ 0.05, 0, 0.325 },
+		new PID{ 0.05, 0, 0.325 }
+	};
+
+	this->quad = new Quadcopter(false, 0.3, 55, 0.05, pos, rot);
+	this->quatKF = QuaternionKalmanFilterF(0.75f, 10);
+	this->acceHP = FIRBankF(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+	this->forwardOffset = Vector3F(forwardOffset);
+	this->backOffset = Vector3F(backOffset);
+	this->velocity = Vector3F(0, 0, 0);
+	this->position = Vector3F(0, 0, 0);
+}
+
+FlightLoop::~FlightLoop() {
+	delete quad;
+}
+
+FlightLoop::Outputs FlightLoop::Tick(Inputs inputs) {
+	Outputs outputs;
+	float dT = (float)inputs.dT;
+
+	Vector3F af, ab;
+	af = Vector3F(inputs.MainFAcceleration).Add(forwardOffset);
+	ab = Vector3F(inputs.MainBAcceleration).Add(backOffset);
+
+	QuaternionF qf, qb;
+	qf = QuaternionF(inputs.MainFRotation).UnitQuaternion();
+	qb = QuaternionF(inputs.MainBRotation).UnitQuaternion();
+
+	quatKF.Filter(qb);
+	QuaternionF rotation = quatKF.Filter(qf).UnitQuaternion();
+
+	af = af.Divide(2.0f);
+	ab = ab.Divide(2.0f);
+
+	float accelerations[6] = { af.X, af.Y, af.Z, ab.X, ab.Y, ab.Z };
+
+	acceHP.Filter(accelerations, accelerations);
+
+	Vector3F worldAcceleration = Vector3F(accelerations[3], accelerations[4], accelerations[5]).Add(Vector3F(accelerations[0], accelerations[1], accelerations[2]));
+
+	velocity = velocity.Add(worldAcceleration.Multiply(9.81f).Multiply(dT));//g-force to m/s^2
+	position = position.Add(velocity.Multiply(dT));
+
+	outputs.Rotation = Quaternion(rotation);
+	outputs.WorldAcceleration = Vector3D(worldAcceleration);
+	outputs.Position = Vector3D(position);
+
+	quad->SetTarget(inputs.TargetPosition, Rotation(inputs.TargetRotation));
+	quad->SetCurrent(outputs.Position, outputs.Rotation);
+
+	quad->CalculateCombinedThrustVector();//Secondary Solver
+
+	outputs.ThrustB = Vector3D(-quad->TB->CurrentRotation.X, 0, -quad->TB->CurrentRotation.Z);
+	outputs.ThrustC = Vector3D(-quad->TC->CurrentRotation.X, 0,  quad->TC->CurrentRotation.Z);
+	outputs.ThrustD = Vector3D( quad->TD->CurrentRotation.X, 0,  quad->TD->CurrentRotation.Z);
+	outputs.ThrustE = Vector3D( quad->TE->CurrentRotation.X, 0, -quad->TE->CurrentRotation.Z);
+
+	return outputs;
+}
+
+Vector3D FlightLoop::GetForwardOffset() {
+	return Vector3D(forwardOffset);
+}
+
+Vector3D FlightLoop::GetBackOffset() {
+	return Vector3D(backOffset);
+}
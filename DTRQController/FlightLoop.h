@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Quadcopter.h"
+#include "QuaternionKalmanFilter.h"
+#include "Rotation.h"
+#include "Vector.h"
+#include "FIRBank.h"
+
+//Per tick body of the arm controller loop, everything it consumes arrives through Inputs so a recorded
+//flight can be fed back through the same filters and solver without the hardware. The filters and dead reckoning
+//run in float, Inputs and Outputs stay double for the recorder, and the thrust solver is the double Quadcopter
+//shared with the simulation.
+class FlightLoop {
+public:
+	typedef struct Inputs {
+		double dT;//measured seconds since the previous tick
+		Quaternion MainFRotation;//raw DMP quaternions
+		Quaternion MainBRotation;
+		Vector3D MainFAcceleration;//raw world accelerations in g, before offsets
+		Vector3D MainBAcceleration;
+		Vector3D TargetPosition;
+		Quaternion TargetRotation;
+	} Inputs;
+
+	typedef struct Outputs {
+		Quaternion Rotation;
+		Vector3D WorldAcceleration;
+		Vector3D Position;
+		Vector3D ThrustB;//servo commands written to the PWM controller
+		Vector3D ThrustC;
+		Vector3D ThrustD;
+		Vector3D ThrustE;
+	} Outputs;
+
+private:
+	Quadcopter *quad;
+	QuaternionKalmanFilterF quatKF;
+	FIRBankF acceHP;//front X, Y, Z then back X, Y, Z
+	Vector3F forwardOffset;
+	Vector3F backOffset;
+	Vector3F velocity;
+	Vector3F position;
+
+public:
+	FlightLoop(Vector3D forwardOffset, Vector3D backOffset);
+	~FlightLoop();
+
+	Outputs Tick(Inputs inputs);
+
+	Vector3D GetForwardOffset();
+	Vector3D GetBackOffset();
+};
@@ -0,0 +1,189 @@
+#include "FlightRecorder.h"
+
+const char FlightRecorder::Magic[8] = { 'D', 'T', 'R', 'Q', 'T', 'R', 'C', '\0' };
+
+FlightRecorder::FlightRecorder() {
+	writing = false;
+	ticks = 0;
+	forwardOffset = Vector3D(0, 0, 0);
+	backOffset = Vector3D(0, 0, 0);
+	record.resize(InputValues + OutputValues);
+}
+
+FlightRecorder::~FlightRecorder() {
+	Close();
+}
+
+bool FlightRecorder::OpenWrite(std::string path, Vector3D forwardOffset, Vector3D backOffset) {
+	Close();
+
+	file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open()) {
+		std::cout << "Could not open flight trace " << path << " for writing." << std::endl;
+		return false;
+	}
+
+	writing = true;
+	ticks = 0;
+	this->forwardOffset = forwardOffset;
+	this->backOffset = backOffset;
+
+	uint32_t version = Version;
+	double offsets[6];
+	double *values = offsets;
+
+	Pack(values, forwardOffset);
+	Pack(values, backOffset);
+
+	file.write(Magic, sizeof(Magic));
+	file.write((const char *)&version, sizeof(version));
+	file.write((const char *)offsets, sizeof(offsets));
+
+	return file.good();
+}
+
+bool FlightRecorder::OpenRead(std::string path) {
+	Close();
+
+	file.open(path, std::ios::in | std::ios::binary);
+
+	if (!file.is_open()) {
+		std::cout << "Could not open flight trace " << path << " for reading." << std::endl;
+		return false;
+	}
+
+	char magic[8];
+	uint32_t version = 0;
+	double offsets[6];
+
+	file.read(magic, sizeof(magic));
+	file.read((char *)&version, sizeof(version));
+	file.read((char *)offsets, sizeof(offsets));
+
+	if (!file.good() || memcmp(magic, Magic, sizeof(Magic)) != 0 || version != Version) {
+		std::cout << "File " << path << " is not a version " << Version << " flight trace." << std::endl;
+		file.close();
+		return false;
+	}
+
+	const double *values = offsets;
+
+	writing = false;
+	ticks = 0;
+	forwardOffset = UnpackVector(values);
+	backOffset = UnpackVector(values);
+
+	return true;
+}
+
+void FlightRecorder::Close() {
+	if (file.is_open()) {
+		file.close();
+	}
+}
+
+bool FlightRecorder::Record(FlightLoop::Inputs inputs, FlightLoop::Outputs outputs) {
+	if (!file.is_open() || !writing) {
+		return false;
+	}
+
+	double *values = record.data();
+
+	*values++ = inputs.dT;
+	Pack(values, inputs.MainFRotation);
+	Pack(values, inputs.MainBRotation);
+	Pack(values, inputs.MainFAcceleration);
+	Pack(values, inputs.MainBAcceleration);
+	Pack(values, inputs.TargetPosition);
+	Pack(values, inputs.TargetRotation);
+
+	Pack(values, outputs.Rotation);
+	Pack(values, outputs.WorldAcceleration);
+	Pack(values, outputs.Position);
+	Pack(values, outputs.ThrustB);
+	Pack(values, outputs.ThrustC);
+	Pack(values, outputs.ThrustD);
+	Pack(values, outputs.ThrustE);
+
+	file.write((const char *)record.data(), record.size() * sizeof(double));
+
+	ticks++;
+
+	return file.good();
+}
+
+bool FlightRecorder::Read(FlightLoop::Inputs &inputs, FlightLoop::Outputs &outputs) {
+	if (!file.is_open() || writing) {
+		return false;
+	}
+
+	file.read((char *)record.data(), record.size() * sizeof(double));
+
+	if (file.gcount() != (std::streamsize)(record.size() * sizeof(double))) {
+		return false;
+	}
+
+	const double *values = record.data();
+
+	inputs.dT = *values++;
+	inputs.MainFRotation = UnpackQuaternion(values);
+	inputs.MainBRotation = UnpackQuaternion(values);
+	inputs.MainFAcceleration = UnpackVector(values);
+	inputs.MainBAcceleration = UnpackVector(values);
+	inputs.TargetPosition = UnpackVector(values);
+	inputs.TargetRotation = UnpackQuaternion(values);
+
+	outputs.Rotation = UnpackQuaternion(values);
+	outputs.WorldAcceleration = UnpackVector(values);
+	outputs.Position = UnpackVector(values);
+	outputs.ThrustB = UnpackVector(values);
+	outputs.ThrustC = UnpackVector(values);
+	outputs.ThrustD = UnpackVector(values);
+	outputs.ThrustE = UnpackVector(values);
+
+	ticks++;
+
+	return true;
+}
+
+int FlightRecorder::GetTicks() {
+	return ticks;
+}
+
+Vector3D FlightRecorder::GetForwardOffset() {
+	return forwardOffset;
+}
+
+Vector3D FlightRecorder::GetBackOffset() {
+	return backOffset;
+}
+
+void FlightRecorder::Pack(double *&values, Vector3D vector) {
+	*values++ = vector.X;
+	*values++ = vector.Y;
+	*values++ = vector.Z;
+}
+
+void FlightRecorder::Pack(double *&values, Quaternion quaternion) {
+	*values++ = quaternion.W;
+	*values++ = quaternion.X;
+	*values++ = quaternion.Y;
+	*values++ = quaternion.Z;
+}
+
+Vector3D FlightRecorder::UnpackVector(const double *&values) {
+	Vector3D vector = Vector3D(values[0], values[1], values[2]);
+
+	values += 3;
+
+	return vector;
+}
+
+Quaternion FlightRecorder::UnpackQuaternion(const double *&values) {
+	Quaternion quaternion = Quaternion(values[0], values[1], values[2], values[3]);
+
+	values += 4;
+
+	return quaternion;
+}
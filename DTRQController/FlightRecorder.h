@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FlightLoop.h"
+
+//Binary trace of FlightLoop ticks: a header holding the calibration offsets followed by one fixed size record
+//per tick with the inputs and the outputs they produced. Values are stored as raw native doubles so a replay
+//is bit for bit, the Pi and the x86 workstations are both little endian
+class FlightRecorder {
+private:
+	static const char Magic[8];
+	//1 was filtered before the accelerometer FIR folded its symmetric taps, 2 rotated through the normalizing
+	//quaternion paths before Quadcopter kept its rotations at unit length, 3 filtered in double
+	static const uint32_t Version = 4;
+	static const int InputValues = 22;
+	static const int OutputValues = 22;
+
+	std::fstream file;
+	bool writing;
+	int ticks;
+	Vector3D forwardOffset;
+	Vector3D backOffset;
+	std::vector<double> record;
+
+	static void Pack(double *&values, Vector3D vector);
+	static void Pack(double *&values, Quaternion quaternion);
+	static Vector3D UnpackVector(const double *&values);
+	static Quaternion UnpackQuaternion(const double *&values);
+
+public:
+	FlightRecorder();
+	~FlightRecorder();
+
+	bool OpenWrite(std::string path, Vector3D forwardOffset, Vector3D backOffset);
+	bool OpenRead(std::string path);
+	void Close();
+
+	bool Record(FlightLoop::Inputs inputs, FlightLoop::Outputs outputs);
+	bool Read(FlightLoop::Inputs &inputs, FlightLoop::Outputs &outputs);
+
+	int GetTicks();
+	Vector3D GetForwardOffset();
+	Vector3D GetBackOffset();
+};
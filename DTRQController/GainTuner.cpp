@@ -0,0 +1,441 @@
+#include "GainTuner.h"
+
+GainTuner::GainTuner(ControllerType type, int steps, double dT) {
+	this->type = type;
+	this->steps = steps;
+	this->dT = dT;
+	this->batchSize = 0;
+	this->attitudeWeight = 0.1;
+	this->divergencePenalty = 1000.0;
+	this->evaluations = 0;
+
+	const std::string loops[3] = { "Position", "Altitude", "Rotation" };
+
+	//Starting points are the hand tuned gains from Main.cpp and the ADRC set commented out in DTRQCSInterface
+	const double pid[3][3] = { { 10, 0, 12.5 }, { 1, 0, 0.2 }, { 0.05, 0, 0.325 } };
+	const double pidUpper[3][3] = { { 40, 10, 40 }, { 20, 10, 10 }, { 1, 0.5, 2 } };
+	const double adrc[3][4] = { { 50, 200, 4, 10 }, { 10, 10, 1.5, 0.05 }, { 20, 200, 4, 10 } };
+	const double adrcPid[3][3] = { { 10, 0, 12.5 }, { 1, 0, 0.2 }, { 5, 0, 7.5 } };
+	const double adrcPidUpper[3][3] = { { 40, 10, 40 }, { 20, 10, 10 }, { 20, 10, 30 } };
+	const double adrcLower[4] = { 0.1, 0.1, 0.1, 0.01 };
+	const double adrcUpper[4] = { 200, 400, 20, 100 };
+	const std::string adrcNames[4] = { "Amplification", "Damping", "Plant", "PrecisionModifier" };
+	const std::string pidNames[3] = { "Kp", "Ki", "Kd" };
+
+	for (int loop = 0; loop < 3; loop++) {
+		if (type == ADRCControl) {
+			for (int i = 0; i < 4; i++) {
+				parameters.push_back(Parameter{ loops[loop] + adrcNames[i], adrc[loop][i], adrcLower[i], adrcUpper[i] });
+			}
+		}
+
+		for (int i = 0; i < 3; i++) {
+			if (type == ADRCControl) {
+				parameters.push_back(Parameter{ loops[loop] + pidNames[i], adrcPid[loop][i], 0.0, adrcPidUpper[loop][i] });
+			}
+			else {
+				parameters.push_back(Parameter{ loops[loop] + pidNames[i], pid[loop][i], 0.0, pidUpper[loop][i] });
+			}
+		}
+	}
+}
+
+void GainTuner::AddScenario(Scenario scenario) {
+	scenarios.push_back(scenario);
+}
+
+void GainTuner::SetParameter(int index, double initial, double lower, double upper) {
+	if (index < 0 || index >= (int)parameters.size()) {
+		std::cout << "Gain tuner parameter index " << index << " out of range." << std::endl;
+		return;
+	}
+
+	parameters[index].Initial = initial;
+	parameters[index].Lower = lower;
+	parameters[index].Upper = upper;
+}
+
+void GainTuner::SetBatchSize(int batchSize) {
+	this->batchSize = batchSize;
+}
+
+void GainTuner::SetAttitudeWeight(double weight) {
+	attitudeWeight = weight;
+}
+
+std::vector<GainTuner::Parameter> GainTuner::GetParameters() {
+	return parameters;
+}
+
+std::vector<GainTuner::Scenario> GainTuner::GetScenarios() {
+	return scenarios;
+}
+
+FeedbackController* GainTuner::CreateController(const std::vector<double> &gains, int offset) {
+	if (type == ADRCControl) {
+		return new ADRC{ gains[offset], gains[offset + 1], gains[offset + 2], gains[offset + 3],
+			PID{ gains[offset + 4], gains[offset + 5], gains[offset + 6] } };
+	}
+
+	return new PID{ gains[offset], gains[offset + 1], gains[offset + 2] };
+}
+
+void GainTuner::CreateControllers(const std::vector<double> &gains, VectorFeedbackController *&pos, VectorFeedbackController *&rot) {
+	int size = type == ADRCControl ? 7 : 3;
+
+	//X and Z share the position gains, all three rotation axes share the rotation gains
+	pos = new VectorFeedbackController{
+		CreateController(gains, 0),
+		CreateController(gains, size),
+		CreateController(gains, 0)
+	};
+
+	rot = new VectorFeedbackController{
+		CreateController(gains, size * 2),
+		CreateController(gains, size * 2),
+		CreateController(gains, size * 2)
+	};
+}
+
+GainTuner::StepMetrics GainTuner::Measure(const std::vector<double> &magnitude, const std::vector<double> &signedError, double band) {
+	int count = (int)magnitude.size();
+	StepMetrics metrics = StepMetrics{ magnitude[0], magnitude[0] > 0 ? -1.0 : 0.0, 0.0, -1.0, magnitude[count - 1], 0.0 };
+	double minimum = 0.0;
+	int lastOutside = 0;
+
+	for (int i = 1; i < count; i++) {
+		double t = i * dT;
+
+		if (metrics.RiseTime < 0 && signedError[i] <= 0.1 * metrics.Initial) {
+			metrics.RiseTime = t;
+		}
+
+		if (magnitude[i] > band) {
+			lastOutside = i;
+		}
+
+		minimum = std::min(minimum, signedError[i]);
+		metrics.IntegratedError += t * magnitude[i] * dT;
+	}
+
+	if (metrics.Initial > 0) {
+		metrics.Overshoot = -minimum / metrics.Initial * 100.0;
+	}
+
+	if (lastOutside < count - 1) {
+		metrics.SettlingTime = lastOutside * dT;
+	}
+
+	return metrics;
+}
+
+GainTuner::Evaluation GainTuner::Simulate(const std::vector<double> &gains, Scenario scenario) {
+	VectorFeedbackController *pos, *rot;
+
+	CreateControllers(gains, pos, rot);
+
+	Quadcopter quad(true, 0.3, 55, dT, pos, rot, false);
+	Vector3D targetPosition = Vector3D(0, 0, 0);
+	Rotation targetRotation = Rotation(Quaternion(1, 0, 0, 0));
+	Quaternion target = targetRotation.GetQuaternion();
+
+	quad.SetFeedbackEnabled(true);
+	quad.SetCurrent(scenario.InitialPosition, Rotation(EulerAngles(scenario.InitialRotation, EulerConstants::EulerOrderXYZS)));
+
+	//Signed errors are projected on the initial error so crossing the target shows up as overshoot
+	Vector3D positionDirection = scenario.InitialPosition.Subtract(targetPosition);
+	Vector3D rotationDirection = (quad.CurrentRotation.GetQuaternion() * target.Conjugate()).GetBiVector();
+
+	std::vector<double> positionError(1, positionDirection.Magnitude());
+	std::vector<double> attitudeError(1, MonteCarloCampaign::AttitudeError(quad.CurrentRotation.GetQuaternion(), target));
+	std::vector<double> positionSigned(1, positionError[0]);
+	std::vector<double> attitudeSigned(1, attitudeError[0]);
+
+	positionDirection = positionError[0] > 0 ? positionDirection / positionError[0] : positionDirection;
+	rotationDirection = rotationDirection.Magnitude() > 0 ? rotationDirection / rotationDirection.Magnitude() : rotationDirection;
+
+	Evaluation evaluation;
+
+	evaluation.Diverged = false;
+
+	for (int step = 0; step < steps; step++) {
+		quad.SetTarget(targetPosition, targetRotation);
+		quad.SimulateCurrent(scenario.ExternalAcceleration);
+		quad.CalculateCombinedThrustVector();
+
+		Vector3D offset = quad.CurrentPosition.Subtract(targetPosition);
+		Quaternion difference = quad.CurrentRotation.GetQuaternion() * target.Conjugate();
+		double distance = offset.Magnitude();
+		double angle = MonteCarloCampaign::AttitudeError(quad.CurrentRotation.GetQuaternion(), target);
+
+		if (Mathematics::IsNaN(distance) || Mathematics::IsNaN(angle) || distance > 100.0) {
+			evaluation.Diverged = true;
+			evaluation.Cost = divergencePenalty * (2.0 - (double)step / steps);//earlier divergence scores worse
+
+			break;
+		}
+
+		double axis = difference.GetBiVector().DotProduct(rotationDirection) * Mathematics::Sign(difference.W);
+
+		positionError.push_back(distance);
+		attitudeError.push_back(angle);
+		positionSigned.push_back(positionError[0] > 0 ? offset.DotProduct(positionDirection) : distance);
+		attitudeSigned.push_back(attitudeError[0] > 0 && axis < 0 ? -angle : angle);
+	}
+
+	evaluation.Position = Measure(positionError, positionSigned, std::max(0.02 * positionError[0], 0.01));
+	evaluation.Attitude = Measure(attitudeError, attitudeSigned, std::max(0.02 * attitudeError[0], 0.2));
+
+	if (!evaluation.Diverged) {
+		evaluation.Cost = evaluation.Position.IntegratedError + attitudeWeight * evaluation.Attitude.IntegratedError;
+	}
+
+	return evaluation;
+}
+
+double GainTuner::Evaluate(const std::vector<double> &gains) {
+	double cost = 0.0;
+
+	for (Scenario scenario : scenarios) {
+		cost += Simulate(gains, scenario).Cost;
+	}
+
+	return cost;
+}
+
+std::vector<double> GainTuner::Evaluate(const std::vector<std::vector<double>> &candidates, WorkStealingPool &pool) {
+	int count = (int)scenarios.size();
+	std::vector<double> runs(candidates.size() * count);
+	std::vector<double> costs(candidates.size(), 0.0);
+
+	//Every candidate and scenario pair is its own task, summed afterwards in scenario order
+	pool.Run((int)runs.size(), [&](int task) {
+		runs[task] = Simulate(candidates[task / count], scenarios[task % count]).Cost;
+	});
+
+	for (int i = 0; i < (int)candidates.size(); i++) {
+		for (int j = 0; j < count; j++) {
+			costs[i] += runs[i * count + j];
+		}
+	}
+
+	evaluations += (int)runs.size();
+
+	return costs;
+}
+
+std::vector<double> GainTuner::Clamp(std::vector<double> gains) {
+	for (int i = 0; i < (int)gains.size(); i++) {
+		gains[i] = Mathematics::Constrain(gains[i], parameters[i].Lower, parameters[i].Upper);
+	}
+
+	return gains;
+}
+
+std::vector<double> GainTuner::Move(const std::vector<double> &centroid, const std::vector<double> &point, double coefficient) {
+	std::vector<double> moved(centroid.size());
+
+	for (int i = 0; i < (int)centroid.size(); i++) {
+		moved[i] = centroid[i] + coefficient * (point[i] - centroid[i]);
+	}
+
+	return Clamp(moved);
+}
+
+GainTuner::Result GainTuner::Tune(int iterations) {
+	return Tune(iterations, (int)std::thread::hardware_concurrency());
+}
+
+GainTuner::Result GainTuner::Tune(int iterations, int threads) {
+	if (scenarios.empty()) {
+		AddScenario(Scenario{ Vector3D(0, 0, 0), Vector3D(10, 0, 0), Vector3D(0, -9.81, 0) });
+		AddScenario(Scenario{ Vector3D(0, 0, 0), Vector3D(0, 0, 10), Vector3D(0, -9.81, 0) });
+		AddScenario(Scenario{ Vector3D(1, 0, 0), Vector3D(0, 0, 0), Vector3D(0, -9.81, 0) });
+		AddScenario(Scenario{ Vector3D(0, 1, 0), Vector3D(0, 0, 0), Vector3D(0, -9.81, 0) });
+	}
+
+	WorkStealingPool pool = WorkStealingPool(threads);
+	int n = (int)parameters.size();
+	int batch = (int)Mathematics::Constrain(batchSize > 0 ? batchSize : pool.GetThreadCount(), 1, n);
+	int kept = n + 1 - batch;
+
+	evaluations = 0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::vector<double>> points;
+
+	for (int i = 0; i <= n; i++) {
+		std::vector<double> point;
+
+		for (Parameter parameter : parameters) {
+			point.push_back(parameter.Initial);
+		}
+
+		if (i > 0) {
+			Parameter parameter = parameters[i - 1];
+			double step = 0.1 * (parameter.Upper - parameter.Lower);
+
+			point[i - 1] += point[i - 1] + step > parameter.Upper ? -step : step;
+		}
+
+		points.push_back(Clamp(point));
+	}
+
+	std::vector<double> costs = Evaluate(points, pool);
+	std::vector<Vertex> simplex;
+
+	for (int i = 0; i <= n; i++) {
+		simplex.push_back(Vertex{ points[i], costs[i] });
+	}
+
+	Result result;
+
+	result.InitialCost = simplex[0].Cost;
+	result.Iterations = 0;
+
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		std::stable_sort(simplex.begin(), simplex.end(), [](const Vertex &a, const Vertex &b) { return a.Cost < b.Cost; });
+
+		std::vector<double> centroid(n, 0.0);
+
+		for (int i = 0; i < kept; i++) {
+			for (int j = 0; j < n; j++) {
+				centroid[j] += simplex[i].Gains[j] / kept;
+			}
+		}
+
+		double best = simplex[0].Cost;
+		double threshold = simplex[kept - 1].Cost;
+
+		//Reflect the worst batch of vertices through the centroid of the rest together
+		std::vector<std::vector<double>> reflections;
+
+		for (int j = kept; j <= n; j++) {
+			reflections.push_back(Move(centroid, simplex[j].Gains, -1.0));
+		}
+
+		std::vector<double> reflected = Evaluate(reflections, pool);
+
+		//Expansions and contractions for the whole batch are evaluated in a second round
+		std::vector<std::vector<double>> followUps;
+		std::vector<int> followUpIndex(batch, -1);
+
+		for (int b = 0; b < batch; b++) {
+			if (reflected[b] < best) {
+				followUpIndex[b] = (int)followUps.size();
+				followUps.push_back(Move(centroid, reflections[b], 2.0));
+			}
+			else if (reflected[b] >= threshold) {
+				followUpIndex[b] = (int)followUps.size();
+				followUps.push_back(reflected[b] < simplex[kept + b].Cost ? Move(centroid, reflections[b], 0.5) : Move(centroid, simplex[kept + b].Gains, 0.5));
+			}
+		}
+
+		std::vector<double> followed = Evaluate(followUps, pool);
+		bool improved = false;
+
+		for (int b = 0; b < batch; b++) {
+			Vertex &vertex = simplex[kept + b];
+			int index = followUpIndex[b];
+
+			if (reflected[b] < best) {
+				vertex = followed[index] < reflected[b] ? Vertex{ followUps[index], followed[index] } : Vertex{ reflections[b], reflected[b] };
+				improved = true;
+			}
+			else if (reflected[b] < threshold) {
+				vertex = Vertex{ reflections[b], reflected[b] };
+				improved = true;
+			}
+			else if (followed[index] < std::min(reflected[b], vertex.Cost)) {
+				vertex = Vertex{ followUps[index], followed[index] };
+				improved = true;
+			}
+		}
+
+		if (!improved) {
+			//Shrink everything towards the best vertex
+			std::vector<std::vector<double>> shrunk;
+
+			for (int i = 1; i <= n; i++) {
+				shrunk.push_back(Move(simplex[0].Gains, simplex[i].Gains, 0.5));
+			}
+
+			std::vector<double> shrunkCosts = Evaluate(shrunk, pool);
+
+			for (int i = 1; i <= n; i++) {
+				simplex[i] = Vertex{ shrunk[i - 1], shrunkCosts[i - 1] };
+			}
+		}
+
+		result.Iterations++;
+	}
+
+	std::stable_sort(simplex.begin(), simplex.end(), [](const Vertex &a, const Vertex &b) { return a.Cost < b.Cost; });
+
+	result.Gains = simplex[0].Gains;
+	result.Cost = simplex[0].Cost;
+	result.Evaluations = evaluations;
+
+	for (Scenario scenario : scenarios) {
+		result.Scenarios.push_back(Simulate(result.Gains, scenario));
+	}
+
+	result.ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return result;
+}
+
+std::string GainTuner::FormatGains(const std::vector<double> &gains) {
+	const std::string loops[3] = { "Position", "Altitude", "Rotation" };
+	int size = type == ADRCControl ? 7 : 3;
+	std::string output;
+
+	for (int loop = 0; loop < 3; loop++) {
+		int o = loop * size;
+		std::string pid = "PID{ " + Mathematics::DoubleToCleanString(gains[o + size - 3]) + ", " +
+			Mathematics::DoubleToCleanString(gains[o + size - 2]) + ", " +
+			Mathematics::DoubleToCleanString(gains[o + size - 1]) + " }";
+
+		output += loops[loop] + ": ";
+
+		if (type == ADRCControl) {
+			output += "ADRC{ " + Mathematics::DoubleToCleanString(gains[o]) + ", " + Mathematics::DoubleToCleanString(gains[o + 1]) + ", " +
+				Mathematics::DoubleToCleanString(gains[o + 2]) + ", " + Mathematics::DoubleToCleanString(gains[o + 3]) + ", " + pid + " }";
+		}
+		else {
+			output += pid;
+		}
+
+		output += "\n";
+	}
+
+	return output;
+}
+
+std::string GainTuner::ToString(const Result &result) {
+	std::string output = FormatGains(result.Gains);
+
+	output += "Cost: " + Mathematics::DoubleToCleanString(result.Cost) + " (initial " + Mathematics::DoubleToCleanString(result.InitialCost) + ")" +
+		" Iterations: " + std::to_string(result.Iterations) + " Simulations: " + std::to_string(result.Evaluations) +
+		" Elapsed: " + Mathematics::DoubleToCleanString(result.ElapsedSeconds) + "\n";
+
+	for (int i = 0; i < (int)result.Scenarios.size(); i++) {
+		Evaluation evaluation = result.Scenarios[i];
+
+		output += "Scenario " + std::to_string(i) + (evaluation.Diverged ? " diverged" : "") + "\n";
+		output += "  Attitude " + evaluation.Attitude.ToString() + "\n";
+		output += "  Position " + evaluation.Position.ToString() + "\n";
+	}
+
+	return output;
+}
+
+std::string GainTuner::StepMetrics::ToString() {
+	return "initial:" + Mathematics::DoubleToCleanString(Initial) +
+		" rise:" + Mathematics::DoubleToCleanString(RiseTime) +
+		" overshoot%:" + Mathematics::DoubleToCleanString(Overshoot) +
+		" settling:" + Mathematics::DoubleToCleanString(SettlingTime) +
+		" steady state:" + Mathematics::DoubleToCleanString(SteadyStateError) +
+		" ITAE:" + Mathematics::DoubleToCleanString(IntegratedError);
+}
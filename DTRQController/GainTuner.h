@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "ADRC.h"
+#include "Mathematics.h"
+#include "MonteCarloCampaign.h"
+#include "PID.h"
+#include "Quadcopter.h"
+#include "Rotation.h"
+#include "Vector.h"
+#include "VectorFeedbackController.h"
+#include "WorkStealingPool.h"
+
+//Searches the position, altitude and rotation controller gains with a batched Nelder-Mead simplex, the worst
+//vertices of the simplex are moved together each iteration and every candidate is scored by closed loop
+//step responses of Quadcopter spread across the worker threads
+class GainTuner {
+public:
+	enum ControllerType {
+		PIDControl,//Kp, Ki, Kd per loop
+		ADRCControl//amplification, damping, plant, precision modifier, Kp, Ki, Kd per loop
+	};
+
+	typedef struct Parameter {
+		std::string Name;
+		double Initial;
+		double Lower;
+		double Upper;
+	} Parameter;
+
+	typedef struct Scenario {
+		Vector3D InitialPosition;
+		Vector3D InitialRotation;//XYZ static Euler angles in degrees
+		Vector3D ExternalAcceleration;
+	} Scenario;
+
+	typedef struct StepMetrics {
+		double Initial;//error magnitude at the start of the step
+		double RiseTime;//seconds to cover 90% of the initial error, negative when never reached
+		double Overshoot;//percent of the initial error crossed past the target
+		double SettlingTime;//seconds until the error stays in the band, negative when it never settles
+		double SteadyStateError;
+		double IntegratedError;//integral of time weighted absolute error
+
+		std::string ToString();
+	} StepMetrics;
+
+	typedef struct Evaluation {
+		double Cost;
+		bool Diverged;
+		StepMetrics Attitude;//degrees
+		StepMetrics Position;//meters
+	} Evaluation;
+
+	typedef struct Result {
+		std::vector<double> Gains;
+		double InitialCost;
+		double Cost;
+		std::vector<Evaluation> Scenarios;
+		int Iterations;
+		int Evaluations;
+		double ElapsedSeconds;
+	} Result;
+
+	GainTuner(ControllerType type, int steps, double dT);
+
+	void AddScenario(Scenario scenario);
+	void SetParameter(int index, double initial, double lower, double upper);
+	void SetBatchSize(int batchSize);
+	void SetAttitudeWeight(double weight);
+
+	std::vector<Parameter> GetParameters();
+	std::vector<Scenario> GetScenarios();
+
+	Evaluation Simulate(const std::vector<double> &gains, Scenario scenario);
+	double Evaluate(const std::vector<double> &gains);
+	Result Tune(int iterations);
+	Result Tune(int iterations, int threads);
+
+	std::string FormatGains(const std::vector<double> &gains);
+	std::string ToString(const Result &result);
+
+private:
+	typedef struct Vertex {
+		std::vector<double> Gains;
+		double Cost;
+	} Vertex;
+
+	ControllerType type;
+	int steps;
+	double dT;
+	int batchSize;
+	double attitudeWeight;
+	double divergencePenalty;
+	std::vector<Parameter> parameters;
+	std::vector<Scenario> scenarios;
+	int evaluations;
+
+	void CreateControllers(const std::vector<double> &gains, VectorFeedbackController *&pos, VectorFeedbackController *&rot);
+	FeedbackController* CreateController(const std::vector<double> &gains, int offset);
+	std::vector<double> Clamp(std::vector<double> gains);
+	std::vector<double> Move(const std::vector<double> &centroid, const std::vector<double> &point, double coefficient);
+	std::vector<double> Evaluate(const std::vector<std::vector<double>> &candidates, WorkStealingPool &pool);
+	StepMetrics Measure(const std::vector<double> &magnitude, const std::vector<double> &signedError, double band);
+};
@@ -6,14 +6,15 @@ HighPassFilter::HighPassFilter() {
 	this->memory = 25;
 }
 
-HighPassFilter::~HighPassFilter() {
-	delete[] previousTransform;
-}
-
 HighPassFilter::HighPassFilter(double samplingFrequency, double cutoffFrequency, int memory) {
 	this->cutoffFrequency = cutoffFrequency;
 	this->samplingFrequency = samplingFrequency;
 	this->memory = memory;
+
+	plan = RealFFTPlan(memory);
+	spectrum.resize(plan.GetBins());
+	previousTransform.resize(plan.GetLength());
+	samples.reserve(memory + 1);
 }
 
 double HighPassFilter::Filter(double value) {
@@ -28,67 +29,33 @@ double HighPassFilter::Filter(double value) {
 		samples.erase(samples.begin());
 		length = samples.size();
 	}
-	
-	std::complex<double>* complex = new std::complex<double>[length];
-
-	std::cout << "Setting Real" << std::endl;
-
-	double* tempSamples = new double[length];
 
-	for (int i = 0; i < length; i++) {
-		tempSamples[i] = samples.at(i);
+	if (!plan.IsValid()) {
+		return value;
 	}
 
-	FastFourierTransform::SetRealValues(complex, tempSamples, length);
-
-	std::cout << "Performing Fourier" << std::endl;
-
 	//COMPLEX SPACE
-	FastFourierTransform::FFT(complex, length);
-
-	std::cout << "Getting imaginary" << std::endl;
-
-	double* imaginary = FastFourierTransform::GetImagValues(complex, length);
-	double* real = FastFourierTransform::GetRealValues(complex, length);
+	plan.Forward(samples.data(), spectrum.data());
 
 	double ns = (double)samples.size() / 2.0;
 	double cutoffRatio = cutoffFrequency / samplingFrequency;
 
-	std::cout << "Cutoff:" << cutoffRatio << " NS:" << ns << " CF:" << cutoffFrequency << " " << samples.size() << std::endl;
-
 	if (cutoffFrequency > ns) {
 		return value;
 	}
 
 	double range = ns * cutoffRatio / 2.0;
 
-	for (int i = 0; i < int(range); i++) {
-		imaginary[i] = 0;
-		real[i] = 0;
-	}
-
-	for (int i = length - 1; i > length - int(range); i--) {
-		imaginary[i] = 0;
-		real[i] = 0;
+	//Clearing the low bins of the one sided spectrum clears their mirrors above length / 2 with them
+	for (int i = 0; i < int(range) && i < plan.GetBins(); i++) {
+		spectrum[i] = 0;
 	}
 
-	FastFourierTransform::SetImagValues(complex, imaginary, length);
-	FastFourierTransform::SetRealValues(complex, real, length);
-
-	FastFourierTransform::IFFT(complex, length, true);
-
-	previousTransform = FastFourierTransform::GetRealValues(complex, length);
-
-	double temp = previousTransform[(int)(length / 2)];
-
-	delete[] imaginary;
-	delete[] real;
-	delete[] complex;
-	delete[] tempSamples;
+	plan.Inverse(spectrum.data(), previousTransform.data());
 
-	return temp;
+	return previousTransform[(int)(length / 2)];
 }
 
 double* HighPassFilter::GetSamples() {
-	return previousTransform;
+	return previousTransform.data();
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Mathematics.h"
-#include "FastFourierTransform.h"
+#include "RealFFTPlan.h"
 
 class HighPassFilter {
 private:
@@ -9,11 +9,14 @@ private:
 	double cutoffFrequency;
 	int memory;
 	std::vector<double> samples;
-	double* previousTransform;
+	std::vector<double> previousTransform;
+
+	//Transform of the memory, sized once so filtering allocates nothing
+	RealFFTPlan plan;
+	std::vector<std::complex<double>> spectrum;
 
 public:
 	HighPassFilter();
-	~HighPassFilter();
 	HighPassFilter(double samplingFrequency, double cutoffFrequency, int memory);
 
 	double Filter(double value);
@@ -0,0 +1,148 @@
+#include "Matrix3.h"
+#include "SIMD.h"
+#include "Trigonometry.h"
+
+//The batch kernels read the rows as nine contiguous doubles
+static_assert(sizeof(Matrix3) == 9 * sizeof(double), "Matrix3 must stay nine packed doubles.");
+
+//Zero angles are common, a single axis thruster joint or a yaw only rotation, and skip the trig
+static void SineCosine(double degrees, double &s, double &c) {
+	if (degrees == 0) {
+		s = 0.0;
+		c = 1.0;
+	}
+	else {
+		Trigonometry::SinCos(Mathematics::DegreesToRadians(degrees), s, c);
+	}
+}
+
+Matrix3::Matrix3() {
+	M[0][0] = 1.0; M[0][1] = 0.0; M[0][2] = 0.0;
+	M[1][0] = 0.0; M[1][1] = 1.0; M[1][2] = 0.0;
+	M[2][0] = 0.0; M[2][1] = 0.0; M[2][2] = 1.0;
+}
+
+Matrix3::Matrix3(Vector3D row0, Vector3D row1, Vector3D row2) {
+	M[0][0] = row0.X; M[0][1] = row0.Y; M[0][2] = row0.Z;
+	M[1][0] = row1.X; M[1][1] = row1.Y; M[1][2] = row1.Z;
+	M[2][0] = row2.X; M[2][1] = row2.Y; M[2][2] = row2.Z;
+}
+
+Matrix3 Matrix3::Multiply(Matrix3 matrix) {
+	Matrix3 result;
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			result.M[i][j] = M[i][0] * matrix.M[0][j] + M[i][1] * matrix.M[1][j] + M[i][2] * matrix.M[2][j];
+		}
+	}
+
+	return result;
+}
+
+Matrix3 Matrix3::Multiply(double scalar) {
+	Matrix3 result;
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			result.M[i][j] = M[i][j] * scalar;
+		}
+	}
+
+	return result;
+}
+
+Vector3D Matrix3::Multiply(Vector3D vector) {
+	return Vector3D(
+		M[0][0] * vector.X + M[0][1] * vector.Y + M[0][2] * vector.Z,
+		M[1][0] * vector.X + M[1][1] * vector.Y + M[1][2] * vector.Z,
+		M[2][0] * vector.X + M[2][1] * vector.Y + M[2][2] * vector.Z
+	);
+}
+
+void Matrix3::Multiply(const Vector3D *vectors, Vector3D *result, int count) {
+	if (count <= 0) return;
+
+	SIMD::TransformVectors(&M[0][0], &vectors->X, &result->X, count);
+}
+
+Matrix3 Matrix3::Compose(Matrix3 next) {
+	return next.Multiply(*this);
+}
+
+Matrix3 Matrix3::Transpose() {
+	return Matrix3(GetColumn(0), GetColumn(1), GetColumn(2));
+}
+
+Vector3D Matrix3::GetRow(int row) {
+	return Vector3D(M[row][0], M[row][1], M[row][2]);
+}
+
+Vector3D Matrix3::GetColumn(int column) {
+	return Vector3D(M[0][column], M[1][column], M[2][column]);
+}
+
+double Matrix3::Determinant() {
+	return M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1]) -
+		   M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0]) +
+		   M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0]);
+}
+
+bool Matrix3::IsEqual(Matrix3 matrix) {
+	return GetRow(0).IsEqual(matrix.GetRow(0)) && GetRow(1).IsEqual(matrix.GetRow(1)) && GetRow(2).IsEqual(matrix.GetRow(2));
+}
+
+std::string Matrix3::ToString() {
+	return GetRow(0).ToString() + "\n" + GetRow(1).ToString() + "\n" + GetRow(2).ToString() + "\n";
+}
+
+Matrix3 Matrix3::RotationX(double degrees) {
+	double s, c;
+
+	SineCosine(degrees, s, c);
+
+	return Matrix3(
+		Vector3D(1,  0, 0),
+		Vector3D(0,  c, s),
+		Vector3D(0, -s, c)
+	);
+}
+
+Matrix3 Matrix3::RotationY(double degrees) {
+	double s, c;
+
+	SineCosine(degrees, s, c);
+
+	return Matrix3(
+		Vector3D(c, 0, -s),
+		Vector3D(0, 1,  0),
+		Vector3D(s, 0,  c)
+	);
+}
+
+Matrix3 Matrix3::RotationZ(double degrees) {
+	double s, c;
+
+	SineCosine(degrees, s, c);
+
+	return Matrix3(
+		Vector3D( c, s, 0),
+		Vector3D(-s, c, 0),
+		Vector3D( 0, 0, 1)
+	);
+}
+
+Matrix3 Matrix3::RotationXYZ(Vector3D degrees) {
+	//RotationZ * RotationY * RotationX expanded, each angle takes one sine and one cosine
+	double sx, cx, sy, cy, sz, cz;
+
+	SineCosine(degrees.X, sx, cx);
+	SineCosine(degrees.Y, sy, cy);
+	SineCosine(degrees.Z, sz, cz);
+
+	return Matrix3(
+		Vector3D( cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz),
+		Vector3D(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz),
+		Vector3D( sy,     -sx * cy,                cx * cy)
+	);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Mathematics.h"
+#include "Vector.h"
+
+//Dense row major 3x3 matrix, stored inline so temporaries never allocate
+typedef struct Matrix3 {
+public:
+	double M[3][3];
+
+	Matrix3();//identity
+	Matrix3(Vector3D row0, Vector3D row1, Vector3D row2);
+
+	Matrix3 Multiply(Matrix3 matrix);//this * matrix
+	Matrix3 Multiply(double scalar);
+	Vector3D Multiply(Vector3D vector);
+	void Multiply(const Vector3D *vectors, Vector3D *result, int count);
+	Matrix3 Compose(Matrix3 next);//applies this, then next
+	Matrix3 Transpose();
+
+	Vector3D GetRow(int row);
+	Vector3D GetColumn(int column);
+
+	double Determinant();
+	bool IsEqual(Matrix3 matrix);
+	std::string ToString();
+
+	//Rotations in the sense of RotationMatrix::RotateVector, angles in degrees
+	static Matrix3 RotationX(double degrees);
+	static Matrix3 RotationY(double degrees);
+	static Matrix3 RotationZ(double degrees);
+	static Matrix3 RotationXYZ(Vector3D degrees);//X, then Y, then Z
+
+	static Matrix3 Multiply(Matrix3 m1, Matrix3 m2) {
+		return m1.Multiply(m2);
+	}
+
+	static Matrix3 Transpose(Matrix3 matrix) {
+		return matrix.Transpose();
+	}
+
+	static Vector3D Multiply(Matrix3 matrix, Vector3D vector) {
+		return matrix.Multiply(vector);
+	}
+
+	Matrix3 operator *(Matrix3 matrix) {
+		return Multiply(matrix);
+	}
+
+	Vector3D operator *(Vector3D vector) {
+		return Multiply(vector);
+	}
+} Matrix3;
@@ -0,0 +1,210 @@
+#include "MonteCarloCampaign.h"
+
+MonteCarloCampaign::Distribution::Distribution() {
+	//Nominal vehicle and gains from Main.cpp
+	ExternalAcceleration = VectorRange{ Range(0), Range(-9.81), Range(0) };
+	InitialPosition = VectorRange{ Range(0), Range(0), Range(0) };
+	InitialRotation = VectorRange{ Range(0), Range(0), Range(0) };
+	ArmLength = Range(0.3);
+	ArmAngle = Range(55);
+	PositionGains = GainRange{ Range(10), Range(0), Range(12.5) };
+	AltitudeGains = GainRange{ Range(1), Range(0), Range(0.2) };
+	RotationGains = GainRange{ Range(0.05), Range(0), Range(0.325) };
+}
+
+MonteCarloCampaign::MonteCarloCampaign(Distribution distribution, int runs, int steps, double dT, unsigned long long seed) {
+	this->distribution = distribution;
+	this->runs = runs;
+	this->steps = steps;
+	this->dT = dT;
+	this->seed = seed;
+	this->settlingBand = 2.0;
+	this->divergenceDistance = 100.0;
+}
+
+void MonteCarloCampaign::SetSettlingBand(double degrees) {
+	settlingBand = degrees;
+}
+
+void MonteCarloCampaign::SetDivergenceDistance(double distance) {
+	divergenceDistance = distance;
+}
+
+double MonteCarloCampaign::Uniform(std::mt19937_64 &generator, Range range) {
+	//53 random bits, avoids the implementation defined std::uniform_real_distribution
+	double unit = (double)(generator() >> 11) * (1.0 / 9007199254740992.0);
+
+	return range.Minimum + (range.Maximum - range.Minimum) * unit;
+}
+
+Vector3D MonteCarloCampaign::Uniform(std::mt19937_64 &generator, VectorRange range) {
+	double x = Uniform(generator, range.X);
+	double y = Uniform(generator, range.Y);
+	double z = Uniform(generator, range.Z);
+
+	return Vector3D(x, y, z);
+}
+
+Vector3D MonteCarloCampaign::Uniform(std::mt19937_64 &generator, GainRange range) {
+	double kp = Uniform(generator, range.Kp);
+	double ki = Uniform(generator, range.Ki);
+	double kd = Uniform(generator, range.Kd);
+
+	return Vector3D(kp, ki, kd);
+}
+
+MonteCarloCampaign::Sample MonteCarloCampaign::Draw(int run) {
+	std::seed_seq sequence{ (unsigned int)(seed >> 32), (unsigned int)seed, (unsigned int)run };
+	std::mt19937_64 generator(sequence);
+	Sample sample;
+
+	sample.ExternalAcceleration = Uniform(generator, distribution.ExternalAcceleration);
+	sample.InitialPosition = Uniform(generator, distribution.InitialPosition);
+	sample.InitialRotation = Uniform(generator, distribution.InitialRotation);
+	sample.ArmLength = Uniform(generator, distribution.ArmLength);
+	sample.ArmAngle = Uniform(generator, distribution.ArmAngle);
+	sample.PositionGains = Uniform(generator, distribution.PositionGains);
+	sample.AltitudeGains = Uniform(generator, distribution.AltitudeGains);
+	sample.RotationGains = Uniform(generator, distribution.RotationGains);
+
+	return sample;
+}
+
+MonteCarloCampaign::Outcome MonteCarloCampaign::Simulate(Sample sample) {
+	Vector3D p = sample.PositionGains, a = sample.AltitudeGains, r = sample.RotationGains;
+
+	VectorFeedbackController *pos = new VectorFeedbackController{
+		new PID{ p.X, p.Y, p.Z },
+		new PID{ a.X, a.Y, a.Z },
+		new PID{ p.X, p.Y, p.Z }
+	};
+
+	VectorFeedbackController *rot = new VectorFeedbackController{
+		new PID{ r.X, r.Y, r.Z },
+		new PID{ r.X, r.Y, r.Z },
+		new PID{ r.X, r.Y, r.Z }
+	};
+
+	Quadcopter quad(true, sample.ArmLength, sample.ArmAngle, dT, pos, rot, false);
+	Vector3D targetPosition = Vector3D(0, 0, 0);
+	Rotation targetRotation = Rotation(Quaternion(1, 0, 0, 0));
+
+	quad.SetFeedbackEnabled(true);
+	quad.SetCurrent(sample.InitialPosition, Rotation(EulerAngles(sample.InitialRotation, EulerConstants::EulerOrderXYZS)));
+
+	Outcome outcome = Outcome{ 0.0, 0.0, 0.0, false };
+	int lastUnsettled = -1;
+
+	for (int step = 0; step < steps; step++) {
+		quad.SetTarget(targetPosition, targetRotation);
+		quad.SimulateCurrent(sample.ExternalAcceleration);
+		quad.CalculateCombinedThrustVector();
+
+		double attitudeError = AttitudeError(quad.CurrentRotation.GetQuaternion(), targetRotation.GetQuaternion());
+		double positionError = quad.CurrentPosition.CalculateEuclideanDistance(targetPosition);
+
+		if (Mathematics::IsNaN(attitudeError) || Mathematics::IsNaN(positionError) || positionError > divergenceDistance) {
+			outcome.Diverged = true;
+			outcome.MaxAttitudeError = Mathematics::IsNaN(attitudeError) ? 180.0 : std::max(outcome.MaxAttitudeError, attitudeError);
+			outcome.FinalPositionError = positionError;
+			outcome.SettlingTime = -1.0;
+
+			return outcome;
+		}
+
+		outcome.MaxAttitudeError = std::max(outcome.MaxAttitudeError, attitudeError);
+		outcome.FinalPositionError = positionError;
+
+		if (attitudeError > settlingBand) {
+			lastUnsettled = step;
+		}
+	}
+
+	outcome.SettlingTime = lastUnsettled == steps - 1 ? -1.0 : (lastUnsettled + 1) * dT;
+
+	return outcome;
+}
+
+MonteCarloCampaign::Outcome MonteCarloCampaign::RunSingle(int run) {
+	return Simulate(Draw(run));
+}
+
+MonteCarloCampaign::Summary MonteCarloCampaign::Run() {
+	return Run((int)std::thread::hardware_concurrency());
+}
+
+MonteCarloCampaign::Summary MonteCarloCampaign::Run(int threads) {
+	WorkStealingPool pool = WorkStealingPool(threads);
+
+	outcomes.assign(runs, Outcome{ 0.0, 0.0, 0.0, false });
+
+	auto start = std::chrono::steady_clock::now();
+
+	pool.Run(runs, [this](int run) {
+		outcomes[run] = RunSingle(run);
+	});
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return Aggregate(elapsed);
+}
+
+MonteCarloCampaign::Summary MonteCarloCampaign::Aggregate(double elapsedSeconds) {
+	Summary summary = Summary{ runs, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, elapsedSeconds, 0.0 };
+	double attitudeSum = 0.0;
+	double settlingSum = 0.0;
+
+	//Aggregated in run order so sums are identical for any thread count
+	for (int i = 0; i < runs; i++) {
+		Outcome outcome = outcomes[i];
+
+		attitudeSum += outcome.MaxAttitudeError;
+		summary.WorstAttitudeError = std::max(summary.WorstAttitudeError, outcome.MaxAttitudeError);
+
+		if (outcome.Diverged) {
+			summary.Diverged++;
+		}
+		else if (outcome.SettlingTime >= 0) {
+			summary.Settled++;
+			settlingSum += outcome.SettlingTime;
+			summary.WorstSettlingTime = std::max(summary.WorstSettlingTime, outcome.SettlingTime);
+		}
+	}
+
+	if (runs > 0) {
+		summary.DivergenceRate = (double)summary.Diverged / runs;
+		summary.MeanMaxAttitudeError = attitudeSum / runs;
+	}
+
+	if (summary.Settled > 0) {
+		summary.MeanSettlingTime = settlingSum / summary.Settled;
+	}
+
+	if (elapsedSeconds > 0) {
+		summary.RunsPerSecond = runs / elapsedSeconds;
+	}
+
+	return summary;
+}
+
+std::vector<MonteCarloCampaign::Outcome> MonteCarloCampaign::GetOutcomes() {
+	return outcomes;
+}
+
+double MonteCarloCampaign::AttitudeError(Quaternion current, Quaternion target) {
+	double dot = std::abs(current.DotProduct(target)) / (current.Magnitude() * target.Magnitude());
+
+	return Mathematics::RadiansToDegrees(2.0 * acos(Mathematics::Constrain(dot, -1, 1)));
+}
+
+std::string MonteCarloCampaign::Summary::ToString() {
+	return "Runs: " + std::to_string(Runs) +
+		" Diverged: " + std::to_string(Diverged) + " (" + Mathematics::DoubleToCleanString(DivergenceRate * 100.0) + "%)" +
+		" Settled: " + std::to_string(Settled) +
+		"\nMax attitude error mean:" + Mathematics::DoubleToCleanString(MeanMaxAttitudeError) +
+		" worst:" + Mathematics::DoubleToCleanString(WorstAttitudeError) +
+		"\nSettling time mean:" + Mathematics::DoubleToCleanString(MeanSettlingTime) +
+		" worst:" + Mathematics::DoubleToCleanString(WorstSettlingTime) +
+		"\nElapsed:" + Mathematics::DoubleToCleanString(ElapsedSeconds) +
+		" Runs/s:" + Mathematics::DoubleToCleanString(RunsPerSecond);
+}
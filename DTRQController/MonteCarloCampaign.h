@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "Mathematics.h"
+#include "PID.h"
+#include "Quadcopter.h"
+#include "Rotation.h"
+#include "Vector.h"
+#include "VectorFeedbackController.h"
+#include "WorkStealingPool.h"
+
+//Closed loop disturbance campaign, every run draws its parameters from a seed derived from the campaign seed
+//and the run index so results do not depend on the number of threads or the order runs complete in
+class MonteCarloCampaign {
+public:
+	typedef struct Range {
+		double Minimum;
+		double Maximum;
+
+		Range() {
+			Minimum = 0.0;
+			Maximum = 0.0;
+		}
+
+		Range(double value) {
+			Minimum = value;
+			Maximum = value;
+		}
+
+		Range(double minimum, double maximum) {
+			Minimum = minimum;
+			Maximum = maximum;
+		}
+	} Range;
+
+	typedef struct VectorRange {
+		Range X;
+		Range Y;
+		Range Z;
+	} VectorRange;
+
+	typedef struct GainRange {
+		Range Kp;
+		Range Ki;
+		Range Kd;
+	} GainRange;
+
+	typedef struct Distribution {
+		VectorRange ExternalAcceleration;
+		VectorRange InitialPosition;
+		VectorRange InitialRotation;//XYZ static Euler angles in degrees
+		Range ArmLength;
+		Range ArmAngle;
+		GainRange PositionGains;//X and Z position controllers
+		GainRange AltitudeGains;//Y position controller
+		GainRange RotationGains;
+
+		Distribution();
+	} Distribution;
+
+	typedef struct Sample {
+		Vector3D ExternalAcceleration;
+		Vector3D InitialPosition;
+		Vector3D InitialRotation;
+		double ArmLength;
+		double ArmAngle;
+		Vector3D PositionGains;//Kp, Ki, Kd
+		Vector3D AltitudeGains;
+		Vector3D RotationGains;
+	} Sample;
+
+	typedef struct Outcome {
+		double MaxAttitudeError;//degrees
+		double FinalPositionError;
+		double SettlingTime;//seconds, negative when the attitude did not settle
+		bool Diverged;
+	} Outcome;
+
+	typedef struct Summary {
+		int Runs;
+		int Diverged;
+		int Settled;
+		double DivergenceRate;
+		double MeanMaxAttitudeError;
+		double WorstAttitudeError;
+		double MeanSettlingTime;
+		double WorstSettlingTime;
+		double ElapsedSeconds;
+		double RunsPerSecond;
+
+		std::string ToString();
+	} Summary;
+
+	MonteCarloCampaign(Distribution distribution, int runs, int steps, double dT, unsigned long long seed);
+
+	void SetSettlingBand(double degrees);
+	void SetDivergenceDistance(double distance);
+
+	Sample Draw(int run);
+	Outcome Simulate(Sample sample);
+	Outcome RunSingle(int run);
+	Summary Run();
+	Summary Run(int threads);
+	std::vector<Outcome> GetOutcomes();
+
+	static double AttitudeError(Quaternion current, Quaternion target);
+
+private:
+	Distribution distribution;
+	int runs;
+	int steps;
+	double dT;
+	unsigned long long seed;
+	double settlingBand;
+	double divergenceDistance;
+	std::vector<Outcome> outcomes;
+
+	static double Uniform(std::mt19937_64 &generator, Range range);
+	static Vector3D Uniform(std::mt19937_64 &generator, VectorRange range);
+	static Vector3D Uniform(std::mt19937_64 &generator, GainRange range);
+	Summary Aggregate(double elapsedSeconds);
+};
@@ -31,3 +31,25 @@ double PID::Calculate(double setpoint, double processVariable, double dT) {
 
 	return output;
 }
+
+FeedbackController* PID::Clone() const {
+	return new PID(*this);
+}
+
+int PID::GetStateSize() {
+	return StateSize;
+}
+
+void PID::SaveState(double *state) {
+	state[0] = integral;
+	state[1] = error;
+	state[2] = previousError;
+	state[3] = output;
+}
+
+void PID::LoadState(const double *state) {
+	integral = state[0];
+	error = state[1];
+	previousError = state[2];
+	output = state[3];
+}
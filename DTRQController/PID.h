@@ -18,4 +18,11 @@ public:
 	~PID();
 	PID(double kp, double ki, double kd);
 	double Calculate(double setpoint, double processVariable, double dT);
+
+	static const int StateSize = 4;
+
+	FeedbackController* Clone() const;
+	int GetStateSize();
+	void SaveState(double *state);
+	void LoadState(const double *state);
 };
@@ -0,0 +1,109 @@
+#include "PowerSpectralDensity.h"
+#include "Mathematics.h"
+
+PowerSpectralDensity::PowerSpectralDensity() {
+	this->segmentLength = 0;
+	this->overlap = 0;
+	this->samplingFrequency = 0.0;
+	this->scale = 0.0;
+}
+
+PowerSpectralDensity::PowerSpectralDensity(int segmentLength, int overlap, double samplingFrequency) {
+	this->segmentLength = 0;
+	this->overlap = 0;
+	this->samplingFrequency = 0.0;
+	this->scale = 0.0;
+
+	if (overlap < 0 || overlap >= segmentLength || samplingFrequency <= 0.0) {
+		std::cout << "PSD overlap " << overlap << " must be below the segment length " << segmentLength << " at a positive sampling frequency." << std::endl;
+		return;
+	}
+
+	this->plan = RealFFTPlan(segmentLength);
+
+	if (!plan.IsValid()) return;
+
+	this->segmentLength = segmentLength;
+	this->overlap = overlap;
+	this->samplingFrequency = samplingFrequency;
+
+	window.resize(segmentLength);
+	segment.resize(segmentLength);
+	spectrum.resize(plan.GetBins());
+
+	//Periodic Hann window, the segments it tiles at half overlap sum to a constant
+	double power = 0.0;
+
+	for (int i = 0; i < segmentLength; i++) {
+		window[i] = 0.5 - 0.5 * cos(2.0 * Mathematics::PI * i / segmentLength);
+		power += window[i] * window[i];
+	}
+
+	scale = 1.0 / (samplingFrequency * power);
+}
+
+bool PowerSpectralDensity::Estimate(const double *samples, int count, double *density) {
+	if (segmentLength == 0) return false;
+
+	int segments = GetSegments(count);
+
+	if (segments == 0) {
+		std::cout << "PSD needs at least " << segmentLength << " samples, got " << count << "." << std::endl;
+		return false;
+	}
+
+	int bins = plan.GetBins();
+	int step = segmentLength - overlap;
+
+	for (int k = 0; k < bins; k++) {
+		density[k] = 0.0;
+	}
+
+	for (int s = 0; s < segments; s++) {
+		const double *start = samples + s * step;
+		double mean = 0.0;
+
+		for (int i = 0; i < segmentLength; i++) {
+			mean += start[i];
+		}
+
+		mean /= segmentLength;
+
+		for (int i = 0; i < segmentLength; i++) {
+			segment[i] = (start[i] - mean) * window[i];
+		}
+
+		plan.Forward(segment.data(), spectrum.data());
+
+		for (int k = 0; k < bins; k++) {
+			density[k] += spectrum[k].real() * spectrum[k].real() + spectrum[k].imag() * spectrum[k].imag();
+		}
+	}
+
+	//Bins other than DC and Nyquist also carry the power of their negative frequency mirror
+	for (int k = 0; k < bins; k++) {
+		double factor = k == 0 || k == bins - 1 ? 1.0 : 2.0;
+
+		density[k] *= factor * scale / segments;
+	}
+
+	return true;
+}
+
+double PowerSpectralDensity::GetFrequency(int bin) {
+	return segmentLength > 0 ? bin * samplingFrequency / segmentLength : 0.0;
+}
+
+int PowerSpectralDensity::GetBins() {
+	return plan.GetBins();
+}
+
+int PowerSpectralDensity::GetSegments(int count) {
+	if (segmentLength == 0 || count < segmentLength) return 0;
+
+	return (count - segmentLength) / (segmentLength - overlap) + 1;
+}
+
+bool PowerSpectralDensity::IsValid() {
+	return segmentLength > 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "RealFFTPlan.h"
+
+//Welch averaged power spectral density of a real stream. Segments of segmentLength samples start every
+//segmentLength - overlap samples, each has its mean removed and a Hann window applied before the real FFT, and the
+//squared bins are averaged. Densities are one sided in units squared per hertz, so summing them times the bin
+//width gives the variance of the stream
+class PowerSpectralDensity {
+private:
+	int segmentLength;
+	int overlap;
+	double samplingFrequency;
+	double scale;//one over fs times the window power
+	RealFFTPlan plan;
+	std::vector<double> window;
+	std::vector<double> segment;
+	std::vector<std::complex<double>> spectrum;
+
+public:
+	PowerSpectralDensity();
+	PowerSpectralDensity(int segmentLength, int overlap, double samplingFrequency);
+
+	//Writes GetBins densities, false when count holds less than one segment
+	bool Estimate(const double *samples, int count, double *density);
+
+	double GetFrequency(int bin);
+	int GetBins();
+	int GetSegments(int count);
+	bool IsValid();
+
+};
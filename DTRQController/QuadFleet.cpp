@@ -0,0 +1,248 @@
+#include "QuadFleet.h"
+
+QuadFleet::QuadFleet(int count, double armLength, double armAngle) {
+	this->count = count;
+
+	positionX.assign(count, 0.0); positionY.assign(count, 0.0); positionZ.assign(count, 0.0);
+	velocityX.assign(count, 0.0); velocityY.assign(count, 0.0); velocityZ.assign(count, 0.0);
+	rotationW.assign(count, 1.0); rotationX.assign(count, 0.0); rotationY.assign(count, 0.0); rotationZ.assign(count, 0.0);
+	angularVelocityX.assign(count, 0.0); angularVelocityY.assign(count, 0.0); angularVelocityZ.assign(count, 0.0);
+	externalX.assign(count, 0.0); externalY.assign(count, -9.81); externalZ.assign(count, 0.0);
+	this->armLength.assign(count, 0.0);
+	this->armAngle.assign(count, 0.0);
+	allocation.assign(count, ControlAllocation(armLength, armAngle));
+
+	actuators = ActuatorBank(Channels, count, 0.0);
+
+	//Same spring constants as the simulated Thruster joints and rotor
+	for (int thruster = 0; thruster < 4; thruster++) {
+		actuators.SetSpringConstant(thruster * 3 + 0, 75);
+		actuators.SetSpringConstant(thruster * 3 + 1, 75);
+		actuators.SetSpringConstant(thruster * 3 + 2, 250);
+	}
+
+	for (int i = 0; i < count; i++) {
+		SetGeometry(i, armLength, armAngle);
+	}
+
+	ResetThroughput();
+}
+
+void QuadFleet::SetGeometry(int vehicle, double armLength, double armAngle) {
+	this->armLength[vehicle] = armLength;
+	this->armAngle[vehicle] = armAngle;
+
+	allocation[vehicle].SetGeometry(armLength, armAngle);
+}
+
+void QuadFleet::SetState(int vehicle, Vector3D position, Quaternion rotation) {
+	positionX[vehicle] = position.X;
+	positionY[vehicle] = position.Y;
+	positionZ[vehicle] = position.Z;
+
+	rotationW[vehicle] = rotation.W;
+	rotationX[vehicle] = rotation.X;
+	rotationY[vehicle] = rotation.Y;
+	rotationZ[vehicle] = rotation.Z;
+}
+
+void QuadFleet::SetExternalAcceleration(Vector3D externalAcceleration) {
+	for (int i = 0; i < count; i++) {
+		SetExternalAcceleration(i, externalAcceleration);
+	}
+}
+
+void QuadFleet::SetExternalAcceleration(int vehicle, Vector3D externalAcceleration) {
+	externalX[vehicle] = externalAcceleration.X;
+	externalY[vehicle] = externalAcceleration.Y;
+	externalZ[vehicle] = externalAcceleration.Z;
+}
+
+void QuadFleet::SetThrusterOutputs(int vehicle, ThrusterIndex thruster, Vector3D output) {
+	//Same mapping as Thruster::SetThrusterOutputs, X drives the inner joint and Z the outer joint
+	actuators.SetTarget(thruster * 3 + 0, vehicle, output.Z);
+	actuators.SetTarget(thruster * 3 + 1, vehicle, output.X);
+	actuators.SetTarget(thruster * 3 + 2, vehicle, output.Y);
+}
+
+void QuadFleet::Step(double dT) {
+	auto start = std::chrono::steady_clock::now();
+
+	StepBody(dT);
+	StepActuators(dT);
+
+	steppedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	steppedVehicles += count;
+}
+
+void QuadFleet::StepBody(double dT) {
+	const double degreesToRadians = Mathematics::PI / 180.0;
+	const double drag = 0.5 * 1.225 * 1.0 * 0.184061;
+
+	const double *actuatorPosition = actuators.GetPositions();
+	const double *outerB = &actuatorPosition[0 * count], *innerB = &actuatorPosition[1 * count], *rotorB = &actuatorPosition[2 * count];
+	const double *outerC = &actuatorPosition[3 * count], *innerC = &actuatorPosition[4 * count], *rotorC = &actuatorPosition[5 * count];
+	const double *outerD = &actuatorPosition[6 * count], *innerD = &actuatorPosition[7 * count], *rotorD = &actuatorPosition[8 * count];
+	const double *outerE = &actuatorPosition[9 * count], *innerE = &actuatorPosition[10 * count], *rotorE = &actuatorPosition[11 * count];
+
+	for (int i = 0; i < count; i++) {
+		double qw = rotationW[i], qx = rotationX[i], qy = rotationY[i], qz = rotationZ[i];
+
+		//q v q^-1 without forming the inverse, valid for any non-zero quaternion
+		double n = qw * qw + qx * qx + qy * qy + qz * qz;
+		double a = (qw * qw - qx * qx - qy * qy - qz * qz) / n;
+		double b = 2.0 / n;
+
+		auto rotate = [&](double &vx, double &vy, double &vz) {
+			double d = (qx * vx + qy * vy + qz * vz) * b;
+			double cx = (qy * vz - qz * vy) * b * qw;
+			double cy = (qz * vx - qx * vz) * b * qw;
+			double cz = (qx * vy - qy * vx) * b * qw;
+
+			vx = a * vx + d * qx + cx;
+			vy = a * vy + d * qy + cy;
+			vz = a * vz + d * qz + cz;
+		};
+
+		//Position, Quadcopter::EstimatePosition sums the thrust of TB four times
+		double hx = outerB[i] * degreesToRadians * 0.5;
+		double hz = -innerB[i] * degreesToRadians * 0.5;
+		double sx, cx, sz, cz;
+
+		Trigonometry::SinCos(hx, sx, cx);
+		Trigonometry::SinCos(hz, sz, cz);
+
+		double tw = cx * cz, tx = sx * cz, ty = -(sx * sz), tz = cx * sz;
+		double thrust = rotorB[i] * 4.0;
+
+		double fx = 2.0 * (tx * ty - tw * tz) * thrust;
+		double fy = (1.0 - 2.0 * (tx * tx + tz * tz)) * thrust;
+		double fz = 2.0 * (ty * tz + tw * tx) * thrust;
+
+		rotate(fx, fy, fz);
+
+		double vx = velocityX[i], vy = velocityY[i], vz = velocityZ[i];
+
+		double dragX = drag * vx * std::abs(vx);
+		double dragY = drag * vy * std::abs(vy);
+		double dragZ = drag * vz * std::abs(vz);
+
+		vx = vx + (fx + externalX[i]) * dT - dragX * dT;
+		vy = vy + (fy + externalY[i]) * dT - dragY * dT;
+		vz = vz + (fz + externalZ[i]) * dT - dragZ * dT;
+
+		velocityX[i] = vx; velocityY[i] = vy; velocityZ[i] = vz;
+		positionX[i] += vx * dT;
+		positionY[i] += vy * dT;
+		positionZ[i] += vz * dT;
+
+		//Rotation, thrust vectors match Thruster::ReturnThrustVector
+		Vector3D thrustVector[ControlAllocation::Thrusters];
+		const double outer[4] = { outerB[i], outerC[i], outerD[i], outerE[i] };
+		const double inner[4] = { innerB[i], innerC[i], innerD[i], innerE[i] };
+		const double rotor[4] = { rotorB[i], rotorC[i], rotorD[i], rotorE[i] };
+
+		for (int t = 0; t < 4; t++) {
+			double o = outer[t] * degreesToRadians;
+			double r = inner[t] * degreesToRadians;
+			double so, co, sr, cr;
+
+			Trigonometry::SinCos(o, so, co);
+			Trigonometry::SinCos(r, sr, cr);
+
+			co = co * rotor[t];
+
+			double tx = sr * co, ty = cr * co, tz = so * rotor[t];
+
+			rotate(tx, ty, tz);
+
+			thrustVector[t] = Vector3D(tx, ty, tz);
+		}
+
+		Vector3D angularAcceleration = allocation[i].CalculateAngularAcceleration(thrustVector);
+
+		double wx = angularVelocityX[i], wy = angularVelocityY[i], wz = angularVelocityZ[i];
+
+		dragX = drag * wx * std::abs(wx);
+		dragY = drag * wy * std::abs(wy);
+		dragZ = drag * wz * std::abs(wz);
+
+		wx = wx + angularAcceleration.X * dT - dragX * dT;
+		wy = wy + angularAcceleration.Y * dT - dragY * dT;
+		wz = wz + angularAcceleration.Z * dT - dragZ * dT;
+
+		angularVelocityX[i] = wx; angularVelocityY[i] = wy; angularVelocityZ[i] = wz;
+
+		//q + (w * 0.5 * dT) * q, scaled back to unit length as in Quadcopter::EstimateRotation
+		double px = wx * 0.5 * dT, py = wy * 0.5 * dT, pz = wz * 0.5 * dT;
+
+		double nw = qw - px * qx - py * qy - pz * qz;
+		double nx = qx + px * qw + py * qz - pz * qy;
+		double ny = qy - px * qz + py * qw + pz * qx;
+		double nz = qz + px * qy - py * qx + pz * qw;
+		double magnitude = sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+
+		rotationW[i] = nw / magnitude;
+		rotationX[i] = nx / magnitude;
+		rotationY[i] = ny / magnitude;
+		rotationZ[i] = nz / magnitude;
+	}
+}
+
+void QuadFleet::StepActuators(double dT) {
+	//Coefficients are only recalculated when dT changes, then all 12 * count springs go in one pass
+	actuators.SetTimeStep(dT);
+	actuators.Step();
+}
+
+int QuadFleet::GetCount() {
+	return count;
+}
+
+Vector3D QuadFleet::GetPosition(int vehicle) {
+	return Vector3D(positionX[vehicle], positionY[vehicle], positionZ[vehicle]);
+}
+
+Vector3D QuadFleet::GetVelocity(int vehicle) {
+	return Vector3D(velocityX[vehicle], velocityY[vehicle], velocityZ[vehicle]);
+}
+
+Vector3D QuadFleet::GetAngularVelocity(int vehicle) {
+	return Vector3D(angularVelocityX[vehicle], angularVelocityY[vehicle], angularVelocityZ[vehicle]);
+}
+
+Quaternion QuadFleet::GetRotation(int vehicle) {
+	return Quaternion(rotationW[vehicle], rotationX[vehicle], rotationY[vehicle], rotationZ[vehicle]);
+}
+
+Vector3D QuadFleet::GetThrusterOutput(int vehicle, ThrusterIndex thruster) {
+	//Outer joint, rotor, inner joint as in Thruster::ReturnThrusterOutput
+	return Vector3D(
+		actuators.GetPosition(thruster * 3 + 0, vehicle),
+		actuators.GetPosition(thruster * 3 + 2, vehicle),
+		actuators.GetPosition(thruster * 3 + 1, vehicle)
+	);
+}
+
+Vector3D QuadFleet::GetThrusterPosition(int vehicle, ThrusterIndex thruster) {
+	double XLength = armLength[vehicle] * cos(Mathematics::DegreesToRadians(armAngle[vehicle]));
+	double ZLength = armLength[vehicle] * sin(Mathematics::DegreesToRadians(armAngle[vehicle]));
+
+	Vector3D offsets[4] = {
+		Vector3D(-XLength, 0,  ZLength),
+		Vector3D( XLength, 0,  ZLength),
+		Vector3D( XLength, 0, -ZLength),
+		Vector3D(-XLength, 0, -ZLength)
+	};
+
+	return GetRotation(vehicle).RotateAdd(offsets[thruster], GetPosition(vehicle));
+}
+
+double QuadFleet::GetVehiclesSteppedPerSecond() {
+	return steppedSeconds > 0 ? steppedVehicles / steppedSeconds : 0.0;
+}
+
+void QuadFleet::ResetThroughput() {
+	steppedVehicles = 0;
+	steppedSeconds = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include "ActuatorBank.h"
+#include "ControlAllocation.h"
+#include "Mathematics.h"
+#include "Quaternion.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+
+//Steps many simulated quadcopters at once, vehicle state is held in structure-of-arrays form.
+//Each vehicle follows the same model as Quadcopter::SimulateCurrent followed by Thruster::SetThrusterOutputs.
+class QuadFleet {
+public:
+	enum ThrusterIndex {
+		TB,
+		TC,
+		TD,
+		TE
+	};
+
+	QuadFleet(int count, double armLength, double armAngle);
+
+	void SetGeometry(int vehicle, double armLength, double armAngle);
+	void SetState(int vehicle, Vector3D position, Quaternion rotation);
+	void SetExternalAcceleration(Vector3D externalAcceleration);
+	void SetExternalAcceleration(int vehicle, Vector3D externalAcceleration);
+	void SetThrusterOutputs(int vehicle, ThrusterIndex thruster, Vector3D output);
+	void Step(double dT);
+
+	int GetCount();
+	Vector3D GetPosition(int vehicle);
+	Vector3D GetVelocity(int vehicle);
+	Vector3D GetAngularVelocity(int vehicle);
+	Quaternion GetRotation(int vehicle);
+	Vector3D GetThrusterOutput(int vehicle, ThrusterIndex thruster);
+	Vector3D GetThrusterPosition(int vehicle, ThrusterIndex thruster);
+
+	double GetVehiclesSteppedPerSecond();
+	void ResetThroughput();
+
+private:
+	//Actuator channels per vehicle, ordered outer joint, inner joint, rotor for TB, TC, TD, TE
+	static const int Channels = 12;
+
+	int count;
+
+	std::vector<double> positionX, positionY, positionZ;
+	std::vector<double> velocityX, velocityY, velocityZ;
+	std::vector<double> rotationW, rotationX, rotationY, rotationZ;
+	std::vector<double> angularVelocityX, angularVelocityY, angularVelocityZ;
+	std::vector<double> externalX, externalY, externalZ;
+	std::vector<double> armLength, armAngle;
+
+	//Per vehicle geometry, its effectiveness matrix maps the thrust vectors to angular acceleration as in Quadcopter
+	std::vector<ControlAllocation> allocation;
+
+	//Indexed [channel * count + vehicle] so every channel is contiguous across the fleet
+	ActuatorBank actuators;
+
+	double steppedVehicles;
+	double steppedSeconds;
+
+	void StepBody(double dT);
+	void StepActuators(double dT);
+};
@@ -1,12 +1,20 @@
 #include "Quadcopter.h"
 
-Quadcopter::Quadcopter(bool simulation, double armLength, double armAngle, double dT, VectorFeedbackController *pos, VectorFeedbackController *rot) {
-	std::cout << "DTRQ Controller Initializing." << std::endl;
+Quadcopter::Quadcopter(bool simulation, double armLength, double armAngle, double dT, VectorFeedbackController *pos, VectorFeedbackController *rot) :
+	Quadcopter(simulation, armLength, armAngle, dT, pos, rot, true) {}
+
+Quadcopter::Quadcopter(bool simulation, double armLength, double armAngle, double dT, VectorFeedbackController *pos, VectorFeedbackController *rot, bool verbose) {
+	if (verbose) std::cout << "DTRQ Controller Initializing." << std::endl;
 
 	this->simulation = simulation;
+	this->verbose = verbose;
 	this->armLength = armLength;
 	this->armAngle = armAngle;
 	this->dT = dT;
+	this->physicsSubsteps = 1;
+	this->physicsDT = dT;
+	this->feedbackEnabled = false;
+	this->integrator = SemiImplicitEuler;
 	this->gimbalLockFader = TriangleWaveFader(8, 90);
 
 	this->externalAcceleration = Vector3D(0, -9.81, 0);
@@ -23,11 +31,11 @@ Quadcopter::Quadcopter(bool simulation, double armLength, double armAngle, doubl
 	this->positionController = pos;
 	this->rotationController = rot;
 
-	std::cout << "Calculating Quadcopter Arm Positions." << std::endl;
+	if (verbose) std::cout << "Calculating Quadcopter Arm Positions." << std::endl;
 
 	CalculateArmPositions(armLength, armAngle);
 
-	std::cout << "DTRQ Initialized, ready for commands." << std::endl;
+	if (verbose) std::cout << "DTRQ Initialized, ready for commands." << std::endl;
 }
 
 Quadcopter::~Quadcopter() {
@@ -44,14 +52,20 @@ void Quadcopter::CalculateArmPositions(double armLength, double armAngle) {
 	double XLength = armLength * cos(Mathematics::DegreesToRadians(armAngle));
 	double ZLength = armLength * sin(Mathematics::DegreesToRadians(armAngle));
 
-	std::cout << "Quadcopter Thruster Offset: X:" + Mathematics::DoubleToCleanString(XLength) +
-		" Z:" + Mathematics::DoubleToCleanString(ZLength) +
-		" dT:" + Mathematics::DoubleToCleanString(dT) << std::endl;
+	if (verbose) {
+		std::cout << "Quadcopter Thruster Offset: X:" + Mathematics::DoubleToCleanString(XLength) +
+			" Z:" + Mathematics::DoubleToCleanString(ZLength) +
+			" dT:" + Mathematics::DoubleToCleanString(dT) << std::endl;
+	}
+
+	actuators = ActuatorBank(ActuatorChannels, 1, dT);
 
-	TB = new Thruster(Vector3D(-XLength, 0, ZLength),  "TB", simulation, dT);
-	TC = new Thruster(Vector3D( XLength, 0, ZLength),  "TC", simulation, dT);
-	TD = new Thruster(Vector3D( XLength, 0, -ZLength), "TD", simulation, dT);
-	TE = new Thruster(Vector3D(-XLength, 0, -ZLength), "TE", simulation, dT);
+	TB = new Thruster(Vector3D(-XLength, 0, ZLength),  "TB", simulation, &actuators, 0 * Thruster::ActuatorChannels, verbose);
+	TC = new Thruster(Vector3D( XLength, 0, ZLength),  "TC", simulation, &actuators, 1 * Thruster::ActuatorChannels, verbose);
+	TD = new Thruster(Vector3D( XLength, 0, -ZLength), "TD", simulation, &actuators, 2 * Thruster::ActuatorChannels, verbose);
+	TE = new Thruster(Vector3D(-XLength, 0, -ZLength), "TE", simulation, &actuators, 3 * Thruster::ActuatorChannels, verbose);
+
+	allocation.SetGeometry(armLength, armAngle);
 }
 
 void Quadcopter::CalculateCombinedThrustVector() {
@@ -66,18 +80,24 @@ void Quadcopter::CalculateCombinedThrustVector() {
 
 	/////////////////////////////////////////////////////////////////////////////////////////////
 	//REMOVE LATER
-	positionOutput = Vector3D(0, 0, 0);
-	rotationOutput = Vector3D(0, 0, 0);
+	if (!feedbackEnabled) {
+		positionOutput = Vector3D(0, 0, 0);
+		rotationOutput = Vector3D(0, 0, 0);
+	}
 
 	//Thruster output relative to environment origin
-	Vector3D thrusterOutputB = Vector3D(0, -rotationOutput.X + rotationOutput.Z - rotationOutput.Y, 0);
-	Vector3D thrusterOutputC = Vector3D(0, -rotationOutput.X - rotationOutput.Z + rotationOutput.Y, 0);
-	Vector3D thrusterOutputD = Vector3D(0,  rotationOutput.X - rotationOutput.Z - rotationOutput.Y, 0);
-	Vector3D thrusterOutputE = Vector3D(0,  rotationOutput.X + rotationOutput.Z + rotationOutput.Y, 0);
+	double rotorOutputs[ControlAllocation::Thrusters];
+
+	allocation.Allocate(rotationOutput, rotorOutputs);
+
+	Vector3D thrusterOutputB = Vector3D(0, rotorOutputs[0], 0);
+	Vector3D thrusterOutputC = Vector3D(0, rotorOutputs[1], 0);
+	Vector3D thrusterOutputD = Vector3D(0, rotorOutputs[2], 0);
+	Vector3D thrusterOutputE = Vector3D(0, rotorOutputs[3], 0);
 
 	Vector3D hoverAngles = RotationToHoverAngles(CurrentRotation);
 
-	positionOutput = CalculateRotationOffset().RotateVector(positionOutput);
+	positionOutput = CalculateRotationOffset().RotateUnitVector(positionOutput);
 
 	//std::cout << CurrentRotation.GetQuaternion().ToString() << " " << CurrentRotation.GetDirectionAngle().ToString() << " " << hoverAngles.ToString() << std::endl;
 
@@ -85,133 +105,389 @@ void Quadcopter::CalculateCombinedThrustVector() {
 	positionOutput.X = positionOutput.X + hoverAngles.Z;//Adjust main joint to rotation
 	positionOutput.Z = positionOutput.Z - hoverAngles.X;//Adjust secondary joint to rotation
 
-	TB->SetThrusterOutputs(thrusterOutputB.Add(positionOutput));
-	TC->SetThrusterOutputs(thrusterOutputC.Add(positionOutput));
-	TD->SetThrusterOutputs(thrusterOutputD.Add(positionOutput));
-	TE->SetThrusterOutputs(thrusterOutputE.Add(positionOutput));
+	TB->SetThrusterTargets(thrusterOutputB.Add(positionOutput));
+	TC->SetThrusterTargets(thrusterOutputC.Add(positionOutput));
+	TD->SetThrusterTargets(thrusterOutputD.Add(positionOutput));
+	TE->SetThrusterTargets(thrusterOutputE.Add(positionOutput));
+
+	StepActuators();
+}
+
+void Quadcopter::StepActuators() {
+	if (!simulation) return;
+
+	actuators.Step();
+
+	TB->ReadActuators();
+	TC->ReadActuators();
+	TD->ReadActuators();
+	TE->ReadActuators();
+}
+
+void Quadcopter::CalculateThrusterPositions(Quaternion rotation, Vector3D position, Vector3D *positions) {
+	Vector3D offsets[ControlAllocation::Thrusters] = { TB->ThrusterOffset, TC->ThrusterOffset, TD->ThrusterOffset, TE->ThrusterOffset };
+
+	Quaternion::RotateUnitVectors(rotation, offsets, positions, ControlAllocation::Thrusters);
+
+	for (int i = 0; i < ControlAllocation::Thrusters; i++) {
+		positions[i] += position;
+	}
 }
 
-void Quadcopter::SetCurrent(Vector3D position, Rotation rotation) {
+void Quadcopter::SetCurrent(Vector3D position, const Rotation &rotation) {
+	Quaternion current = rotation.GetQuaternion();
+
 	CurrentPosition = position;
-	CurrentRotation = rotation;
+	CurrentRotation.SetQuaternion(current / current.Magnitude());
+
+	Vector3D positions[ControlAllocation::Thrusters];
+
+	CalculateThrusterPositions(CurrentRotation.GetQuaternion(), CurrentPosition, positions);
 
-	TB->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TB->ThrusterOffset).Add(CurrentPosition);
-	TC->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TC->ThrusterOffset).Add(CurrentPosition);
-	TD->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TD->ThrusterOffset).Add(CurrentPosition);
-	TE->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TE->ThrusterOffset).Add(CurrentPosition);
+	TB->CurrentPosition = positions[0];
+	TC->CurrentPosition = positions[1];
+	TD->CurrentPosition = positions[2];
+	TE->CurrentPosition = positions[3];
 }
 
-void Quadcopter::SetTarget(Vector3D position, Rotation rotation) {
+void Quadcopter::SetTarget(Vector3D position, const Rotation &rotation) {
+	Quaternion target = rotation.GetQuaternion();
+
 	TargetPosition = position;
-	TargetRotation = rotation;
+	TargetRotation.SetQuaternion(target / target.Magnitude());
+
+	Vector3D positions[ControlAllocation::Thrusters];
+
+	CalculateThrusterPositions(TargetRotation.GetQuaternion(), TargetPosition, positions);
 
-	TB->TargetPosition = TargetRotation.GetQuaternion().RotateVector(TB->ThrusterOffset).Add(TargetPosition);
-	TC->TargetPosition = TargetRotation.GetQuaternion().RotateVector(TC->ThrusterOffset).Add(TargetPosition);
-	TD->TargetPosition = TargetRotation.GetQuaternion().RotateVector(TD->ThrusterOffset).Add(TargetPosition);
-	TE->TargetPosition = TargetRotation.GetQuaternion().RotateVector(TE->ThrusterOffset).Add(TargetPosition);
+	TB->TargetPosition = positions[0];
+	TC->TargetPosition = positions[1];
+	TD->TargetPosition = positions[2];
+	TE->TargetPosition = positions[3];
 }
 
 void Quadcopter::SimulateCurrent(Vector3D externalAcceleration) {
 	this->externalAcceleration = externalAcceleration;
 
-	EstimatePosition();
-	EstimateRotation();
+	//Controller outputs are held between control ticks, the actuators step with the physics except after the
+	//last substep where the next command steps them. The bank still holds the last targets
+	for (int substep = 0; substep < physicsSubsteps; substep++) {
+		if (substep > 0) {
+			StepActuators();
+		}
+
+		switch (integrator) {
+		case RungeKutta4:
+			IntegrateRungeKutta4();
+			break;
+		case ExponentialMap:
+			IntegrateExponentialMap();
+			break;
+		default: {
+			BodyThrust thrust = CalculateBodyThrust();
+
+			EstimatePosition(thrust);
+			EstimateRotation(thrust);
+			break;
+		}
+		}
+	}
 
 	//CurrentPosition = TargetPosition;
 	//CurrentRotation = TargetRotation;
 
-	TB->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TB->ThrusterOffset).Add(CurrentPosition);
-	TC->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TC->ThrusterOffset).Add(CurrentPosition);
-	TD->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TD->ThrusterOffset).Add(CurrentPosition);
-	TE->CurrentPosition = CurrentRotation.GetQuaternion().RotateVector(TE->ThrusterOffset).Add(CurrentPosition);
+	Vector3D positions[ControlAllocation::Thrusters];
+
+	CalculateThrusterPositions(CurrentRotation.GetQuaternion(), CurrentPosition, positions);
+
+	TB->CurrentPosition = positions[0];
+	TC->CurrentPosition = positions[1];
+	TD->CurrentPosition = positions[2];
+	TE->CurrentPosition = positions[3];
+}
+
+void Quadcopter::SetFeedbackEnabled(bool enabled) {
+	feedbackEnabled = enabled;
+}
+
+void Quadcopter::SetIntegrator(Integrator integrator) {
+	this->integrator = integrator;
+}
+
+Quadcopter::Integrator Quadcopter::GetIntegrator() {
+	return integrator;
+}
+
+void Quadcopter::SetPhysicsSubsteps(int substeps) {
+	if (substeps < 1) {
+		std::cout << "Physics substeps must be at least 1, got " << substeps << "." << std::endl;
+		return;
+	}
+
+	physicsSubsteps = substeps;
+	physicsDT = dT / substeps;
+
+	actuators.SetTimeStep(physicsDT);
+}
+
+int Quadcopter::GetPhysicsSubsteps() {
+	return physicsSubsteps;
+}
+
+void Quadcopter::SaveVector(Vector3D vector, double *values) {
+	values[0] = vector.X;
+	values[1] = vector.Y;
+	values[2] = vector.Z;
+}
+
+Vector3D Quadcopter::LoadVector(const double *values) {
+	return Vector3D(values[0], values[1], values[2]);
+}
+
+bool Quadcopter::SaveSnapshot(Snapshot &snapshot) {
+	if (positionController->GetStateSize() > Snapshot::ControllerCapacity || rotationController->GetStateSize() > Snapshot::ControllerCapacity) {
+		std::cout << "Controller state does not fit in a snapshot of " << Snapshot::ControllerCapacity << " values." << std::endl;
+		return false;
+	}
+
+	Quaternion current = CurrentRotation.GetQuaternion();
+	Quaternion target = TargetRotation.GetQuaternion();
+
+	SaveVector(CurrentPosition, snapshot.Position);
+	SaveVector(currentVelocity, snapshot.Velocity);
+	SaveVector(currentAcceleration, snapshot.Acceleration);
+	SaveVector(currentAngularVelocity, snapshot.AngularVelocity);
+	SaveVector(currentAngularAcceleration, snapshot.AngularAcceleration);
+	SaveVector(TargetPosition, snapshot.TargetPosition);
+	SaveVector(externalAcceleration, snapshot.ExternalAcceleration);
+
+	snapshot.Rotation[0] = current.W; snapshot.Rotation[1] = current.X; snapshot.Rotation[2] = current.Y; snapshot.Rotation[3] = current.Z;
+	snapshot.TargetRotation[0] = target.W; snapshot.TargetRotation[1] = target.X; snapshot.TargetRotation[2] = target.Y; snapshot.TargetRotation[3] = target.Z;
+
+	TB->SaveState(snapshot.Thrusters[0]);
+	TC->SaveState(snapshot.Thrusters[1]);
+	TD->SaveState(snapshot.Thrusters[2]);
+	TE->SaveState(snapshot.Thrusters[3]);
+
+	positionController->SaveState(snapshot.PositionController);
+	rotationController->SaveState(snapshot.RotationController);
+
+	return true;
+}
+
+bool Quadcopter::RestoreSnapshot(const Snapshot &snapshot) {
+	if (positionController->GetStateSize() > Snapshot::ControllerCapacity || rotationController->GetStateSize() > Snapshot::ControllerCapacity) {
+		std::cout << "Controller state does not fit in a snapshot of " << Snapshot::ControllerCapacity << " values." << std::endl;
+		return false;
+	}
+
+	CurrentPosition = LoadVector(snapshot.Position);
+	currentVelocity = LoadVector(snapshot.Velocity);
+	currentAcceleration = LoadVector(snapshot.Acceleration);
+	currentAngularVelocity = LoadVector(snapshot.AngularVelocity);
+	currentAngularAcceleration = LoadVector(snapshot.AngularAcceleration);
+	TargetPosition = LoadVector(snapshot.TargetPosition);
+	externalAcceleration = LoadVector(snapshot.ExternalAcceleration);
+
+	CurrentRotation.SetQuaternion(Quaternion(snapshot.Rotation[0], snapshot.Rotation[1], snapshot.Rotation[2], snapshot.Rotation[3]));
+	TargetRotation.SetQuaternion(Quaternion(snapshot.TargetRotation[0], snapshot.TargetRotation[1], snapshot.TargetRotation[2], snapshot.TargetRotation[3]));
+
+	TB->LoadState(snapshot.Thrusters[0]);
+	TC->LoadState(snapshot.Thrusters[1]);
+	TD->LoadState(snapshot.Thrusters[2]);
+	TE->LoadState(snapshot.Thrusters[3]);
+
+	positionController->LoadState(snapshot.PositionController);
+	rotationController->LoadState(snapshot.RotationController);
+
+	return true;
+}
+
+//Same configuration with deep copies of the controllers, then the current state
+std::unique_ptr<Quadcopter> Quadcopter::Clone() {
+	Snapshot snapshot;
+
+	if (!SaveSnapshot(snapshot)) return nullptr;
+
+	std::vector<std::unique_ptr<Quadcopter>> branches = Fork(snapshot, 1);
+
+	return std::move(branches[0]);
+}
+
+std::vector<std::unique_ptr<Quadcopter>> Quadcopter::Fork(const Snapshot &snapshot, int branches) {
+	std::vector<std::unique_ptr<Quadcopter>> forks;
+
+	for (int i = 0; i < branches; i++) {
+		VectorFeedbackController *pos = new VectorFeedbackController(*positionController);
+		VectorFeedbackController *rot = new VectorFeedbackController(*rotationController);
+		std::unique_ptr<Quadcopter> fork = std::unique_ptr<Quadcopter>(new Quadcopter(simulation, armLength, armAngle, dT, pos, rot, verbose));
+
+		fork->SetIntegrator(integrator);
+		fork->SetFeedbackEnabled(feedbackEnabled);
+
+		if (physicsSubsteps != 1) fork->SetPhysicsSubsteps(physicsSubsteps);
+
+		fork->RestoreSnapshot(snapshot);
+
+		forks.push_back(std::move(fork));
+	}
+
+	return forks;
 }
 
-void Quadcopter::EstimatePosition() {
+Quadcopter::BodyThrust Quadcopter::CalculateBodyThrust() {
 	Vector3D TBO = TB->ReturnThrusterOutput();
-	Vector3D TCO = TC->ReturnThrusterOutput();
-	Vector3D TDO = TD->ReturnThrusterOutput();
-	Vector3D TEO = TE->ReturnThrusterOutput();
 
 	Vector3D TBThrust = Vector3D(0, TBO.Y, 0);
-	Vector3D TCThrust = Vector3D(0, TCO.Y, 0);
-	Vector3D TDThrust = Vector3D(0, TDO.Y, 0);
-	Vector3D TEThrust = Vector3D(0, TEO.Y, 0);
 
-	Quaternion TBR = Rotation(EulerAngles(Vector3D(TBO.X, 0, -TBO.Z), EulerConstants::EulerOrderZYXS)).GetQuaternion();
-	Quaternion TCR = Rotation(EulerAngles(Vector3D(TCO.X, 0, -TCO.Z), EulerConstants::EulerOrderZYXS)).GetQuaternion();
-	Quaternion TDR = Rotation(EulerAngles(Vector3D(TDO.X, 0, -TDO.Z), EulerConstants::EulerOrderZYXS)).GetQuaternion();
-	Quaternion TER = Rotation(EulerAngles(Vector3D(TEO.X, 0, -TEO.Z), EulerConstants::EulerOrderZYXS)).GetQuaternion();
+	Quaternion TBR = EulerConversion::ToQuaternion<EulerConstants::EulerOrderZYXSTag>(Vector3D(TBO.X, 0, -TBO.Z));
 
-	TBThrust = TBR.RotateVector(TBThrust);
-	TCThrust = TCR.RotateVector(TCThrust);
-	TDThrust = TDR.RotateVector(TDThrust);
-	TEThrust = TER.RotateVector(TEThrust);
+	TBThrust = TBR.RotateUnitVector(TBThrust);
 
-	Vector3D thrustSum = TBThrust.Add(TBThrust).Add(TBThrust).Add(TBThrust);
+	BodyThrust thrust;
 
-	thrustSum = CurrentRotation.GetQuaternion().RotateVector(thrustSum);
+	thrust.Combined = TBThrust.Add(TBThrust).Add(TBThrust).Add(TBThrust);
+	thrust.TB = TB->ReturnThrustVector();//Thrust relative to quad origin
+	thrust.TC = TC->ReturnThrustVector();
+	thrust.TD = TD->ReturnThrustVector();
+	thrust.TE = TE->ReturnThrustVector();
+
+	return thrust;
+}
+
+Vector3D Quadcopter::CalculateLinearAcceleration(BodyThrust thrust, Quaternion attitude) {
+	Vector3D thrustSum = attitude.RotateUnitVector(thrust.Combined);
+
+	return thrustSum + externalAcceleration;
+}
 
+Vector3D Quadcopter::CalculateAngularAcceleration(BodyThrust thrust, Quaternion attitude) {
+	//Rotate Thrust Vector about current quaternion rotation, relative to world origin
+	Vector3D thrustWorld[ControlAllocation::Thrusters] = { thrust.TB, thrust.TC, thrust.TD, thrust.TE };
+
+	Quaternion::RotateUnitVectors(attitude, thrustWorld, thrustWorld, ControlAllocation::Thrusters);
+
+	return allocation.CalculateAngularAcceleration(thrustWorld);
+}
+
+Vector3D Quadcopter::CalculateDrag(Vector3D velocity) {
 	//Surface area frame: 0.054145
 	//Surface area inner arm: 0.017069 x4 = 0.068276
 	//Surface area outer arm: 0.015366 x4 = 0.06164
 	//Total area in m2: 0.184061
 	//
 	//drag force = 0.5 * density * air velocity^2 * dragCoef * area
-	Vector3D dragForce = Vector3D {
-		0.5 * 1.225 * pow(currentVelocity.X, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentVelocity.X),
-		0.5 * 1.225 * pow(currentVelocity.Y, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentVelocity.Y),
-		0.5 * 1.225 * pow(currentVelocity.Z, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentVelocity.Z)
+	return Vector3D {
+		0.5 * 1.225 * pow(velocity.X, 2) * 1.0 * 0.184061 * Mathematics::Sign(velocity.X),
+		0.5 * 1.225 * pow(velocity.Y, 2) * 1.0 * 0.184061 * Mathematics::Sign(velocity.Y),
+		0.5 * 1.225 * pow(velocity.Z, 2) * 1.0 * 0.184061 * Mathematics::Sign(velocity.Z)
 	};
+}
+
+void Quadcopter::EstimatePosition(BodyThrust thrust) {
+	Vector3D dragForce = CalculateDrag(currentVelocity);
 
-	currentAcceleration = thrustSum + externalAcceleration;
-	currentVelocity = currentVelocity + currentAcceleration * dT - dragForce * dT;
+	currentAcceleration = CalculateLinearAcceleration(thrust, CurrentRotation.GetQuaternion());
+	currentVelocity = Vector3D::MulSub(Vector3D::MulAdd(currentVelocity, currentAcceleration, physicsDT), dragForce, physicsDT);
 
 	//std::cout << currentVelocity.ToString() << " " << dragForce.ToString() << std::endl;
 
-	CurrentPosition = CurrentPosition + currentVelocity * dT;
+	CurrentPosition = Vector3D::MulAdd(CurrentPosition, currentVelocity, physicsDT);
 }
 
-void Quadcopter::EstimateRotation() {
-	Vector3D TBO = TB->ReturnThrustVector();//Thrust relative to quad origin
-	Vector3D TCO = TC->ReturnThrustVector();
-	Vector3D TDO = TD->ReturnThrustVector();
-	Vector3D TEO = TE->ReturnThrustVector();
+void Quadcopter::EstimateRotation(BodyThrust thrust) {
+	Vector3D dragForce = CalculateDrag(currentAngularVelocity);
 
-	//Rotate Thrust Vector about current quaternion rotation
-	TBO = CurrentRotation.GetQuaternion().RotateVector(TBO);//Thrust relative to world origin
-	TCO = CurrentRotation.GetQuaternion().RotateVector(TCO);
-	TDO = CurrentRotation.GetQuaternion().RotateVector(TDO);
-	TEO = CurrentRotation.GetQuaternion().RotateVector(TEO);
+	currentAngularAcceleration = CalculateAngularAcceleration(thrust, CurrentRotation.GetQuaternion());
+	currentAngularVelocity = Vector3D::MulSub(Vector3D::MulAdd(currentAngularVelocity, currentAngularAcceleration, physicsDT), dragForce, physicsDT);
 
-	double torque = armLength * sin(Mathematics::DegreesToRadians(180 - armAngle)) * 5;
+	Quaternion angularRotation = Quaternion(currentAngularVelocity * 0.5 * physicsDT);
 
-	//calculate current inertia tensor
-	currentAngularAcceleration = Vector3D {
-		( TBO.Y + TCO.Y - TDO.Y - TEO.Y) * torque,
-		( TBO.X + TCO.X - TDO.X - TEO.X) * torque + ( TBO.Z - TCO.Z - TDO.Z + TEO.Z) * torque,
-		(-TBO.Y + TCO.Y + TDO.Y - TEO.Y) * torque
-	};
+	Quaternion current = CurrentRotation.GetQuaternion();
 
-	//drag force = 0.5 * density * air velocity^2 * dragCoef * area
-	Vector3D dragForce = Vector3D{
-		0.5 * 1.225 * pow(currentAngularVelocity.X, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentAngularVelocity.X),
-		0.5 * 1.225 * pow(currentAngularVelocity.Y, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentAngularVelocity.Y),
-		0.5 * 1.225 * pow(currentAngularVelocity.Z, 2) * 1.0 * 0.184061 * Mathematics::Sign(currentAngularVelocity.Z)
-	};
+	current = Quaternion::MulAdd(current, angularRotation, current);
+
+	CurrentRotation.SetQuaternion(current / current.Magnitude());
+}
+
+Quadcopter::BodyState Quadcopter::CalculateDerivative(BodyThrust thrust, BodyState state) {
+	BodyState derivative;
+	Quaternion attitude = state.Attitude / state.Attitude.Magnitude();//The stages drift off unit length
+
+	derivative.Position = state.Velocity;
+	derivative.Velocity = CalculateLinearAcceleration(thrust, attitude) - CalculateDrag(state.Velocity);
+	derivative.Attitude = Quaternion(state.AngularVelocity * 0.5) * state.Attitude;
+	derivative.AngularVelocity = CalculateAngularAcceleration(thrust, attitude) - CalculateDrag(state.AngularVelocity);
+
+	return derivative;
+}
+
+Quadcopter::BodyState Quadcopter::Advance(BodyState state, BodyState derivative, double step) {
+	BodyState advanced;
+
+	advanced.Position = Vector3D::MulAdd(state.Position, derivative.Position, step);
+	advanced.Velocity = Vector3D::MulAdd(state.Velocity, derivative.Velocity, step);
+	advanced.Attitude = Quaternion::MulAdd(state.Attitude, derivative.Attitude, step);
+	advanced.AngularVelocity = Vector3D::MulAdd(state.AngularVelocity, derivative.AngularVelocity, step);
+
+	return advanced;
+}
+
+void Quadcopter::IntegrateRungeKutta4() {
+	//Actuator outputs are held for the whole step, only the rigid body state is staged
+	BodyThrust thrust = CalculateBodyThrust();
+	BodyState state = BodyState{ CurrentPosition, currentVelocity, CurrentRotation.GetQuaternion(), currentAngularVelocity };
+
+	BodyState k1 = CalculateDerivative(thrust, state);
+	BodyState k2 = CalculateDerivative(thrust, Advance(state, k1, physicsDT * 0.5));
+	BodyState k3 = CalculateDerivative(thrust, Advance(state, k2, physicsDT * 0.5));
+	BodyState k4 = CalculateDerivative(thrust, Advance(state, k3, physicsDT));
+
+	state = Advance(state, k1, physicsDT / 6.0);
+	state = Advance(state, k2, physicsDT / 3.0);
+	state = Advance(state, k3, physicsDT / 3.0);
+	state = Advance(state, k4, physicsDT / 6.0);
+
+	currentAcceleration = CalculateLinearAcceleration(thrust, CurrentRotation.GetQuaternion());
+	currentAngularAcceleration = CalculateAngularAcceleration(thrust, CurrentRotation.GetQuaternion());
+
+	CurrentPosition = state.Position;
+	currentVelocity = state.Velocity;
+	currentAngularVelocity = state.AngularVelocity;
+	CurrentRotation.SetQuaternion(state.Attitude / state.Attitude.Magnitude());
+}
+
+void Quadcopter::IntegrateExponentialMap() {
+	BodyThrust thrust = CalculateBodyThrust();
+	Quaternion attitude = CurrentRotation.GetQuaternion();
+
+	EstimatePosition(thrust);
+
+	Vector3D dragForce = CalculateDrag(currentAngularVelocity);
+
+	currentAngularAcceleration = CalculateAngularAcceleration(thrust, attitude);
+	currentAngularVelocity = Vector3D::MulSub(Vector3D::MulAdd(currentAngularVelocity, currentAngularAcceleration, physicsDT), dragForce, physicsDT);
+
+	//exp(w * dT / 2) rotates by exactly |w| * dT about w, the first order update only approximates it
+	Vector3D halfAngle = currentAngularVelocity * 0.5 * physicsDT;
+	double angle = halfAngle.Magnitude();
+	Quaternion angularRotation = Quaternion(1, 0, 0, 0);
+
+	if (angle > 0) {
+		Vector3D axis = halfAngle / angle;
+		double s, c;
 
-	//TB + TD - (TC + TE)
-	Vector3D differentialThrustRotation = TBO.Add(TDO).Subtract(TCO.Add(TEO));// .Multiply(0.15);
+		Trigonometry::SinCos(angle, s, c);
 
-	currentAngularAcceleration = currentAngularAcceleration + differentialThrustRotation;
-	currentAngularAcceleration = Vector3D::DegreesToRadians(currentAngularAcceleration);
-	currentAngularVelocity = currentAngularVelocity + currentAngularAcceleration * dT - dragForce * dT;
+		angularRotation = Quaternion(c, axis.X * s, axis.Y * s, axis.Z * s);
+	}
 
-	Quaternion angularRotation = Quaternion(currentAngularVelocity * 0.5 * dT);
+	attitude = angularRotation * attitude;
 
-	CurrentRotation = Rotation((CurrentRotation.GetQuaternion() + angularRotation * CurrentRotation.GetQuaternion()).UnitQuaternion());
+	CurrentRotation.SetQuaternion(attitude / attitude.Magnitude());
 }
 
-Vector3D Quadcopter::RotationToHoverAngles(Rotation rotation) {
+Vector3D Quadcopter::RotationToHoverAngles(Rotation &rotation) {
 	double outerJoint = 0;
 	double innerJoint = 0;
 	DirectionAngle directionAngle = rotation.GetDirectionAngle();
@@ -223,8 +499,8 @@ Vector3D Quadcopter::RotationToHoverAngles(Rotation rotation) {
 	directionVector = RotationMatrix::RotateVector(Vector3D(0, directionAngle.Rotation, 0), directionVector);
 
 	//These are cartesian coordinates, convert them to the angle from 1, 0 to the point it is at
-	innerJoint = Mathematics::RadiansToDegrees(asin(directionVector.Z));
-	outerJoint = Mathematics::RadiansToDegrees(atan2(directionVector.X, directionVector.Y));
+	innerJoint = Mathematics::RadiansToDegrees(Trigonometry::Asin(directionVector.Z));
+	outerJoint = Mathematics::RadiansToDegrees(Trigonometry::Atan2(directionVector.X, directionVector.Y));
 
 	return Vector3D(outerJoint, 0, innerJoint);
 }
@@ -240,11 +516,11 @@ void Quadcopter::CalculateGimbalLockedMotion(Vector3D &positionControl, Vector3D
 
 	double rotation = 40 * fadeIn;
 
-	double magnitude = sqrt(pow(positionControl.X, 2) + pow(positionControl.Z, 2));//Give hypotenuse for origin rotation, magnitude
+	double magnitude = sqrt(Trigonometry::Pow(positionControl.X, 2) + Trigonometry::Pow(positionControl.Z, 2));//Give hypotenuse for origin rotation, magnitude
 	//double angle = Mathematics::RadiansToDegrees(Mathematics::Sign(hoverAngles.Z) * atan2(magnitude, 0) - atan2(positionControl.Z, positionControl.X));//Determine angle of output, -180 -> 180
 																													  //Rotation matrix on position control copy
 	//Vector3D RotatedControl = RotationMatrix::RotateVector(Vector3D(0, CurrentEulerRotation.Y, 0), Vector3D(positionControl.X, 0, positionControl.Z));
-	Vector3D rotatedControl = CalculateRotationOffset().RotateVector(positionControl);
+	Vector3D rotatedControl = CalculateRotationOffset().RotateUnitVector(positionControl);
 
 	//---- (X-), ++++ (X+), +-+- (Z+), -+-+ (Z-)
 	thrusterOutputB.X = thrusterOutputB.X * fadeOut + (rotatedControl.X * fadeIn) + (rotatedControl.Z * fadeIn);
@@ -265,9 +541,9 @@ void Quadcopter::CalculateGimbalLockedMotion(Vector3D &positionControl, Vector3D
 Quaternion Quadcopter::CalculateRotationOffset() {
 	Vector3D hoverRotation = RotationToHoverAngles(CurrentRotation);
 
-	Quaternion hover = Rotation(EulerAngles(hoverRotation, EulerConstants::EulerOrderXYZS)).GetQuaternion();
+	Quaternion hover = EulerConversion::ToQuaternion<EulerConstants::EulerOrderXYZSTag>(hoverRotation);
 
-	Quaternion yaw3D = hover * CurrentRotation.GetQuaternion().MultiplicativeInverse();
+	Quaternion yaw3D = hover * CurrentRotation.GetQuaternion().Conjugate();
 
 	return yaw3D;
 }
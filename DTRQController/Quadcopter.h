@@ -1,16 +1,67 @@
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include "ADRC.h"
+#include "ControlAllocation.h"
 #include "Mathematics.h"
 #include "Rotation.h"
 #include "Thruster.h"
 #include "TriangleWaveFader.h"
+#include "Trigonometry.h"
 #include "Vector.h"
 #include "VectorFeedbackController.h"
 
 class Quadcopter {
+public:
+	enum Integrator {
+		SemiImplicitEuler,//Legacy, velocity then position from the updated velocity
+		RungeKutta4,//Coupled position, velocity, attitude and angular velocity with held actuator outputs
+		ExponentialMap//Semi-implicit velocities, attitude rotated by the exact exponential of the step
+	};
+
+	//Flat copy of the simulated state, trivially copyable so it can be stored and duplicated freely
+	typedef struct Snapshot {
+		static const int ControllerCapacity = 64;
+
+		double Position[3];
+		double Velocity[3];
+		double Acceleration[3];
+		double Rotation[4];
+		double AngularVelocity[3];
+		double AngularAcceleration[3];
+		double TargetPosition[3];
+		double TargetRotation[4];
+		double ExternalAcceleration[3];
+		double Thrusters[4][Thruster::StateSize];
+		double PositionController[ControllerCapacity];
+		double RotationController[ControllerCapacity];
+	} Snapshot;
+
 private:
+	typedef struct BodyState {
+		Vector3D Position;
+		Vector3D Velocity;
+		Quaternion Attitude;
+		Vector3D AngularVelocity;
+	} BodyState;
+
+	typedef struct BodyThrust {
+		Vector3D Combined;//Summed thrust in the quadcopter frame
+		Vector3D TB;
+		Vector3D TC;
+		Vector3D TD;
+		Vector3D TE;
+	} BodyThrust;
+
 	TriangleWaveFader gimbalLockFader;
+	ControlAllocation allocation;
+
+	//Outer joint, inner joint and rotor springs of TB, TC, TD and TE in that order, all 12 stepped in one pass
+	static const int ActuatorChannels = ControlAllocation::Thrusters * Thruster::ActuatorChannels;
+	ActuatorBank actuators;
+
 	Vector3D externalAcceleration;
 	Vector3D currentVelocity;
 	Vector3D currentAngularVelocity;
@@ -18,22 +69,42 @@ private:
 	Vector3D currentAcceleration;
 	double armLength;
 	double armAngle;
-	double dT;
+	double dT;//controller rate
+	double physicsDT;//rigid body and actuator rate, dT / physicsSubsteps
+	int physicsSubsteps;
 	bool simulation;
+	bool verbose;
+	bool feedbackEnabled;
+	Integrator integrator;
 
 	void CalculateArmPositions(double armLength, double armAngle);
+	void StepActuators();
+	void CalculateThrusterPositions(Quaternion rotation, Vector3D position, Vector3D *positions);
 	void CalculateGimbalLockedMotion(Vector3D &positionControl, Vector3D &thrusterOutputB,
 							         Vector3D &thrusterOutputC, Vector3D &thrusterOutputD,
 									 Vector3D &thrusterOutputE);
 	Quaternion CalculateRotationOffset();
-	void EstimatePosition();
-	void EstimateRotation();
+	void EstimatePosition(BodyThrust thrust);
+	void EstimateRotation(BodyThrust thrust);
+	void IntegrateRungeKutta4();
+	void IntegrateExponentialMap();
+
+	BodyThrust CalculateBodyThrust();
+	//attitude must be a unit quaternion, it is rotated through the unit paths
+	Vector3D CalculateLinearAcceleration(BodyThrust thrust, Quaternion attitude);
+	Vector3D CalculateAngularAcceleration(BodyThrust thrust, Quaternion attitude);
+	BodyState CalculateDerivative(BodyThrust thrust, BodyState state);
+	static BodyState Advance(BodyState state, BodyState derivative, double step);
+	static Vector3D CalculateDrag(Vector3D velocity);
 
 	VectorFeedbackController *positionController;
 	VectorFeedbackController *rotationController;
 	
-	Vector3D RotationToHoverAngles(Rotation rotation);
+	Vector3D RotationToHoverAngles(Rotation &rotation);//by reference so the cached direction angle is kept
+	static void SaveVector(Vector3D vector, double *values);
+	static Vector3D LoadVector(const double *values);
 public:
+	//Kept at unit length by SetCurrent, SetTarget and every integrator
 	Rotation CurrentRotation;
 	Rotation TargetRotation;
 	Vector3D CurrentPosition;
@@ -44,9 +115,25 @@ public:
 	Thruster *TE;
 
 	Quadcopter(bool simulation, double armLength, double armAngle, double dT, VectorFeedbackController *pos, VectorFeedbackController *rot);
+	//Quiet when verbose is false, for campaigns and tuners building vehicles on worker threads
+	Quadcopter(bool simulation, double armLength, double armAngle, double dT, VectorFeedbackController *pos, VectorFeedbackController *rot, bool verbose);
+	Quadcopter(const Quadcopter&) = delete;
+	Quadcopter& operator =(const Quadcopter&) = delete;
 	~Quadcopter();
 	void CalculateCombinedThrustVector();
-	void SetTarget(Vector3D position, Rotation rotation);
-	void SetCurrent(Vector3D position, Rotation rotation);
+	void SetTarget(Vector3D position, const Rotation &rotation);//by reference, a Rotation carries its conversion cache
+	void SetCurrent(Vector3D position, const Rotation &rotation);
 	void SimulateCurrent(Vector3D externalAcceleration);
+	void SetFeedbackEnabled(bool enabled);
+	void SetIntegrator(Integrator integrator);
+	Integrator GetIntegrator();
+	void SetPhysicsSubsteps(int substeps);
+	int GetPhysicsSubsteps();
+
+	bool SaveSnapshot(Snapshot &snapshot);
+	bool RestoreSnapshot(const Snapshot &snapshot);
+	std::unique_ptr<Quadcopter> Clone();
+	std::vector<std::unique_ptr<Quadcopter>> Fork(const Snapshot &snapshot, int branches);
 };
+
+static_assert(std::is_trivially_copyable<Quadcopter::Snapshot>::value, "Quadcopter snapshots must stay plain data.");
@@ -1,64 +1,73 @@
 #include "Quaternion.h"
+#include "SIMD.h"
+#include "Trigonometry.h"
 
-Quaternion::Quaternion() {
-	this->W = 1.0;
-	this->X = 0.0;
-	this->Y = 0.0;
-	this->Z = 0.0;
-}
+//The vector kernels read W, X, Y, Z as four contiguous scalars
+static_assert(sizeof(Quaternion) == 4 * sizeof(double), "Quaternion must stay four packed doubles.");
+static_assert(sizeof(QuaternionF) == 4 * sizeof(float), "QuaternionF must stay four packed floats.");
+
+template <typename T>
+Vector3<T> QuaternionT<T>::RotateVector(Vector3<T> coordinate) {
+	//current * (0, coordinate) * current^-1, expanded so neither the inverse nor the products are formed
+	Vector3<T> result;
+
+	SIMD::RotateVector(&this->W, &coordinate.X, &result.X);
 
-Quaternion::Quaternion(const Quaternion& quaternion) {
-	this->W = quaternion.W;
-	this->X = quaternion.X;
-	this->Y = quaternion.Y;
-	this->Z = quaternion.Z;
+	return result;
 }
 
-Quaternion::Quaternion(Vector3D vector) {
-	this->W = 0;
-	this->X = vector.X;
-	this->Y = vector.Y;
-	this->Z = vector.Z;
+template <typename T>
+Vector3<T> QuaternionT<T>::RotateUnitVector(Vector3<T> coordinate) {
+	Vector3<T> result;
+
+	SIMD::RotateUnitVector(&this->W, &coordinate.X, &result.X);
+
+	return result;
 }
 
-Quaternion::Quaternion(double w, double x, double y, double z) {
-	this->W = w;
-	this->X = x;
-	this->Y = y;
-	this->Z = z;
+template <typename T>
+void QuaternionT<T>::RotateVectors(QuaternionT rotation, const Vector3<T> *coordinates, Vector3<T> *result, int count) {
+	//Expands the rotation to a matrix once, each coordinate is then nine multiplies
+	T matrix[9];
+
+	if (count <= 0) return;
+
+	SIMD::RotationMatrix(&rotation.W, matrix);
+	SIMD::TransformVectors(matrix, &coordinates->X, &result->X, count);
 }
 
-Vector3D Quaternion::RotateVector(Vector3D coordinate) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-	Quaternion qv = Quaternion(0, coordinate.X, coordinate.Y, coordinate.Z);
-	Quaternion qr = current * qv * current.MultiplicativeInverse();
+template <typename T>
+void QuaternionT<T>::RotateUnitVectors(QuaternionT rotation, const Vector3<T> *coordinates, Vector3<T> *result, int count) {
+	T matrix[9];
 
-	return Vector3D {
-		qr.X,
-		qr.Y,
-		qr.Z
-	};
+	if (count <= 0) return;
+
+	SIMD::UnitRotationMatrix(&rotation.W, matrix);
+	SIMD::TransformVectors(matrix, &coordinates->X, &result->X, count);
 }
 
-Vector3D Quaternion::UnrotateVector(Vector3D coordinate) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+Vector3<T> QuaternionT<T>::UnrotateVector(Vector3<T> coordinate) {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return current.Conjugate().RotateVector(coordinate);
 }
 
-Vector3D Quaternion::GetBiVector() {
-	return Vector3D{
+template <typename T>
+Vector3<T> QuaternionT<T>::GetBiVector() {
+	return Vector3<T>{
 		this->X,
 		this->Y,
 		this->Z
 	};
 }
 
-Quaternion Quaternion::SphericalInterpolation(Quaternion q1, Quaternion q2, double ratio) {
+template <typename T>
+QuaternionT<T> QuaternionT<T>::SphericalInterpolation(QuaternionT q1, QuaternionT q2, T ratio) {
 	q1 = q1.UnitQuaternion();
 	q2 = q2.UnitQuaternion();
 
-	double dot = q1.DotProduct(q2);//Cosine between the two quaternions
+	T dot = q1.DotProduct(q2);//Cosine between the two quaternions
 
 	if (dot < 0.0)//Shortest path correction
 	{
@@ -74,126 +83,78 @@ Quaternion Quaternion::SphericalInterpolation(Quaternion q1, Quaternion q2, doub
 	{
 		dot = Mathematics::Constrain(dot, -1, 1);
 
-		double theta0 = acos(dot);
-		double theta = theta0 * ratio;
+		T theta0 = Trigonometry::Acos(dot);
+		T theta = theta0 * ratio;
 
 		//Quaternion q3 = (q2.Subtract(q1.Multiply(dot))).UnitQuaternion();//UQ for orthonomal 
-		double f1 = cos(theta) - dot * sin(theta) / sin(theta0);
-		double f2 = sin(theta) / sin(theta0);
+		T sinTheta = Trigonometry::Sin(theta), sinTheta0 = Trigonometry::Sin(theta0);
+		T f1 = Trigonometry::Cos(theta) - dot * sinTheta / sinTheta0;
+		T f2 = sinTheta / sinTheta0;
 
 		return q1.Multiply(f1).Add(q2.Multiply(f2)).UnitQuaternion();
 	}
 }
 
-Quaternion Quaternion::Add(Quaternion quaternion) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion {
-		current.W + quaternion.W,
-		current.X + quaternion.X,
-		current.Y + quaternion.Y,
-		current.Z + quaternion.Z
-	};
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Add(QuaternionT quaternion) {
+	return *this + quaternion;
 }
 
-Quaternion Quaternion::Subtract(Quaternion quaternion) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion{
-		current.W - quaternion.W,
-		current.X - quaternion.X,
-		current.Y - quaternion.Y,
-		current.Z - quaternion.Z
-	};
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Subtract(QuaternionT quaternion) {
+	return *this - quaternion;
 }
 
-Quaternion Quaternion::Multiply(Quaternion quaternion) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-	
-	return Quaternion
-	{
-		current.W * quaternion.W - current.X * quaternion.X - current.Y * quaternion.Y - current.Z * quaternion.Z,
-		current.W * quaternion.X + current.X * quaternion.W + current.Y * quaternion.Z - current.Z * quaternion.Y,
-		current.W * quaternion.Y - current.X * quaternion.Z + current.Y * quaternion.W + current.Z * quaternion.X,
-		current.W * quaternion.Z + current.X * quaternion.Y - current.Y * quaternion.X + current.Z * quaternion.W
-	};
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Multiply(QuaternionT quaternion) {
+	return *this * quaternion;
 }
 
-Quaternion Quaternion::Multiply(double scalar) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion{
-		current.W * scalar,
-		current.X * scalar,
-		current.Y * scalar,
-		current.Z * scalar
-	};
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Multiply(T scalar) {
+	return *this * scalar;
 }
 
-Quaternion operator  *(double scalar, Quaternion q) {
-	Quaternion quaternion = Quaternion(q.W, q.X, q.Y, q.Z);
-
-	return quaternion.Multiply(scalar);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Divide(QuaternionT quaternion) {
+	return *this / quaternion;
 }
 
-Quaternion operator  *(Quaternion q, double scalar) {
-	Quaternion quaternion = Quaternion(q.W, q.X, q.Y, q.Z);
-
-	return quaternion.Multiply(scalar);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Divide(T scalar) {
+	return *this / scalar;
 }
 
-Quaternion Quaternion::Divide(Quaternion quaternion) {
-	double scale = quaternion.W * quaternion.W + quaternion.X * quaternion.X + quaternion.Y * quaternion.Y + quaternion.Z * quaternion.Z;
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Power(QuaternionT exponent) {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
-	return Quaternion
+	return QuaternionT
 	{
-		( current.W * quaternion.W + current.X * quaternion.X + current.Y * quaternion.Y + current.Z * quaternion.Z) / scale,
-		(-current.W * quaternion.X + current.X * quaternion.W + current.Y * quaternion.Z - current.Z * quaternion.Y) / scale,
-		(-current.W * quaternion.Y - current.X * quaternion.Z + current.Y * quaternion.W + current.Z * quaternion.X) / scale,
-		(-current.W * quaternion.Z + current.X * quaternion.Y - current.Y * quaternion.X + current.Z * quaternion.W) / scale
+		std::pow(current.W, exponent.W),
+		std::pow(current.X, exponent.X),
+		std::pow(current.Y, exponent.Y),
+		std::pow(current.Z, exponent.Z)
 	};
 }
 
-Quaternion Quaternion::Divide(double scalar) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Power(T exponent) {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
-	return Quaternion
+	return QuaternionT
 	{
-		current.W / scalar,
-		current.X / scalar,
-		current.Y / scalar,
-		current.Z / scalar
+		std::pow(current.W, exponent),
+		std::pow(current.X, exponent),
+		std::pow(current.Y, exponent),
+		std::pow(current.Z, exponent)
 	};
 }
 
-Quaternion Quaternion::Power(Quaternion exponent) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion
-	{
-		pow(current.W, exponent.W),
-		pow(current.X, exponent.X),
-		pow(current.Y, exponent.Y),
-		pow(current.Z, exponent.Z)
-	};
-}
-
-Quaternion Quaternion::Power(double exponent) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion
-	{
-		pow(current.W, exponent),
-		pow(current.X, exponent),
-		pow(current.Y, exponent),
-		pow(current.Z, exponent)
-	};
-}
-
-Quaternion Quaternion::Permutate(Vector3D permutation) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-	double perm[3];
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Permutate(Vector3<T> permutation) {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
+	T perm[3];
 
 	perm[(int)permutation.X] = current.X;
 	perm[(int)permutation.Y] = current.Y;
@@ -206,10 +167,11 @@ Quaternion Quaternion::Permutate(Vector3D permutation) {
 	return current;
 }
 
-Quaternion Quaternion::Absolute() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Absolute() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
-	return Quaternion
+	return QuaternionT
 	{
 		std::abs(current.W),
 		std::abs(current.X),
@@ -218,29 +180,24 @@ Quaternion Quaternion::Absolute() {
 	};
 }
 
-Quaternion Quaternion::AdditiveInverse() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-	return Quaternion
-	{
-		-current.W,
-		-current.X,
-		-current.Y,
-		-current.Z
-	};
+template <typename T>
+QuaternionT<T> QuaternionT<T>::AdditiveInverse() {
+	return -*this;
 }
 
-Quaternion Quaternion::MultiplicativeInverse() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::MultiplicativeInverse() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return current.Conjugate().Multiply(1.0 / current.Normal());
 
 }
 
-Quaternion Quaternion::Conjugate() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::Conjugate() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
-	return Quaternion
+	return QuaternionT
 	{
 		 current.W,
 		-current.X,
@@ -249,60 +206,61 @@ Quaternion Quaternion::Conjugate() {
 	};
 }
 
-Quaternion Quaternion::UnitQuaternion() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+QuaternionT<T> QuaternionT<T>::UnitQuaternion() {
+	QuaternionT result;
 
-	double n = current.Normal();
+	SIMD::UnitQuaternion(&this->W, &result.W);
 
-	current.W = current.W / n;
-	current.X = current.X / n;
-	current.Y = current.Y / n;
-	current.Z = current.Z / n;
-
-	return current;
+	return result;
 }
 
-double Quaternion::Magnitude() {
+template <typename T>
+T QuaternionT<T>::Magnitude() {
 	return sqrt(Normal());
 }
 
-double Quaternion::DotProduct(Quaternion q) {
-	return (W * q.W) + (X * q.X) + (Y * q.Y) + (Z * q.Z);
+template <typename T>
+T QuaternionT<T>::DotProduct(QuaternionT q) {
+	return SIMD::Dot(&this->W, &q.W, 4);
 }
 
-double Quaternion::Normal() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
-
-
-	return pow(current.W, 2.0) + pow(current.X, 2.0) + pow(current.Y, 2.0) + pow(current.Z, 2.0);
+template <typename T>
+T QuaternionT<T>::Normal() {
+	return SIMD::Dot(&this->W, &this->W, 4);
 }
 
-bool Quaternion::IsNaN() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+bool QuaternionT<T>::IsNaN() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return Mathematics::IsNaN(current.W) || Mathematics::IsNaN(current.X) || Mathematics::IsNaN(current.Y) || Mathematics::IsNaN(current.Z);
 }
 
-bool Quaternion::IsFinite() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+bool QuaternionT<T>::IsFinite() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return Mathematics::IsInfinite(current.W) || Mathematics::IsInfinite(current.X) || Mathematics::IsInfinite(current.Y) || Mathematics::IsInfinite(current.Z);
 }
 
-bool Quaternion::IsInfinite() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+bool QuaternionT<T>::IsInfinite() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return Mathematics::IsFinite(current.W) || Mathematics::IsFinite(current.X) || Mathematics::IsFinite(current.Y) || Mathematics::IsFinite(current.Z);
 }
 
-bool Quaternion::IsNonZero() {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+bool QuaternionT<T>::IsNonZero() {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return current.W != 0 && current.X != 0 && current.Y != 0 && current.Z != 0;
 }
 
-bool Quaternion::IsEqual(Quaternion quaternion) {
-	Quaternion current = Quaternion(this->W, this->X, this->Y, this->Z);
+template <typename T>
+bool QuaternionT<T>::IsEqual(QuaternionT quaternion) {
+	QuaternionT current = QuaternionT(this->W, this->X, this->Y, this->Z);
 
 	return !current.IsNaN() && !quaternion.IsNaN() &&
 		current.W == quaternion.W &&
@@ -311,7 +269,8 @@ bool Quaternion::IsEqual(Quaternion quaternion) {
 		current.Z == quaternion.Z;
 }
 
-std::string Quaternion::ToString() {
+template <typename T>
+std::string QuaternionT<T>::ToString() {
 	std::string w = Mathematics::DoubleToCleanString(this->W);
 	std::string x = Mathematics::DoubleToCleanString(this->X);
 	std::string y = Mathematics::DoubleToCleanString(this->Y);
@@ -320,3 +279,7 @@ std::string Quaternion::ToString() {
 	return "[" + w + ", " + x + ", " + y + ", " + z + "]";
 	
 }
+
+//Double for the simulation, float for the flight build
+template struct QuaternionT<double>;
+template struct QuaternionT<float>;
@@ -1,166 +1,221 @@
 #pragma once
 
 #include "Mathematics.h"
+#include "SIMD.h"
 #include "Vector.h"
 
-typedef struct Quaternion {
+//Scalar type as in Vector3, named QuaternionT so the double alias keeps the Quaternion name
+template <typename T>
+struct QuaternionT {
 public:
-	double W = 1.0;
-	double X = 0.0;
-	double Y = 0.0;
-	double Z = 0.0;
-
-	Quaternion();
-	Quaternion(const Quaternion& quaternion);
-	Quaternion(Vector3D vector);
-	Quaternion(double W, double X, double Y, double Z);
-
-	Vector3D RotateVector(Vector3D coordinate);
-	Vector3D UnrotateVector(Vector3D coordinate);
-	Vector3D GetBiVector();
-
-	Quaternion Add(Quaternion quaternion);
-	Quaternion Subtract(Quaternion quaternion);
-	Quaternion Multiply(Quaternion quaternion);
-	Quaternion Multiply(double scalar);
-	Quaternion Divide(Quaternion quaternion);
-	Quaternion Divide(double scalar);
-	Quaternion Power(Quaternion quaternion);
-
-	Quaternion Power(double exponent);
-	Quaternion Permutate(Vector3D permutation);
-
-	Quaternion Absolute();
-	Quaternion AdditiveInverse();
-	Quaternion MultiplicativeInverse();
-	Quaternion Conjugate();
-	Quaternion UnitQuaternion();
-
-	double Magnitude();
-	double DotProduct(Quaternion quaternion);
-	double Normal();
+	T W = 1.0;
+	T X = 0.0;
+	T Y = 0.0;
+	T Z = 0.0;
+
+	constexpr QuaternionT() noexcept : W(1.0), X(0.0), Y(0.0), Z(0.0) {}
+	constexpr QuaternionT(const QuaternionT& quaternion) noexcept : W(quaternion.W), X(quaternion.X), Y(quaternion.Y), Z(quaternion.Z) {}
+	constexpr QuaternionT(const Vector3<T>& vector) noexcept : W(0.0), X(vector.X), Y(vector.Y), Z(vector.Z) {}
+	constexpr QuaternionT(T w, T x, T y, T z) noexcept : W(w), X(x), Y(y), Z(z) {}
+
+	template <typename U>
+	constexpr explicit QuaternionT(const QuaternionT<U>& quaternion) noexcept : W((T)quaternion.W), X((T)quaternion.X), Y((T)quaternion.Y), Z((T)quaternion.Z) {}//between precisions
+
+
+	Vector3<T> RotateVector(Vector3<T> coordinate);
+	Vector3<T> RotateUnitVector(Vector3<T> coordinate);//Skips the normalization, only for unit quaternions
+	Vector3<T> UnrotateVector(Vector3<T> coordinate);
+
+	//RotateVector(coordinate) + offset, for body points placed in the world frame
+	Vector3<T> RotateAdd(const Vector3<T>& coordinate, const Vector3<T>& offset) const noexcept {
+		Vector3<T> result;
+
+		SIMD::RotateVector(&W, &coordinate.X, &result.X);
+
+		return result + offset;
+	}
+	Vector3<T> GetBiVector();
+
+	QuaternionT Add(QuaternionT quaternion);
+	QuaternionT Subtract(QuaternionT quaternion);
+	QuaternionT Multiply(QuaternionT quaternion);
+	QuaternionT Multiply(T scalar);
+	QuaternionT Divide(QuaternionT quaternion);
+	QuaternionT Divide(T scalar);
+	QuaternionT Power(QuaternionT quaternion);
+
+	QuaternionT Power(T exponent);
+	QuaternionT Permutate(Vector3<T> permutation);
+
+	QuaternionT Absolute();
+	QuaternionT AdditiveInverse();
+	QuaternionT MultiplicativeInverse();
+	QuaternionT Conjugate();
+	QuaternionT UnitQuaternion();
+
+	T Magnitude();
+	T DotProduct(QuaternionT quaternion);
+	T Normal();
 
 	bool IsNaN();
 	bool IsFinite();
 	bool IsInfinite();
 	bool IsNonZero();
-	bool IsEqual(Quaternion quaternion);
+	bool IsEqual(QuaternionT quaternion);
 
 	std::string ToString();
 
 	//Static functions
-	static Quaternion SphericalInterpolation(Quaternion q1, Quaternion q2, double ratio);
+	static QuaternionT SphericalInterpolation(QuaternionT q1, QuaternionT q2, T ratio);
+	static void RotateVectors(QuaternionT rotation, const Vector3<T> *coordinates, Vector3<T> *result, int count);
+	static void RotateUnitVectors(QuaternionT rotation, const Vector3<T> *coordinates, Vector3<T> *result, int count);//As RotateUnitVector
 
-	static Quaternion Add(Quaternion q1, Quaternion q2) {
+	static QuaternionT Add(QuaternionT q1, QuaternionT q2) {
 		return q1.Add(q2);
 	}
 
-	static Quaternion Subtract(Quaternion q1, Quaternion q2) {
+	static QuaternionT Subtract(QuaternionT q1, QuaternionT q2) {
 		return q1.Subtract(q2);
 	}
 
-	static Quaternion Multiply(Quaternion q1, Quaternion q2) {
+	static QuaternionT Multiply(QuaternionT q1, QuaternionT q2) {
 		return q1.Multiply(q2);
 	}
 
-	static Quaternion Divide(Quaternion q1, Quaternion q2) {
+	static QuaternionT Divide(QuaternionT q1, QuaternionT q2) {
 		return q1.Divide(q2);
 	}
 
-	static Quaternion Power(Quaternion q1, Quaternion q2) {
+	static QuaternionT Power(QuaternionT q1, QuaternionT q2) {
 		return q1.Power(q2);
 	}
 
-	static double DotProduct(Quaternion q1, Quaternion q2) {
+	static T DotProduct(QuaternionT q1, QuaternionT q2) {
 		return q1.DotProduct(q2);
 	}
 
 
-	static Quaternion Power(Quaternion quaternion, double exponent) {
+	static QuaternionT Power(QuaternionT quaternion, T exponent) {
 		return quaternion.Power(exponent);
 	}
 
-	static Quaternion Permutate(Quaternion quaternion, Vector3D vector) {
+	static QuaternionT Permutate(QuaternionT quaternion, Vector3<T> vector) {
 		return quaternion.Permutate(vector);
 	}
 
-	static Quaternion Absolute(Quaternion quaternion) {
+	static QuaternionT Absolute(QuaternionT quaternion) {
 		return quaternion.Absolute();
 	}
 
-	static Quaternion AdditiveInverse(Quaternion quaternion) {
+	static QuaternionT AdditiveInverse(QuaternionT quaternion) {
 		return quaternion.AdditiveInverse();
 	}
 
-	static Quaternion MultiplicativeInverse(Quaternion quaternion) {
+	static QuaternionT MultiplicativeInverse(QuaternionT quaternion) {
 		return quaternion.MultiplicativeInverse();
 	}
 
-	static Quaternion Conjugate(Quaternion quaternion) {
+	static QuaternionT Conjugate(QuaternionT quaternion) {
 		return quaternion.Conjugate();
 	}
 
-	static Quaternion UnitQuaternion(Quaternion quaternion) {
+	static QuaternionT UnitQuaternion(QuaternionT quaternion) {
 		return quaternion.UnitQuaternion();
 	}
 
-	static double Magnitude(Quaternion quaternion) {
+	static T Magnitude(QuaternionT quaternion) {
 		return quaternion.Magnitude();
 	}
 
-	static double Normal(Quaternion quaternion) {
+	static T Normal(QuaternionT quaternion) {
 		return quaternion.Normal();
 	}
 
-	//Operator overloads
-	bool operator ==(Quaternion quaternion) {
-		return this->IsEqual(quaternion);
+	//Fused forms of the integration updates, evaluated in the same order as the written out expressions so results
+	//do not change
+	static QuaternionT MulAdd(const QuaternionT& quaternion, const QuaternionT& q1, const QuaternionT& q2) noexcept {
+		return quaternion + q1 * q2;
+	}
+
+	static constexpr QuaternionT MulAdd(const QuaternionT& quaternion, const QuaternionT& rate, T scalar) noexcept {
+		return QuaternionT(quaternion.W + rate.W * scalar, quaternion.X + rate.X * scalar, quaternion.Y + rate.Y * scalar, quaternion.Z + rate.Z * scalar);
+	}
+
+	//Operator overloads, arguments by reference and results built in place
+	constexpr bool operator ==(const QuaternionT& quaternion) const noexcept {
+		return W == quaternion.W && X == quaternion.X && Y == quaternion.Y && Z == quaternion.Z;
 	}
 
-	bool operator !=(Quaternion quaternion) {
-		return !(this->IsEqual(quaternion));
+	constexpr bool operator !=(const QuaternionT& quaternion) const noexcept {
+		return !(*this == quaternion);
 	}
 
-	Quaternion operator =(Quaternion quaternion) {
+	constexpr QuaternionT& operator =(const QuaternionT& quaternion) noexcept {
 		this->W = quaternion.W;
 		this->X = quaternion.X;
 		this->Y = quaternion.Y;
 		this->Z = quaternion.Z;
-		
-		return quaternion;
+
+		return *this;
 	}
 
-	Quaternion operator  +(Quaternion quaternion) {
-		Quaternion q = Quaternion(*this);
+	constexpr QuaternionT operator  -() const noexcept {
+		return QuaternionT(-W, -X, -Y, -Z);
+	}
+
+	constexpr QuaternionT operator  +(const QuaternionT& quaternion) const noexcept {
+		return QuaternionT(W + quaternion.W, X + quaternion.X, Y + quaternion.Y, Z + quaternion.Z);
+	}
 
-		return q.Add(quaternion);
+	constexpr QuaternionT operator  -(const QuaternionT& quaternion) const noexcept {
+		return QuaternionT(W - quaternion.W, X - quaternion.X, Y - quaternion.Y, Z - quaternion.Z);
 	}
 
-	Quaternion operator  -(Quaternion quaternion) {
-		Quaternion q = Quaternion(*this);
+	//Hamilton product, the kernel is not constexpr
+	QuaternionT operator  *(const QuaternionT& quaternion) const noexcept {
+		QuaternionT result;
 
-		return q.Subtract(quaternion);
+		SIMD::QuaternionMultiply(&W, &quaternion.W, &result.W);
+
+		return result;
 	}
 
-	Quaternion operator  *(Quaternion quaternion) {
-		Quaternion q = Quaternion(*this);
+	constexpr QuaternionT operator  /(const QuaternionT& q) const noexcept {
+		T scale = q.W * q.W + q.X * q.X + q.Y * q.Y + q.Z * q.Z;
+
+		return QuaternionT(
+			( W * q.W + X * q.X + Y * q.Y + Z * q.Z) / scale,
+			(-W * q.X + X * q.W + Y * q.Z - Z * q.Y) / scale,
+			(-W * q.Y - X * q.Z + Y * q.W + Z * q.X) / scale,
+			(-W * q.Z + X * q.Y - Y * q.X + Z * q.W) / scale
+		);
+	}
 
-		return q.Multiply(quaternion);
+	constexpr QuaternionT operator  *(T value) const noexcept {
+		return QuaternionT(W * value, X * value, Y * value, Z * value);
 	}
 
-	Quaternion operator  /(Quaternion quaternion) {
-		Quaternion q = Quaternion(*this);
+	constexpr QuaternionT operator  /(T value) const noexcept {
+		return QuaternionT(W / value, X / value, Y / value, Z / value);
+	}
 
-		return q.Divide(quaternion);
+	constexpr QuaternionT& operator +=(const QuaternionT& quaternion) noexcept {
+		return *this = *this + quaternion;
 	}
 
+	constexpr QuaternionT& operator -=(const QuaternionT& quaternion) noexcept {
+		return *this = *this - quaternion;
+	}
 
-	Quaternion operator  /(double value) {
-		Quaternion q = Quaternion(*this);
+	QuaternionT& operator *=(const QuaternionT& quaternion) noexcept {
+		return *this = *this * quaternion;
+	}
 
-		return q.Divide(value);
+	//Defined in the class so the scalar converts as it did before the template
+	friend constexpr QuaternionT operator *(T scalar, const QuaternionT& q) noexcept {
+		return q * scalar;
 	}
+};
 
-	friend Quaternion operator *(double scalar, Quaternion q);
-	friend Quaternion operator *(Quaternion q, double scalar);
-} Quaternion;
+typedef QuaternionT<double> Quaternion;
+typedef QuaternionT<float> QuaternionF;
@@ -1,30 +1,37 @@
 #include "QuaternionKalmanFilter.h"
 
-QuaternionKalmanFilter::QuaternionKalmanFilter() {
+template <typename T>
+QuaternionKalmanFilterT<T>::QuaternionKalmanFilterT() {
 	gain = 0.25;
 	memory = 25;
 }
 
-QuaternionKalmanFilter::QuaternionKalmanFilter(double gain, int memory) {
+template <typename T>
+QuaternionKalmanFilterT<T>::QuaternionKalmanFilterT(T gain, int memory) {
 	this->gain = gain;
 	this->memory = memory;
 }
 
-Quaternion QuaternionKalmanFilter::Filter(Quaternion value) {
+template <typename T>
+QuaternionT<T> QuaternionKalmanFilterT<T>::Filter(QuaternionT<T> value) {
 	values.push_back(value);
 
 	if ((signed int)values.size() > memory) {
 		values.erase(values.begin());
 	}
 
-	Quaternion out = Quaternion(0, 0, 0, 0);
+	QuaternionT<T> out = QuaternionT<T>(0, 0, 0, 0);
 
-	for (std::vector <Quaternion>::iterator i = values.begin(); i != values.end(); ++i) {
+	for (typename std::vector<QuaternionT<T>>::iterator i = values.begin(); i != values.end(); ++i) {
 		//out = Quaternion::SphericalInterpolation(out, *i, gain);
 		out = out.Add( (*i).Divide(values.size()) );
 	}
 
 	out = out.UnitQuaternion();
 
-	return Quaternion::SphericalInterpolation(value, out, 1 - gain);
+	return QuaternionT<T>::SphericalInterpolation(value, out, 1 - gain);
 }
+
+//Double for the simulation and offline tools, float for the flight build
+template class QuaternionKalmanFilterT<double>;
+template class QuaternionKalmanFilterT<float>;
@@ -2,16 +2,21 @@
 
 #include "Quaternion.h"
 
-class QuaternionKalmanFilter {
+//Scalar type as in Vector3, the double alias keeps the QuaternionKalmanFilter name
+template <typename T>
+class QuaternionKalmanFilterT {
 private:
-	double gain;
+	T gain;
 	int memory;
-	std::vector<Quaternion> values;
+	std::vector<QuaternionT<T>> values;
 
 public:
-	QuaternionKalmanFilter();
-	QuaternionKalmanFilter(double gain, int memory);
+	QuaternionKalmanFilterT();
+	QuaternionKalmanFilterT(T gain, int memory);
 
-	Quaternion Filter(Quaternion input);
+	QuaternionT<T> Filter(QuaternionT<T> input);
 
 };
+
+typedef QuaternionKalmanFilterT<double> QuaternionKalmanFilter;
+typedef QuaternionKalmanFilterT<float> QuaternionKalmanFilterF;
@@ -0,0 +1,97 @@
+#include "RealFFTPlan.h"
+#include "Mathematics.h"
+
+RealFFTPlan::RealFFTPlan() {
+	this->length = 0;
+}
+
+RealFFTPlan::RealFFTPlan(int length) {
+	this->length = 0;
+
+	if (length < 2 || !FFTPlan::IsPowerOfTwo(length)) {
+		std::cout << "Real FFT length " << length << " is not a power of two of at least 2." << std::endl;
+		return;
+	}
+
+	this->length = length;
+	this->plan = FFTPlan(length / 2);
+
+	twiddles.resize(length);
+	work.resize(length / 2);
+
+	for (int k = 0; k < length / 2; k++) {
+		double angle = 2.0 * Mathematics::PI * k / length;
+
+		twiddles[k * 2] = cos(angle);
+		twiddles[k * 2 + 1] = -sin(angle);
+	}
+}
+
+//With Z the transform of the packed samples, the even half is E = (Z[k] + conj(Z[h - k])) / 2, the odd half
+//O = -i (Z[k] - conj(Z[h - k])) / 2 and the bin X[k] = E + W^k O, W = exp(-2 pi i / length) and Z[h] = Z[0]
+bool RealFFTPlan::Forward(const double *input, std::complex<double> *spectrum) {
+	if (length == 0) return false;
+
+	int half = length / 2;
+
+	for (int k = 0; k < half; k++) {
+		work[k] = std::complex<double>(input[k * 2], input[k * 2 + 1]);
+	}
+
+	plan.Forward(work.data());
+
+	spectrum[0] = work[0].real() + work[0].imag();
+	spectrum[half] = work[0].real() - work[0].imag();
+
+	for (int k = 1; k < half; k++) {
+		double ar = work[k].real(), ai = work[k].imag();
+		double br = work[half - k].real(), bi = -work[half - k].imag();
+		double er = 0.5 * (ar + br), ei = 0.5 * (ai + bi);
+		double or_ = 0.5 * (ai - bi), oi = -0.5 * (ar - br);
+		double wr = twiddles[k * 2], wi = twiddles[k * 2 + 1];
+
+		spectrum[k] = std::complex<double>(er + wr * or_ - wi * oi, ei + wr * oi + wi * or_);
+	}
+
+	return true;
+}
+
+//The split run backwards, E = (X[k] + conj(X[h - k])) / 2 and O = (X[k] - conj(X[h - k])) W^-k / 2 pack into
+//Z = E + i O, whose scaled inverse holds the even samples in the real parts and the odd in the imaginary
+bool RealFFTPlan::Inverse(const std::complex<double> *spectrum, double *output) {
+	if (length == 0) return false;
+
+	int half = length / 2;
+
+	for (int k = 0; k < half; k++) {
+		double ar = spectrum[k].real(), ai = spectrum[k].imag();
+		double br = spectrum[half - k].real(), bi = -spectrum[half - k].imag();
+		double er = 0.5 * (ar + br), ei = 0.5 * (ai + bi);
+		double dr = 0.5 * (ar - br), di = 0.5 * (ai - bi);
+		double wr = twiddles[k * 2], wi = -twiddles[k * 2 + 1];
+		double or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+
+		work[k] = std::complex<double>(er - oi, ei + or_);
+	}
+
+	plan.Inverse(work.data(), true);
+
+	for (int k = 0; k < half; k++) {
+		output[k * 2] = work[k].real();
+		output[k * 2 + 1] = work[k].imag();
+	}
+
+	return true;
+}
+
+int RealFFTPlan::GetLength() {
+	return length;
+}
+
+int RealFFTPlan::GetBins() {
+	return length > 0 ? length / 2 + 1 : 0;
+}
+
+bool RealFFTPlan::IsValid() {
+	return length > 0;
+}
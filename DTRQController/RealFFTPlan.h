@@ -0,0 +1,29 @@
+#pragma once
+
+#include "FFTPlan.h"
+
+//Transform of length real samples through a complex FFTPlan of half the length. Even samples become the real parts
+//and odd samples the imaginary parts, one split pass then separates the two halves into the length / 2 + 1 bins of
+//the one sided spectrum, the rest mirror them as conjugates. Working space is owned by the plan.
+class RealFFTPlan {
+private:
+	int length;
+	FFTPlan plan;
+	std::vector<double> twiddles;//cos and -sin of 2 pi k / length for k below length / 2, interleaved
+	std::vector<std::complex<double>> work;
+
+public:
+	RealFFTPlan();
+	RealFFTPlan(int length);
+
+	//Writes length / 2 + 1 bins to spectrum
+	bool Forward(const double *input, std::complex<double> *spectrum);
+
+	//Reads length / 2 + 1 bins and writes the length samples Forward was given, scaled
+	bool Inverse(const std::complex<double> *spectrum, double *output);
+
+	int GetLength();
+	int GetBins();
+	bool IsValid();
+
+};
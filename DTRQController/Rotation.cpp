@@ -1,354 +1,336 @@
 #include "Rotation.h"
 
-Rotation::Rotation() {
-	QuaternionRotation = Quaternion();
+template <typename T>
+thread_local unsigned long long RotationT<T>::cacheHits = 0;
+template <typename T>
+thread_local unsigned long long RotationT<T>::cacheMisses = 0;
+
+template <typename T>
+RotationT<T>::RotationT() {
+	QuaternionRotation = QuaternionT<T>();
 }
 
-Rotation::Rotation(Quaternion quaternion) {
+template <typename T>
+RotationT<T>::RotationT(QuaternionT<T> quaternion) {
 	QuaternionRotation = quaternion;
 }
 
-Rotation::Rotation(AxisAngle axisAngle) {
+template <typename T>
+RotationT<T>::RotationT(AxisAngleT<T> axisAngle) {
 	QuaternionRotation = AxisAngleToQuaternion(axisAngle);
 }
 
-Rotation::Rotation(DirectionAngle directionAngle) {
+template <typename T>
+RotationT<T>::RotationT(DirectionAngleT<T> directionAngle) {
 	QuaternionRotation = DirectionAngleToQuaternion(directionAngle);
 }
 
-Rotation::Rotation(RotationMatrix rotationMatrix) {
+template <typename T>
+RotationT<T>::RotationT(RotationMatrixT<T> rotationMatrix) {
 	QuaternionRotation = RotationMatrixToQuaternion(rotationMatrix);
 }
 
-Rotation::Rotation(EulerAngles eulerAngles) {
+template <typename T>
+RotationT<T>::RotationT(EulerAnglesT<T> eulerAngles) {
 	QuaternionRotation = EulerAnglesToQuaternion(eulerAngles);
 }
 
-Rotation::Rotation(Vector3D initial, Vector3D target) {
+template <typename T>
+RotationT<T>::RotationT(Vector3<T> initial, Vector3<T> target) {
 	QuaternionRotation = QuaternionFromDirectionVectors(initial, target);
 }
 
-Rotation::Rotation(YawPitchRoll ypr) {
+template <typename T>
+RotationT<T>::RotationT(YawPitchRollT<T> ypr) {
 	QuaternionRotation = YawPitchRollToQuaternion(ypr);
 }
 
-Quaternion Rotation::AxisAngleToQuaternion(AxisAngle axisAngle) {
-		double rotation = Mathematics::DegreesToRadians(axisAngle.Rotation);
-		double scale = sin(rotation / 2.0);
+template <typename T>
+QuaternionT<T> RotationT<T>::AxisAngleToQuaternion(AxisAngleT<T> axisAngle) {
+		T rotation = Mathematics::DegreesToRadians(axisAngle.Rotation);
+		T scale, c;
 
-		return Quaternion(
-			cos(rotation / 2.0),
+		Trigonometry::SinCos(rotation / T(2), scale, c);
+
+		return QuaternionT<T>(
+			c,
 			axisAngle.Axis.X * scale,
 			axisAngle.Axis.Y * scale,
 			axisAngle.Axis.Z * scale
 		);
 }
 
-Quaternion Rotation::DirectionAngleToQuaternion(DirectionAngle directionAngle) {
-	Vector3D right =   Vector3D(1, 0, 0);
-	Vector3D up =      Vector3D(0, 1, 0);
-	Vector3D forward = Vector3D(0, 0, 1);
+template <typename T>
+QuaternionT<T> RotationT<T>::DirectionAngleToQuaternion(DirectionAngleT<T> directionAngle) {
+	Vector3<T> right =   Vector3<T>(1, 0, 0);
+	Vector3<T> up =      Vector3<T>(0, 1, 0);
+	Vector3<T> forward = Vector3<T>(0, 0, 1);
 
 	directionAngle.Direction.UnitSphere();
 
-	Vector3D rotatedRight;
-	Vector3D rotatedUp = Vector3D(directionAngle.Direction);
-	Vector3D rotatedForward;
+	Vector3<T> rotatedRight;
+	Vector3<T> rotatedUp = Vector3<T>(directionAngle.Direction);
+	Vector3<T> rotatedForward;
+
+	QuaternionT<T> rotationChange = QuaternionFromDirectionVectors(up, rotatedUp);
 
-	Quaternion rotationChange = QuaternionFromDirectionVectors(up, rotatedUp);
+	//Matrix3 is double only, a float rotation rounds its products
+	Matrix3 angleRotation = Matrix3::RotationY(-directionAngle.Rotation);
 
-	Vector3D rightAngleRotated = RotationMatrix::RotateVector(Vector3D(0, -directionAngle.Rotation, 0), right);
-	Vector3D forwardAngleRotated = RotationMatrix::RotateVector(Vector3D(0, -directionAngle.Rotation, 0), forward);
+	Vector3<T> rightAngleRotated = Vector3<T>(angleRotation.Multiply(Vector3D(right)));
+	Vector3<T> forwardAngleRotated = Vector3<T>(angleRotation.Multiply(Vector3D(forward)));
 
 	rotatedRight = rotationChange.RotateVector(rightAngleRotated);
 	rotatedForward = rotationChange.RotateVector(forwardAngleRotated);
 
-	return RotationMatrixToQuaternion(RotationMatrix(rotatedRight, rotatedUp, rotatedForward)).UnitQuaternion();
+	return RotationMatrixToQuaternion(RotationMatrixT<T>(rotatedRight, rotatedUp, rotatedForward)).UnitQuaternion();
 }
 
-Quaternion Rotation::RotationMatrixToQuaternion(RotationMatrix rM) {
-	Quaternion q = Quaternion();
+template <typename T>
+QuaternionT<T> RotationT<T>::RotationMatrixToQuaternion(RotationMatrixT<T> rM) {
+	QuaternionT<T> q = QuaternionT<T>();
 
-	Vector3D X = Vector3D(rM.XAxis);
-	Vector3D Y = Vector3D(rM.YAxis);
-	Vector3D Z = Vector3D(rM.ZAxis);
+	Vector3<T> X = Vector3<T>(rM.XAxis);
+	Vector3<T> Y = Vector3<T>(rM.YAxis);
+	Vector3<T> Z = Vector3<T>(rM.ZAxis);
 
-	double matrixTrace = X.X + Y.Y + Z.Z;
-	double square;
+	T matrixTrace = X.X + Y.Y + Z.Z;
+	T square;
 
 	if (matrixTrace > 0)//standard procedure
 	{
-		square = sqrt(1.0 + matrixTrace) * 2.0;//4 * qw
+		square = std::sqrt(T(1) + matrixTrace) * T(2);//4 * qw
 
-		q.W = 0.25 * square;
+		q.W = T(0.25) * square;
 		q.X = (Z.Y - Y.Z) / square;
 		q.Y = (X.Z - Z.X) / square;
 		q.Z = (Y.X - X.Y) / square;
 	}
 	else if ((X.X > Y.Y) && (X.X > Z.Z))
 	{
-		square = sqrt(1.0 + X.X - Y.Y - Z.Z) * 2.0;//4 * qx
+		square = std::sqrt(T(1) + X.X - Y.Y - Z.Z) * T(2);//4 * qx
 
 		q.W = (Z.Y - Y.Z) / square;
-		q.X = 0.25 * square;
+		q.X = T(0.25) * square;
 		q.Y = (X.Y + Y.X) / square;
 		q.Z = (X.Z + Z.X) / square;
 	}
 	else if (Y.Y > Z.Z)
 	{
-		square = sqrt(1.0 + Y.Y - X.X - Z.Z) * 2.0;//4 * qy
+		square = std::sqrt(T(1) + Y.Y - X.X - Z.Z) * T(2);//4 * qy
 
 		q.W = (X.Z - Z.X) / square;
 		q.X = (X.Y + Y.X) / square;
-		q.Y = 0.25 * square;
+		q.Y = T(0.25) * square;
 		q.Z = (Y.Z + Z.Y) / square;
 	}
 	else
 	{
-		square = sqrt(1.0 + Z.Z - X.X - Y.Y) * 2.0;//4 * qz
+		square = std::sqrt(T(1) + Z.Z - X.X - Y.Y) * T(2);//4 * qz
 
 		q.W = (Y.X - X.Y) / square;
 		q.X = (X.Z + Z.X) / square;
 		q.Y = (Y.Z + Z.Y) / square;
-		q.Z = 0.25 * square;
+		q.Z = T(0.25) * square;
 	}
 
 	return q.UnitQuaternion().Conjugate();
 }
 
-Quaternion Rotation::EulerAnglesToQuaternion(EulerAngles eulerAngles) {
-	Quaternion q = Quaternion(1, 0, 0, 0);
-	double sx, sy, sz, cx, cy, cz, cc, cs, sc, ss;
+template <typename T>
+QuaternionT<T> RotationT<T>::EulerAnglesToQuaternion(EulerAnglesT<T> eulerAngles) {
+	return EulerConversion::ToQuaternion(eulerAngles);
+}
 
-	eulerAngles.Angles.X = Mathematics::DegreesToRadians(eulerAngles.Angles.X);
-	eulerAngles.Angles.Y = Mathematics::DegreesToRadians(eulerAngles.Angles.Y);
-	eulerAngles.Angles.Z = Mathematics::DegreesToRadians(eulerAngles.Angles.Z);
+template <typename T>
+QuaternionT<T> RotationT<T>::YawPitchRollToQuaternion(YawPitchRollT<T> ypr) {
+	std::cout << "YPR to Quaternion not implemented." << std::endl;
 
-	if (eulerAngles.Order.FrameTaken == EulerOrder::AxisFrame::Rotating)
-	{
-		double t = eulerAngles.Angles.X;
-		eulerAngles.Angles.X = eulerAngles.Angles.Z;
-		eulerAngles.Angles.Z = t;
-	}
+	return QuaternionT<T>();
+}
 
-	if (eulerAngles.Order.AxisPermutation == EulerOrder::Parity::Odd)
-	{
-		eulerAngles.Angles.Y = -eulerAngles.Angles.Y;
-	}
+template <typename T>
+EulerAnglesT<T> RotationT<T>::RotationMatrixToEulerAngles(RotationMatrixT<T> rM, EulerOrder order) {
+	return EulerConversion::ToEulerAngles(rM, order);
+}
+
+template <typename T>
+RotationMatrixT<T> RotationT<T>::EulerAnglesToRotationMatrix(EulerAnglesT<T> eulerAngles) {
+	return EulerConversion::ToRotationMatrix(eulerAngles);
+}
 
-	sx = sin(eulerAngles.Angles.X * 0.5);
-	sy = sin(eulerAngles.Angles.Y * 0.5);
-	sz = sin(eulerAngles.Angles.Z * 0.5);
+template <typename T>
+QuaternionT<T> RotationT<T>::QuaternionFromDirectionVectors(Vector3<T> initial, Vector3<T> target) {
+	QuaternionT<T> q = QuaternionT<T>(1, 0, 0, 0);
+	Vector3<T> tempV = Vector3<T>(0, 0, 0);
+	Vector3<T> xAxis = Vector3<T>(1, 0, 0);
+	Vector3<T> yAxis = Vector3<T>(0, 1, 0);
 
-	cx = cos(eulerAngles.Angles.X * 0.5);
-	cy = cos(eulerAngles.Angles.Y * 0.5);
-	cz = cos(eulerAngles.Angles.Z * 0.5);
+	T dot = Vector3<T>::DotProduct(initial, target);
 
-	cc = cx * cz;
-	cs = cx * sz;
-	sc = sx * cz;
-	ss = sx * sz;
+	if (dot < T(-0.999999))
+	{
+		tempV = Vector3<T>::CrossProduct(xAxis, initial);
+
+		if (tempV.GetLength() < T(0.000001))
+		{
+			tempV = Vector3<T>::CrossProduct(yAxis, initial);
+		}
+
+		tempV = tempV.UnitSphere();
 
-	if (eulerAngles.Order.InitialAxisRepetition == EulerOrder::AxisRepetition::Yes)
+		q = RotationT(AxisAngleT<T>(T(Mathematics::PI), tempV)).GetQuaternion();
+	}
+	else if (dot > T(0.999999))
 	{
-		q.X = cy * (cs + sc);
-		q.Y = sy * (cc + ss);
-		q.Z = sy * (cs - sc);
-		q.W = cy * (cc - ss);
+		q.W = 1.0;
+		q.X = 0.0;
+		q.Y = 0.0;
+		q.Z = 0.0;
 	}
 	else
 	{
-		q.X = cy * sc - sy * cs;
-		q.Y = cy * ss + sy * cc;
-		q.Z = cy * cs - sy * sc;
-		q.W = cy * cc + sy * ss;
-	}
+		tempV = Vector3<T>::CrossProduct(initial, target);
 
-	q.Permutate(eulerAngles.Order.Permutation);
+		q.W = T(1) + dot;
+		q.X = tempV.X;
+		q.Y = tempV.Y;
+		q.Z = tempV.Z;
 
-	if (eulerAngles.Order.AxisPermutation == EulerOrder::Parity::Odd)
-	{
-		q.Y = -q.Y;
+		q = q.UnitQuaternion();
 	}
 
 	return q;
 }
 
-Quaternion Rotation::YawPitchRollToQuaternion(YawPitchRoll ypr) {
-	std::cout << "YPR to Quaternion not implemented." << std::endl;
-
-	return Quaternion();
+template <typename T>
+QuaternionT<T> RotationT<T>::GetQuaternion() const {
+	return QuaternionRotation;
 }
 
-EulerAngles Rotation::RotationMatrixToEulerAngles(RotationMatrix rM, EulerOrder order) {
-	EulerAngles eulerAngles = EulerAngles(Vector3D(0, 0, 0), order);
-	//Vector3D p = order.Permutation;
+template <typename T>
+void RotationT<T>::SetQuaternion(QuaternionT<T> quaternion) {
+	QuaternionRotation = quaternion;
+	cached = 0;
+}
 
-	if (order.InitialAxisRepetition == EulerOrder::AxisRepetition::Yes)
-	{
-		double sy = sqrt(pow(rM.XAxis.Y, 2.0) + pow(rM.XAxis.Z, 2.0));
+//Counts the request, the caller fills the entry and sets its bit on a miss
+template <typename T>
+bool RotationT<T>::IsCached(CacheEntry entry) {
+	Trigonometry::Policy policy = Trigonometry::GetPolicy();
 
-		if (sy > 32.0 * std::numeric_limits<double>::epsilon())//16 * float.Epsilon
-		{
-			eulerAngles.Angles.X = atan2(rM.XAxis.Y, rM.XAxis.Z);
-			eulerAngles.Angles.Y = atan2(sy, rM.XAxis.X);
-			eulerAngles.Angles.Z = atan2(rM.YAxis.X, -rM.ZAxis.X);
-		}
-		else
-		{
-			eulerAngles.Angles.X = atan2(-rM.YAxis.Z, rM.YAxis.Y);
-			eulerAngles.Angles.Y = atan2(sy, rM.XAxis.X);
-			eulerAngles.Angles.Z = 0;
-		}
+	if (policy != cachePolicy) {
+		cached = 0;
+		cachePolicy = policy;
 	}
-	else
-	{
-		double cy = sqrt(pow(rM.XAxis.X, 2.0) + pow(rM.YAxis.X, 2.0));
 
-		if (cy > 32.0 * std::numeric_limits<double>::epsilon())
-		{
-			eulerAngles.Angles.X = atan2( rM.ZAxis.Y, rM.ZAxis.Z);
-			eulerAngles.Angles.Y = atan2(-rM.ZAxis.X, cy);
-			eulerAngles.Angles.Z = atan2( rM.YAxis.X, rM.XAxis.X);
-		}
-		else
-		{
-			eulerAngles.Angles.X = atan2(-rM.YAxis.Z, rM.YAxis.Y);
-			eulerAngles.Angles.Y = atan2(-rM.ZAxis.X, cy);
-			eulerAngles.Angles.Z = 0;
-		}
-	}
+	if (cached & entry) {
+		cacheHits++;
 
-	if (order.AxisPermutation == EulerOrder::Parity::Odd)
-	{
-		eulerAngles.Angles.X = -eulerAngles.Angles.X;
-		eulerAngles.Angles.Y = -eulerAngles.Angles.Y;
-		eulerAngles.Angles.Z = -eulerAngles.Angles.Z;
+		return true;
 	}
 
-	if (order.FrameTaken == EulerOrder::AxisFrame::Rotating)
-	{
-		double temp = eulerAngles.Angles.X;
-		eulerAngles.Angles.X = eulerAngles.Angles.Z;
-		eulerAngles.Angles.Z = temp;
-	}
-
-	eulerAngles.Angles.X = Mathematics::RadiansToDegrees(eulerAngles.Angles.X);
-	eulerAngles.Angles.Y = Mathematics::RadiansToDegrees(eulerAngles.Angles.Y);
-	eulerAngles.Angles.Z = Mathematics::RadiansToDegrees(eulerAngles.Angles.Z);
+	cacheMisses++;
 
-	return eulerAngles;
+	return false;
 }
 
-RotationMatrix Rotation::EulerAnglesToRotationMatrix(EulerAngles eulerAngles) {
-	RotationMatrix rM = RotationMatrix(Vector3D(0, 0, 0));
-	double sx, sy, sz, cx, cy, cz, cc, cs, sc, ss; 
-	//Vector3D p = eulerAngles.Order.Permutation;
-
-	eulerAngles.Angles.X = Mathematics::DegreesToRadians(eulerAngles.Angles.X);
-	eulerAngles.Angles.Y = Mathematics::DegreesToRadians(eulerAngles.Angles.Y);
-	eulerAngles.Angles.Z = Mathematics::DegreesToRadians(eulerAngles.Angles.Z);
+template <typename T>
+bool RotationT<T>::IsSameOrder(const EulerOrder& a, const EulerOrder& b) {
+	return a.InitialAxis == b.InitialAxis && a.AxisPermutation == b.AxisPermutation &&
+		a.InitialAxisRepetition == b.InitialAxisRepetition && a.FrameTaken == b.FrameTaken;
+}
 
-	if (eulerAngles.Order.FrameTaken == EulerOrder::AxisFrame::Rotating)
-	{
-		double t = eulerAngles.Angles.X;
-		eulerAngles.Angles.X = eulerAngles.Angles.Z;
-		eulerAngles.Angles.Z = t;
+template <typename T>
+AxisAngleT<T> RotationT<T>::GetAxisAngle() {
+	if (!IsCached(CachedAxisAngle)) {
+		axisAngle = CalculateAxisAngle();
+		cached |= CachedAxisAngle;
 	}
 
-	if (eulerAngles.Order.AxisPermutation == EulerOrder::Parity::Odd)
-	{
-		eulerAngles.Angles.X = -eulerAngles.Angles.X;
-		eulerAngles.Angles.Y = -eulerAngles.Angles.Y;
-		eulerAngles.Angles.Z = -eulerAngles.Angles.Z;
-	}
+	return axisAngle;
+}
 
-	sx = sin(eulerAngles.Angles.X);
-	sy = sin(eulerAngles.Angles.Y);
-	sz = sin(eulerAngles.Angles.Z);
-	cx = cos(eulerAngles.Angles.X);
-	cy = cos(eulerAngles.Angles.Y);
-	cz = cos(eulerAngles.Angles.Z);
+template <typename T>
+DirectionAngleT<T> RotationT<T>::GetDirectionAngle() {
+	if (!IsCached(CachedDirectionAngle)) {
+		directionAngle = CalculateDirectionAngle();
+		cached |= CachedDirectionAngle;
+	}
 
-	cc = cx * cz;
-	cs = cx * sz;
-	sc = sx * cz;
-	ss = sx * sz;
+	return directionAngle;
+}
 
-	if (eulerAngles.Order.InitialAxisRepetition == EulerOrder::AxisRepetition::Yes)
-	{
-		rM.XAxis.X = cy;       rM.XAxis.Y = sy * sx;       rM.XAxis.Z = sy * cx;
-		rM.YAxis.X = sy * sz;  rM.YAxis.Y = -cy * ss + cc; rM.YAxis.Z = -cy * cs - sc;
-		rM.ZAxis.X = -sy * cz; rM.ZAxis.Y = cy * sc + cs;  rM.ZAxis.Z = cy * cc - ss;
-	}
-	else
-	{
-		rM.XAxis.X = cy * cz;  rM.XAxis.Y = sy * sc - cs;  rM.XAxis.Z = sy * cc + ss;
-		rM.YAxis.X = cy * sz;  rM.YAxis.Y = sy * ss + cc;  rM.YAxis.Z = sy * cs - sc;
-		rM.ZAxis.X = -sy;      rM.ZAxis.Y = cy * sx;       rM.ZAxis.Z = cy * cx;
+template <typename T>
+RotationMatrixT<T> RotationT<T>::GetRotationMatrix() {
+	if (!IsCached(CachedRotationMatrix)) {
+		rotationMatrix = CalculateRotationMatrix();
+		cached |= CachedRotationMatrix;
 	}
 
-	return rM;
+	return rotationMatrix;
 }
 
-Quaternion Rotation::QuaternionFromDirectionVectors(Vector3D initial, Vector3D target) {
-	Quaternion q = Quaternion(1, 0, 0, 0);
-	Vector3D tempV = Vector3D(0, 0, 0);
-	Vector3D xAxis = Vector3D(1, 0, 0);
-	Vector3D yAxis = Vector3D(0, 1, 0);
+template <typename T>
+RotationMatrixT<T> RotationT<T>::EulerRotationMatrix() {
+	if (!IsCached(CachedEulerMatrix)) {
+		eulerMatrix = CalculateEulerRotationMatrix();
+		cached |= CachedEulerMatrix;
+	}
 
-	double dot = Vector3D::DotProduct(initial, target);
+	return eulerMatrix;
+}
 
-	if (dot < -0.999999)
-	{
-		tempV = Vector3D::CrossProduct(xAxis, initial);
+template <typename T>
+EulerAnglesT<T> RotationT<T>::GetEulerAngles(EulerOrder order) {
+	if (!IsSameOrder(eulerAngles.Order, order)) cached &= ~CachedEulerAngles;
 
-		if (tempV.GetLength() < 0.000001)
-		{
-			tempV = Vector3D::CrossProduct(yAxis, initial);
-		}
+	if (!IsCached(CachedEulerAngles)) {
+		eulerAngles = RotationMatrixToEulerAngles(EulerRotationMatrix(), order);
+		cached |= CachedEulerAngles;
+	}
 
-		tempV = tempV.UnitSphere();
+	return eulerAngles;
+}
 
-		q = Rotation(AxisAngle(Mathematics::PI, tempV)).GetQuaternion();
-	}
-	else if (dot > 0.999999)
-	{
-		q.W = 1.0;
-		q.X = 0.0;
-		q.Y = 0.0;
-		q.Z = 0.0;
+template <typename T>
+YawPitchRollT<T> RotationT<T>::GetYawPitchRoll() {
+	if (!IsCached(CachedYawPitchRoll)) {
+		yawPitchRoll = CalculateYawPitchRoll();
+		cached |= CachedYawPitchRoll;
 	}
-	else
-	{
-		tempV = Vector3D::CrossProduct(initial, target);
 
-		q.W = 1.0 + dot;
-		q.X = tempV.X;
-		q.Y = tempV.Y;
-		q.Z = tempV.Z;
+	return yawPitchRoll;
+}
 
-		q = q.UnitQuaternion();
-	}
+template <typename T>
+unsigned long long RotationT<T>::GetCacheHits() {
+	return cacheHits;
+}
 
-	return q;
+template <typename T>
+unsigned long long RotationT<T>::GetCacheMisses() {
+	return cacheMisses;
 }
 
-Quaternion Rotation::GetQuaternion() {
-	return QuaternionRotation;
+template <typename T>
+void RotationT<T>::ResetCacheCounters() {
+	cacheHits = 0;
+	cacheMisses = 0;
 }
 
-AxisAngle Rotation::GetAxisAngle() {
-	AxisAngle axisAngle = AxisAngle(0, 0, 1, 0);
-	Quaternion q = QuaternionRotation;
+template <typename T>
+AxisAngleT<T> RotationT<T>::CalculateAxisAngle() {
+	AxisAngleT<T> axisAngle = AxisAngleT<T>(0, 0, 1, 0);
+	QuaternionT<T> q = QuaternionRotation;
 
-	q = (std::abs(q.W) > 1.0) ? q.UnitQuaternion() : q;
+	q = (std::abs(q.W) > T(1)) ? q.UnitQuaternion() : q;
 
-	axisAngle.Rotation = Mathematics::RadiansToDegrees(2.0 * acos(q.W));
+	axisAngle.Rotation = Mathematics::RadiansToDegrees(T(2) * Trigonometry::Acos(q.W));
 
-	double quaternionCheck = sqrt(1.0 - pow(q.W, 2.0));//Prevents rotation jumps, and division by zero
+	T quaternionCheck = std::sqrt(T(1) - Trigonometry::Pow(q.W, T(2)));//Prevents rotation jumps, and division by zero
 
-	if (quaternionCheck >= 0.001)//Prevents division by zero
+	if (quaternionCheck >= T(0.001))//Prevents division by zero
 	{
 		//Normalizes axis
 		axisAngle.Axis.X = q.X / quaternionCheck;
@@ -366,76 +348,85 @@ AxisAngle Rotation::GetAxisAngle() {
 	return axisAngle;
 }
 
-DirectionAngle Rotation::GetDirectionAngle() {
-	Quaternion q = QuaternionRotation.UnitQuaternion();
-	Vector3D up = Vector3D(0, 1, 0);//up vector
-	Vector3D right = Vector3D(1, 0, 0);
-	Vector3D rotatedUp = q.RotateVector(up);//new direction vector
-	Vector3D rotatedRight = q.RotateVector(right);
-	Quaternion rotationChange = QuaternionFromDirectionVectors(up, rotatedUp);
+template <typename T>
+DirectionAngleT<T> RotationT<T>::CalculateDirectionAngle() {
+	QuaternionT<T> q = QuaternionRotation.UnitQuaternion();
+	Vector3<T> up = Vector3<T>(0, 1, 0);//up vector
+	Vector3<T> right = Vector3<T>(1, 0, 0);
+	Vector3<T> rotatedUp = q.RotateVector(up);//new direction vector
+	Vector3<T> rotatedRight = q.RotateVector(right);
+	QuaternionT<T> rotationChange = QuaternionFromDirectionVectors(up, rotatedUp);
 
 	//rotate forward vector by direction vector rotation
-	Vector3D rightXZCompensated = rotationChange.UnrotateVector(rotatedRight);//should only be two points on circle, compare against right
+	Vector3<T> rightXZCompensated = rotationChange.UnrotateVector(rotatedRight);//should only be two points on circle, compare against right
 
 																			  //define angles that define the forward vector, and the rotated then compensated forward vector
-	double rightAngle = Mathematics::RadiansToDegrees(atan2(right.Z, right.X));//forward as zero
-	double rightRotatedAngle = Mathematics::RadiansToDegrees(atan2(rightXZCompensated.Z, rightXZCompensated.X));//forward as zero
+	T rightAngle = Mathematics::RadiansToDegrees(Trigonometry::Atan2(right.Z, right.X));//forward as zero
+	T rightRotatedAngle = Mathematics::RadiansToDegrees(Trigonometry::Atan2(rightXZCompensated.Z, rightXZCompensated.X));//forward as zero
 
 																										 //angle about the axis defined by the direction of the object
-	double angle = rightAngle - rightRotatedAngle;
+	T angle = rightAngle - rightRotatedAngle;
 
 	//returns the angle rotated about the rotated up vector as an axis
-	return DirectionAngle(angle, rotatedUp);
+	return DirectionAngleT<T>(angle, rotatedUp);
 }
 
-RotationMatrix Rotation::GetRotationMatrix() {
-	Vector3D X = Vector3D(1, 0, 0);
-	Vector3D Y = Vector3D(0, 1, 0);
-	Vector3D Z = Vector3D(0, 0, 1);
+template <typename T>
+RotationMatrixT<T> RotationT<T>::CalculateRotationMatrix() {
+	Vector3<T> X = Vector3<T>(1, 0, 0);
+	Vector3<T> Y = Vector3<T>(0, 1, 0);
+	Vector3<T> Z = Vector3<T>(0, 0, 1);
 
-	return RotationMatrix(
+	return RotationMatrixT<T>(
 		QuaternionRotation.RotateVector(X),
 		QuaternionRotation.RotateVector(Y),
 		QuaternionRotation.RotateVector(Z)
 	);
 }
 
-EulerAngles Rotation::GetEulerAngles(EulerOrder order) {
-	Quaternion q = Quaternion(QuaternionRotation);
+template <typename T>
+RotationMatrixT<T> RotationT<T>::CalculateEulerRotationMatrix() {
+	QuaternionT<T> q = QuaternionT<T>(QuaternionRotation);
 
-	double norm = q.Normal();
-	double scale = norm > 0.0 ? 2.0 / norm : 0.0;
-	Vector3D X, Y, Z;
+	T norm = q.Normal();
+	T scale = norm > T(0) ? T(2) / norm : T(0);
+	Vector3<T> X, Y, Z;
 
-	Vector3D s = Vector3D(q.X * scale, q.Y * scale, q.Z * scale);
-	Vector3D w = Vector3D(q.W * s.X, q.W * s.Y, q.W * s.Z);
-	Vector3D x = Vector3D(q.X * s.X, q.X * s.Y, q.X * s.Z);
-	Vector3D y = Vector3D(0.0, q.Y * s.Y, q.Y * s.Z);
-	Vector3D z = Vector3D(0.0, 0.0, q.Z * s.Z);
+	Vector3<T> s = Vector3<T>(q.X * scale, q.Y * scale, q.Z * scale);
+	Vector3<T> w = Vector3<T>(q.W * s.X, q.W * s.Y, q.W * s.Z);
+	Vector3<T> x = Vector3<T>(q.X * s.X, q.X * s.Y, q.X * s.Z);
+	Vector3<T> y = Vector3<T>(0.0, q.Y * s.Y, q.Y * s.Z);
+	Vector3<T> z = Vector3<T>(0.0, 0.0, q.Z * s.Z);
 
 	//0X, 1Y, 2Z, 3W
-	X.X = 1.0 - (y.Y + z.Z);   Y.X = x.Y - w.Z;           Z.X = x.Z + w.Y;
-	Y.X = x.Y + w.Z;           Y.Y = 1.0 - (x.X + z.Z);   Z.Y = y.Z - w.X;
-	Z.X = x.Z - w.Y;           Y.Z = y.Z + w.X;           Z.Z = 1.0 - (x.X + y.Y);
+	X.X = T(1) - (y.Y + z.Z);   Y.X = x.Y - w.Z;           Z.X = x.Z + w.Y;
+	Y.X = x.Y + w.Z;           Y.Y = T(1) - (x.X + z.Z);   Z.Y = y.Z - w.X;
+	Z.X = x.Z - w.Y;           Y.Z = y.Z + w.X;           Z.Z = T(1) - (x.X + y.Y);
 
-	return RotationMatrixToEulerAngles(RotationMatrix(X, Y, Z), order);
+	return RotationMatrixT<T>(X, Y, Z);
 }
 
-YawPitchRoll Rotation::GetYawPitchRoll() {
-	Quaternion q = QuaternionRotation;
+
+template <typename T>
+YawPitchRollT<T> RotationT<T>::CalculateYawPitchRoll() {
+	QuaternionT<T> q = QuaternionRotation;
 
 	//EulerAngles ea = Rotation(q).GetEulerAngles(EulerConstants::EulerOrderZXZR);
 
 	//ea.Angles;
 
 	//intrinsic tait-bryan rotation of order XYZ
-	double yaw =  atan2( 2.0 * (q.Y * q.Z + q.W * q.X), pow(q.W, 2) - pow(q.X, 2) - pow(q.Y, 2) + pow(q.Z, 2));
-	double pitch = asin(-2.0 * (q.X * q.Z - q.W * q.Y));
-	double roll = atan2( 2.0 * (q.X * q.Y + q.W * q.Z), pow(q.W, 2) + pow(q.X, 2) - pow(q.Y, 2) - pow(q.Z, 2));
+	T yaw =  Trigonometry::Atan2( T(2) * (q.Y * q.Z + q.W * q.X), Trigonometry::Pow(q.W, T(2)) - Trigonometry::Pow(q.X, T(2)) - Trigonometry::Pow(q.Y, T(2)) + Trigonometry::Pow(q.Z, T(2)));
+	T pitch = Trigonometry::Asin(T(-2) * (q.X * q.Z - q.W * q.Y));
+	T roll = Trigonometry::Atan2( T(2) * (q.X * q.Y + q.W * q.Z), Trigonometry::Pow(q.W, T(2)) + Trigonometry::Pow(q.X, T(2)) - Trigonometry::Pow(q.Y, T(2)) - Trigonometry::Pow(q.Z, T(2)));
 
 	yaw = Mathematics::RadiansToDegrees(yaw);
 	pitch = Mathematics::RadiansToDegrees(pitch);
 	roll = Mathematics::RadiansToDegrees(roll);
 
-	return YawPitchRoll(yaw, pitch, roll);
-}
\ No newline at end of file
+	return YawPitchRollT<T>(yaw, pitch, roll);
+}
+
+//Double for the simulation and offline tools, float for the flight build
+template class RotationT<double>;
+template class RotationT<float>;
@@ -4,39 +4,99 @@
 #include "DirectionAngle.h"
 #include "EulerAngles.h"
 #include "EulerConstants.h"
+#include "EulerConversion.h"
 #include "Quaternion.h"
 #include "RotationMatrix.h"
+#include "Trigonometry.h"
 #include "Vector.h"
 #include "YawPitchRoll.h"
 
-class Rotation {
+//Scalar type as in Vector3, named RotationT so the double alias keeps the Rotation name. RotationF converts in float
+//through the float representations.
+template <typename T>
+class RotationT {
 private:
-	Quaternion QuaternionRotation;
+	QuaternionT<T> QuaternionRotation;
 
-	Quaternion AxisAngleToQuaternion(AxisAngle axisAngle);
-	Quaternion DirectionAngleToQuaternion(DirectionAngle directionAngle);
-	Quaternion RotationMatrixToQuaternion(RotationMatrix rotationMatrix);
-	Quaternion EulerAnglesToQuaternion(EulerAngles eulerAngles);
-	EulerAngles RotationMatrixToEulerAngles(RotationMatrix rM, EulerOrder order);
-	RotationMatrix EulerAnglesToRotationMatrix(EulerAngles eulerAngles);
-	Quaternion QuaternionFromDirectionVectors(Vector3D initial, Vector3D target);
-	Quaternion YawPitchRollToQuaternion(YawPitchRoll ypr);
+	//Derived representations, filled on first request and dropped when the quaternion changes. The flight loop asks
+	//for the same attitude several times a tick. Entries also drop when the trigonometry policy changes, so one
+	//policy never serves values computed under the other.
+	enum CacheEntry {
+		CachedAxisAngle = 1,
+		CachedDirectionAngle = 2,
+		CachedRotationMatrix = 4,
+		CachedEulerMatrix = 8,
+		CachedEulerAngles = 16,
+		CachedYawPitchRoll = 32
+	};
+
+	unsigned int cached = 0;
+	Trigonometry::Policy cachePolicy = Trigonometry::Exact;
+	AxisAngleT<T> axisAngle = AxisAngleT<T>(0, 0, 1, 0);
+	DirectionAngleT<T> directionAngle = DirectionAngleT<T>(0, 0, 1, 0);
+	RotationMatrixT<T> rotationMatrix = RotationMatrixT<T>(Vector3<T>(0, 0, 0));
+	RotationMatrixT<T> eulerMatrix = RotationMatrixT<T>(Vector3<T>(0, 0, 0));
+	EulerAnglesT<T> eulerAngles;
+	YawPitchRollT<T> yawPitchRoll;
+
+	static thread_local unsigned long long cacheHits;
+	static thread_local unsigned long long cacheMisses;
+
+	bool IsCached(CacheEntry entry);
+	static bool IsSameOrder(const EulerOrder& a, const EulerOrder& b);
+
+	AxisAngleT<T> CalculateAxisAngle();
+	DirectionAngleT<T> CalculateDirectionAngle();
+	RotationMatrixT<T> CalculateRotationMatrix();
+	RotationMatrixT<T> CalculateEulerRotationMatrix();
+	YawPitchRollT<T> CalculateYawPitchRoll();
+
+	QuaternionT<T> AxisAngleToQuaternion(AxisAngleT<T> axisAngle);
+	QuaternionT<T> DirectionAngleToQuaternion(DirectionAngleT<T> directionAngle);
+	QuaternionT<T> RotationMatrixToQuaternion(RotationMatrixT<T> rotationMatrix);
+	QuaternionT<T> EulerAnglesToQuaternion(EulerAnglesT<T> eulerAngles);
+	EulerAnglesT<T> RotationMatrixToEulerAngles(RotationMatrixT<T> rM, EulerOrder order);
+	RotationMatrixT<T> EulerAnglesToRotationMatrix(EulerAnglesT<T> eulerAngles);
+	QuaternionT<T> QuaternionFromDirectionVectors(Vector3<T> initial, Vector3<T> target);
+	QuaternionT<T> YawPitchRollToQuaternion(YawPitchRollT<T> ypr);
+	RotationMatrixT<T> EulerRotationMatrix();
 
 public:
-	Rotation();
-	Rotation(Quaternion quaternion);
-	Rotation(AxisAngle axisAngle);
-	Rotation(DirectionAngle directionAngle);
-	Rotation(RotationMatrix rotationMatrix);
-	Rotation(EulerAngles eulerAngles);
-	Rotation(Vector3D initial, Vector3D target);
-	Rotation(YawPitchRoll ypr);
-
-	Quaternion GetQuaternion();
-	AxisAngle GetAxisAngle();
-	DirectionAngle GetDirectionAngle();
-	RotationMatrix GetRotationMatrix();
-	EulerAngles GetEulerAngles(EulerOrder order);
-	YawPitchRoll GetYawPitchRoll();
+	RotationT();
+	RotationT(QuaternionT<T> quaternion);
+	RotationT(AxisAngleT<T> axisAngle);
+	RotationT(DirectionAngleT<T> directionAngle);
+	RotationT(RotationMatrixT<T> rotationMatrix);
+	RotationT(EulerAnglesT<T> eulerAngles);
+	RotationT(Vector3<T> initial, Vector3<T> target);
+	RotationT(YawPitchRollT<T> ypr);
+
+	QuaternionT<T> GetQuaternion() const;
+	void SetQuaternion(QuaternionT<T> quaternion);//invalidates the cached representations
+	AxisAngleT<T> GetAxisAngle();
+	DirectionAngleT<T> GetDirectionAngle();
+	RotationMatrixT<T> GetRotationMatrix();
+	EulerAnglesT<T> GetEulerAngles(EulerOrder order);
+	YawPitchRollT<T> GetYawPitchRoll();
+
+	template <typename Order>
+	EulerAnglesT<T> GetEulerAngles() {
+		if (!IsSameOrder(eulerAngles.Order, Order::Order())) cached &= ~CachedEulerAngles;
+
+		if (!IsCached(CachedEulerAngles)) {
+			eulerAngles = EulerConversion::ToEulerAngles<Order>(EulerRotationMatrix());
+			cached |= CachedEulerAngles;
+		}
+
+		return eulerAngles;
+	}
+
+	//Totals over every Rotation of this scalar type on the calling thread
+	static unsigned long long GetCacheHits();
+	static unsigned long long GetCacheMisses();
+	static void ResetCacheCounters();
 
 };
+
+typedef RotationT<double> Rotation;
+typedef RotationT<float> RotationF;
@@ -0,0 +1,205 @@
+#include "RotationBatch.h"
+
+//SIMD::RotateVector on one lane, the same operations in the same order so the batch matches Quaternion::RotateVector
+static inline void Rotate(double w, double x, double y, double z, double vx, double vy, double vz, double &rx, double &ry, double &rz) {
+	double s = 2.0 / (w * w + x * x + y * y + z * z);
+	double tx = s * (y * vz - z * vy);
+	double ty = s * (z * vx - x * vz);
+	double tz = s * (x * vy - y * vx);
+
+	rx = vx + w * tx + (y * tz - z * ty);
+	ry = vy + w * ty + (z * tx - x * tz);
+	rz = vz + w * tz + (x * ty - y * tx);
+}
+
+//Passes write block local columns, the output arrays could alias each other and would keep the loops scalar
+static inline void Store(const double *column, double *output, int lanes) {
+	std::copy(column, column + lanes, output);
+}
+
+template <typename Function>
+void RotationBatch::ForEachBlock(int count, WorkStealingPool &pool, Function function) {
+	//Steps by the lanes taken so the index never passes end, counts near INT_MAX would overflow a step of Block
+	auto run = [&](int begin, int end) {
+		for (int i = begin; i < end;) {
+			int lanes = end - i < Block ? end - i : Block;
+
+			function(i, lanes);
+
+			i += lanes;
+		}
+	};
+
+	if (pool.GetThreadCount() <= 1 || count <= Chunk) {
+		run(0, count);
+
+		return;
+	}
+
+	//Chunk bounds in 64 bits, the last chunk's end would overflow int for counts within a chunk of INT_MAX
+	pool.Run((int)(((long long)count + Chunk - 1) / Chunk), [&](int chunk) {
+		run((int)((long long)chunk * Chunk), (int)std::min((long long)count, ((long long)chunk + 1) * Chunk));
+	});
+}
+
+void RotationBatch::ToEulerAngles(QuaternionArrays quaternions, EulerOrder order, VectorArrays angles, int count, WorkStealingPool &pool) {
+	ForEachBlock(count, pool, [&](int begin, int lanes) {
+		//Rotation::CalculateEulerRotationMatrix, its X axis keeps only the first entry
+		double xx[Block], yx[Block], yy[Block], yz[Block], zx[Block], zy[Block], zz[Block];
+
+		for (int i = 0; i < lanes; i++) {
+			double w = quaternions.W[begin + i], x = quaternions.X[begin + i], y = quaternions.Y[begin + i], z = quaternions.Z[begin + i];
+			double norm = w * w + x * x + y * y + z * z;
+			double scale = 2.0 / norm;
+
+			scale = norm > 0.0 ? scale : 0.0;
+
+			double sX = x * scale, sY = y * scale, sZ = z * scale;
+
+			xx[i] = 1.0 - (y * sY + z * sZ);
+			yx[i] = x * sY + w * sZ;
+			yy[i] = 1.0 - (x * sX + z * sZ);
+			yz[i] = y * sZ + w * sX;
+			zx[i] = x * sZ - w * sY;
+			zy[i] = y * sZ - w * sX;
+			zz[i] = 1.0 - (x * sX + y * sY);
+		}
+
+		EulerConversion::Dispatch(order, [&](auto tag) {
+			for (int i = 0; i < lanes; i++) {
+				Vector3D result = EulerConversion::ToAngles<decltype(tag)>(RotationMatrix(Vector3D(xx[i], 0, 0), Vector3D(yx[i], yy[i], yz[i]), Vector3D(zx[i], zy[i], zz[i])));
+
+				angles.X[begin + i] = result.X;
+				angles.Y[begin + i] = result.Y;
+				angles.Z[begin + i] = result.Z;
+			}
+		});
+	});
+}
+
+void RotationBatch::ToAxisAngles(QuaternionArrays quaternions, VectorArrays axes, double *rotations, int count, WorkStealingPool &pool) {
+	const double degrees = 180.0 / Mathematics::PI;
+
+	ForEachBlock(count, pool, [&](int begin, int lanes) {
+		double qw[Block], qx[Block], qy[Block], qz[Block], check[Block];
+
+		//Rotation::CalculateAxisAngle normalises only past a unit scalar part, by the normal as UnitQuaternion
+		for (int i = 0; i < lanes; i++) {
+			double w = quaternions.W[begin + i], x = quaternions.X[begin + i], y = quaternions.Y[begin + i], z = quaternions.Z[begin + i];
+			double norm = w * w + x * x + y * y + z * z;
+			double divisor = std::abs(w) > 1.0 ? norm : 1.0;
+
+			qw[i] = w / divisor;
+			qx[i] = x / divisor;
+			qy[i] = y / divisor;
+			qz[i] = z / divisor;
+		}
+
+		for (int i = 0; i < lanes; i++) {
+			rotations[begin + i] = 2.0 * Trigonometry::Acos(qw[i]) * degrees;
+			check[i] = 1.0 - Trigonometry::Pow(qw[i], 2.0);
+		}
+
+		for (int i = 0; i < lanes; i++) {
+			double c = sqrt(check[i]);
+			bool axis = c >= 0.001;//below it the axis does not matter and the division is avoided
+			double divisor = axis ? c : 1.0;
+
+			qx[i] = axis ? qx[i] / divisor : 0.0;
+			qy[i] = axis ? qy[i] / divisor : 1.0;
+			qz[i] = axis ? qz[i] / divisor : 0.0;
+		}
+
+		Store(qx, axes.X + begin, lanes);
+		Store(qy, axes.Y + begin, lanes);
+		Store(qz, axes.Z + begin, lanes);
+	});
+}
+
+void RotationBatch::ToDirectionAngles(QuaternionArrays quaternions, VectorArrays directions, double *rotations, int count, WorkStealingPool &pool) {
+	const double degrees = 180.0 / Mathematics::PI;
+
+	//Rotation::QuaternionFromDirectionVectors for the two parallel cases, constant under a policy since up is fixed
+	Quaternion flipped = Rotation(Vector3D(0, 1, 0), Vector3D(0, -1, 0)).GetQuaternion();
+	double rightAngle = Mathematics::RadiansToDegrees(Trigonometry::Atan2(0.0, 1.0));
+
+	ForEachBlock(count, pool, [&](int begin, int lanes) {
+		double upX[Block], upY[Block], upZ[Block], compensatedX[Block], compensatedZ[Block];
+		double flippedW = flipped.W, flippedX = flipped.X, flippedY = flipped.Y, flippedZ = flipped.Z;//loaded once, not per selected lane
+
+		//Rotation::CalculateDirectionAngle with the up and right vectors written out
+		for (int i = 0; i < lanes; i++) {
+			double w = quaternions.W[begin + i], x = quaternions.X[begin + i], y = quaternions.Y[begin + i], z = quaternions.Z[begin + i];
+			double norm = w * w + x * x + y * y + z * z;
+			double rightX, rightY, rightZ;
+
+			w = w / norm;
+			x = x / norm;
+			y = y / norm;
+			z = z / norm;
+
+			Rotate(w, x, y, z, 0.0, 1.0, 0.0, upX[i], upY[i], upZ[i]);
+			Rotate(w, x, y, z, 1.0, 0.0, 0.0, rightX, rightY, rightZ);
+
+			//Change from up to the rotated up, the cross product of up with it and its dot product
+			double dot = 0.0 * upX[i] + 1.0 * upY[i] + 0.0 * upZ[i];
+			double cW = 1.0 + dot;
+			double cX = 1.0 * upZ[i] - 0.0 * upY[i];
+			double cY = 0.0 * upX[i] - 0.0 * upZ[i];
+			double cZ = 0.0 * upY[i] - 1.0 * upX[i];
+			double cNorm = cW * cW + cX * cX + cY * cY + cZ * cZ;
+
+			cW = cW / cNorm;
+			cX = cX / cNorm;
+			cY = cY / cNorm;
+			cZ = cZ / cNorm;
+
+			//Rotated up already along up, or opposite to it
+			bool same = dot > 0.999999;
+
+			cW = same ? 1.0 : cW;
+			cX = same ? 0.0 : cX;
+			cY = same ? 0.0 : cY;
+			cZ = same ? 0.0 : cZ;
+
+			bool opposite = dot < -0.999999;
+
+			cW = opposite ? flippedW : cW;
+			cX = opposite ? flippedX : cX;
+			cY = opposite ? flippedY : cY;
+			cZ = opposite ? flippedZ : cZ;
+
+			double compensatedY;
+
+			Rotate(cW, -cX, -cY, -cZ, rightX, rightY, rightZ, compensatedX[i], compensatedY, compensatedZ[i]);
+		}
+
+		Store(upX, directions.X + begin, lanes);
+		Store(upY, directions.Y + begin, lanes);
+		Store(upZ, directions.Z + begin, lanes);
+
+		for (int i = 0; i < lanes; i++) {
+			rotations[begin + i] = rightAngle - Trigonometry::Atan2(compensatedZ[i], compensatedX[i]) * degrees;
+		}
+	});
+}
+
+void RotationBatch::ToRotationMatrices(QuaternionArrays quaternions, VectorArrays xAxes, VectorArrays yAxes, VectorArrays zAxes, int count, WorkStealingPool &pool) {
+	ForEachBlock(count, pool, [&](int begin, int lanes) {
+		double m[9][Block];
+
+		for (int i = 0; i < lanes; i++) {
+			double w = quaternions.W[begin + i], x = quaternions.X[begin + i], y = quaternions.Y[begin + i], z = quaternions.Z[begin + i];
+
+			Rotate(w, x, y, z, 1.0, 0.0, 0.0, m[0][i], m[1][i], m[2][i]);
+			Rotate(w, x, y, z, 0.0, 1.0, 0.0, m[3][i], m[4][i], m[5][i]);
+			Rotate(w, x, y, z, 0.0, 0.0, 1.0, m[6][i], m[7][i], m[8][i]);
+		}
+
+		double *columns[9] = { xAxes.X, xAxes.Y, xAxes.Z, yAxes.X, yAxes.Y, yAxes.Z, zAxes.X, zAxes.Y, zAxes.Z };
+
+		for (int j = 0; j < 9; j++) {
+			Store(m[j], columns[j] + begin, lanes);
+		}
+	});
+}
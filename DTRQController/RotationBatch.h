@@ -0,0 +1,50 @@
+#pragma once
+
+#include "EulerConversion.h"
+#include "EulerOrder.h"
+#include "Mathematics.h"
+#include "Quaternion.h"
+#include "Rotation.h"
+#include "Trigonometry.h"
+#include "Vector.h"
+#include "WorkStealingPool.h"
+
+//Converts recorded quaternions to the other representations in bulk, for telemetry and flight logs. Buffers are
+//structure-of-arrays, one array per component. Each block of samples takes an arithmetic pass the compiler vectorises,
+//then a lane by lane pass through the Trigonometry policy. Every output equals what Rotation returns for the same
+//quaternion. Angles are in degrees. The caller owns the WorkStealingPool and reuses it across calls, with more than one
+//thread the samples are split into chunks on it.
+class RotationBatch {
+public:
+	typedef struct QuaternionArrays {
+		const double *W;
+		const double *X;
+		const double *Y;
+		const double *Z;
+	} QuaternionArrays;
+
+	typedef struct VectorArrays {
+		double *X;
+		double *Y;
+		double *Z;
+	} VectorArrays;
+
+	//As Rotation::GetEulerAngles
+	static void ToEulerAngles(QuaternionArrays quaternions, EulerOrder order, VectorArrays angles, int count, WorkStealingPool &pool);
+
+	//As Rotation::GetAxisAngle
+	static void ToAxisAngles(QuaternionArrays quaternions, VectorArrays axes, double *rotations, int count, WorkStealingPool &pool);
+
+	//As Rotation::GetDirectionAngle
+	static void ToDirectionAngles(QuaternionArrays quaternions, VectorArrays directions, double *rotations, int count, WorkStealingPool &pool);
+
+	//As Rotation::GetRotationMatrix, one array set per axis
+	static void ToRotationMatrices(QuaternionArrays quaternions, VectorArrays xAxes, VectorArrays yAxes, VectorArrays zAxes, int count, WorkStealingPool &pool);
+
+private:
+	static const int Block = 256;//lanes per pass, the scratch columns stay in the first level cache
+	static const int Chunk = 65536;//samples per pool task
+
+	template <typename Function>
+	static void ForEachBlock(int count, WorkStealingPool &pool, Function function);
+};
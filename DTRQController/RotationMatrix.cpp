@@ -1,140 +1,70 @@
 #include "RotationMatrix.h"
 
-RotationMatrix::RotationMatrix(Vector3D axes) {
-	XAxis = Vector3D(axes.X, axes.X, axes.X);
-	YAxis = Vector3D(axes.Y, axes.Y, axes.Y);
-	ZAxis = Vector3D(axes.Z, axes.Z, axes.Z);
+template <typename T>
+RotationMatrixT<T>::RotationMatrixT(Vector3<T> axes) {
+	XAxis = Vector3<T>(axes.X, axes.X, axes.X);
+	YAxis = Vector3<T>(axes.Y, axes.Y, axes.Y);
+	ZAxis = Vector3<T>(axes.Z, axes.Z, axes.Z);
 }
 
-RotationMatrix::RotationMatrix(Vector3D X, Vector3D Y, Vector3D Z) {
+template <typename T>
+RotationMatrixT<T>::RotationMatrixT(Vector3<T> X, Vector3<T> Y, Vector3<T> Z) {
 	XAxis = X;
 	YAxis = Y;
 	ZAxis = Z;
 }
 
-Vector3D RotationMatrix::ConvertCoordinateToVector() {
-	if (didRotate)
-	{
-		return Vector3D((XAxis.X + YAxis.X + ZAxis.X), (XAxis.Y + YAxis.Y + ZAxis.Y), (XAxis.Z + YAxis.Z + ZAxis.Z));
-	}
-	else
-	{
-		return InitialVector;
-	}
-}
-
-void RotationMatrix::ReadjustMatrix() {
-	double X = (XAxis.X + YAxis.X + ZAxis.X);
-	double Y = (XAxis.Y + YAxis.Y + ZAxis.Y);
-	double Z = (XAxis.Z + YAxis.Z + ZAxis.Z);
-
-	XAxis = Vector3D(X, X, X);
-	YAxis = Vector3D(Y, Y, Y);
-	ZAxis = Vector3D(Z, Z, Z);
-}
-
-void RotationMatrix::Rotate(Vector3D rotation) {
-	if (rotation.X != 0)
-	{
-		RotateX(rotation.X);
-		didRotate = true;
-
-		if (rotation.Y != 0 || rotation.Z != 0)
-		{
-			ReadjustMatrix();
-		}
-	}
-
-	if (rotation.Y != 0)
-	{
-		RotateY(rotation.Y);
-		didRotate = true;
-
-		if (rotation.Z != 0)
-		{
-			ReadjustMatrix();
-		}
-	}
-
-	if (rotation.Z != 0)
-	{
-		RotateZ(rotation.Z);
-		didRotate = true;
-	}
-}
-
-void RotationMatrix::RotateX(double theta) {
-	double c = cos(Mathematics::DegreesToRadians(theta));
-	double s = sin(Mathematics::DegreesToRadians(theta));
-
-	XAxis = Vector3D(1, 0,  0).Multiply(XAxis);
-	YAxis = Vector3D(0, c, -s).Multiply(YAxis);
-	ZAxis = Vector3D(0, s,  c).Multiply(ZAxis);
-}
-
-void RotationMatrix::RotateY(double theta) {
-	double c = cos(Mathematics::DegreesToRadians(theta));
-	double s = sin(Mathematics::DegreesToRadians(theta));
-
-	XAxis = Vector3D( c, 0, s).Multiply(XAxis);
-	YAxis = Vector3D( 0, 1, 0).Multiply(YAxis);
-	ZAxis = Vector3D(-s, 0, c).Multiply(ZAxis);
-}
-
-void RotationMatrix::RotateZ(double theta) {
-	double c = cos(Mathematics::DegreesToRadians(theta));
-	double s = sin(Mathematics::DegreesToRadians(theta));
-
-	XAxis = Vector3D(c, -s, 0).Multiply(XAxis);
-	YAxis = Vector3D(s,  c, 0).Multiply(YAxis);
-	ZAxis = Vector3D(0,  0, 1).Multiply(ZAxis);
-}
-
-RotationMatrix RotationMatrix::Multiply(double d) {
-	return RotationMatrix {
+template <typename T>
+RotationMatrixT<T> RotationMatrixT<T>::Multiply(T d) {
+	return RotationMatrixT {
 		XAxis.Multiply(d),
 		YAxis.Multiply(d),
 		ZAxis.Multiply(d)
 	};
 }
 
-RotationMatrix RotationMatrix::Multiply(RotationMatrix rM) {
-	return RotationMatrix {
+template <typename T>
+RotationMatrixT<T> RotationMatrixT<T>::Multiply(RotationMatrixT rM) {
+	return RotationMatrixT {
 		XAxis.Multiply(rM.XAxis),
 		YAxis.Multiply(rM.YAxis),
 		ZAxis.Multiply(rM.ZAxis)
 	};
 }
 
-void RotationMatrix::RotateRelative(RotationMatrix rM) {
+template <typename T>
+void RotationMatrixT<T>::RotateRelative(RotationMatrixT rM) {
 	Multiply(rM);
 }
 
-RotationMatrix RotationMatrix::Normalize() {
-	Vector3D vz = Vector3D::CrossProduct(XAxis, YAxis);
-	Vector3D vy = Vector3D::CrossProduct(vz, XAxis);
+template <typename T>
+RotationMatrixT<T> RotationMatrixT<T>::Normalize() {
+	Vector3<T> vz = Vector3<T>::CrossProduct(XAxis, YAxis);
+	Vector3<T> vy = Vector3<T>::CrossProduct(vz, XAxis);
 
-	return RotationMatrix {
+	return RotationMatrixT {
 		XAxis.UnitSphere(),
 		vy.UnitSphere(),
 		vz.UnitSphere()
 	};
 }
 
-RotationMatrix RotationMatrix::Transpose() {
-	XAxis = Vector3D(XAxis.X, YAxis.X, ZAxis.X);
-	YAxis = Vector3D(XAxis.Y, YAxis.Y, ZAxis.Y);
-	ZAxis = Vector3D(XAxis.Z, YAxis.Z, ZAxis.Z);
+template <typename T>
+RotationMatrixT<T> RotationMatrixT<T>::Transpose() {
+	XAxis = Vector3<T>(XAxis.X, YAxis.X, ZAxis.X);
+	YAxis = Vector3<T>(XAxis.Y, YAxis.Y, ZAxis.Y);
+	ZAxis = Vector3<T>(XAxis.Z, YAxis.Z, ZAxis.Z);
 
 	return *this;
 }
 
-RotationMatrix RotationMatrix::Inverse() {
+template <typename T>
+RotationMatrixT<T> RotationMatrixT<T>::Inverse() {
 
-	RotationMatrix rM = RotationMatrix{
-		Vector3D::CrossProduct(YAxis, ZAxis),
-		Vector3D::CrossProduct(ZAxis, XAxis),
-		Vector3D::CrossProduct(XAxis, YAxis)
+	RotationMatrixT rM = RotationMatrixT{
+		Vector3<T>::CrossProduct(YAxis, ZAxis),
+		Vector3<T>::CrossProduct(ZAxis, XAxis),
+		Vector3<T>::CrossProduct(XAxis, YAxis)
 	};
 	
 	rM = Transpose().Multiply(1 / rM.Determinant());
@@ -143,34 +73,37 @@ RotationMatrix RotationMatrix::Inverse() {
 	return Multiply(1 / Determinant());
 }
 
-bool RotationMatrix::IsEqual(RotationMatrix rM) {
+template <typename T>
+bool RotationMatrixT<T>::IsEqual(RotationMatrixT rM) {
 	return XAxis.IsEqual(rM.XAxis) && YAxis.IsEqual(rM.YAxis) && ZAxis.IsEqual(rM.ZAxis);
 }
 
-double RotationMatrix::Determinant() {
+template <typename T>
+T RotationMatrixT<T>::Determinant() {
 	return XAxis.X * (YAxis.Y * ZAxis.Z - ZAxis.Y * YAxis.Z) -
 		   YAxis.X * (ZAxis.Z * XAxis.Y - ZAxis.Y * XAxis.Z) +
 		   ZAxis.X * (XAxis.Y * YAxis.Z - YAxis.Y * XAxis.Z);
 }
 
-Vector3D RotationMatrix::RotateVector(Vector3D rotate, Vector3D coordinates) {
-	//calculate rotation matrix
-	RotationMatrix matrix = RotationMatrix(coordinates);
-
-	matrix.Rotate(rotate);
-
+template <typename T>
+Vector3<T> RotationMatrixT<T>::RotateVector(Vector3<T> rotate, Vector3<T> coordinates) {
 	if (rotate.X == 0 && rotate.Y == 0 && rotate.Z == 0) {
 		return coordinates;
 	}
 	else {
-		return matrix.ConvertCoordinateToVector();
+		//Matrix3 is double only, a float rotation rounds its result
+		return Vector3<T>(Matrix3::RotationXYZ(Vector3D(rotate)).Multiply(Vector3D(coordinates)));
 	}
 }
 
-std::string RotationMatrix::ToString() {
+template <typename T>
+std::string RotationMatrixT<T>::ToString() {
 	std::string x = XAxis.ToString();
 	std::string y = YAxis.ToString();
 	std::string z = ZAxis.ToString();
 
 	return x + "\n" + y + "\n" + z + "\n";
 }
+
+template struct RotationMatrixT<double>;
+template struct RotationMatrixT<float>;
@@ -1,48 +1,44 @@
 #pragma once
 
 #include "Mathematics.h"
+#include "Matrix3.h"
 #include "Vector.h"
 
-typedef struct RotationMatrix {
+//Scalar type as in Vector3, the double alias keeps the RotationMatrix name
+template <typename T>
+struct RotationMatrixT {
 private:
-	Vector3D InitialVector;
-	bool didRotate;
-	std::vector<std::vector<double>> hMatrix;
-
-	Vector3D ConvertCoordinateToVector();
-	void ReadjustMatrix();
-	void Rotate(Vector3D rotation);
-	void RotateX(double theta);
-	void RotateY(double theta);
-	void RotateZ(double theta);
-	void RotateRelative(RotationMatrix rM);
+	void RotateRelative(RotationMatrixT rM);
 
 public:
-	Vector3D XAxis;
-	Vector3D YAxis;
-	Vector3D ZAxis;
+	Vector3<T> XAxis;
+	Vector3<T> YAxis;
+	Vector3<T> ZAxis;
 
-	RotationMatrix(Vector3D axes);
-	RotationMatrix(Vector3D X, Vector3D Y, Vector3D Z);
+	RotationMatrixT(Vector3<T> axes);
+	RotationMatrixT(Vector3<T> X, Vector3<T> Y, Vector3<T> Z);
 	
-	RotationMatrix Normalize();
-	RotationMatrix Transpose();
-	RotationMatrix Inverse();
-	RotationMatrix Multiply(double d);
-	RotationMatrix Multiply(RotationMatrix rM);
+	RotationMatrixT Normalize();
+	RotationMatrixT Transpose();
+	RotationMatrixT Inverse();
+	RotationMatrixT Multiply(T d);
+	RotationMatrixT Multiply(RotationMatrixT rM);
 
-	bool IsEqual(RotationMatrix rM);
-	double Determinant();
+	bool IsEqual(RotationMatrixT rM);
+	T Determinant();
 
-	static Vector3D RotateVector(Vector3D rotate, Vector3D coordinates);
+	static Vector3<T> RotateVector(Vector3<T> rotate, Vector3<T> coordinates);//Rotates about X, then Y, then Z in degrees
 
 	std::string ToString();
 
-	RotationMatrix operator =(RotationMatrix rM) {
+	RotationMatrixT operator =(RotationMatrixT rM) {
 		this->XAxis = rM.XAxis;
 		this->YAxis = rM.YAxis;
 		this->ZAxis = rM.ZAxis;
 
 		return *this;
 	}
-} RotationMatrix;
\ No newline at end of file
+};
+
+typedef RotationMatrixT<double> RotationMatrix;
+typedef RotationMatrixT<float> RotationMatrixF;
@@ -0,0 +1,471 @@
+#pragma once
+
+//Four lane kernels behind Vector3D and Quaternion. Quaternions are read as four contiguous scalars W, X, Y, Z and
+//vectors as three contiguous scalars X, Y, Z, a fourth vector lane is never read or written. Every kernel sums its
+//products in the same order as the scalar fallback so the AVX2 and scalar builds give identical results. Doubles
+//fill an AVX register, floats the SSE register below it. Other targets, the Raspberry Pi included, run the scalar
+//kernels, define DTRQ_SIMD_SCALAR to force them on x86 as well.
+#if !defined(DTRQ_SIMD_SCALAR) && defined(__AVX2__)
+#define DTRQ_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+class SIMD {
+private:
+#if defined(DTRQ_SIMD_AVX2)
+	//Three lanes as a pair and a single, masked moves stall on data that was just stored
+	static __m256d LoadVector(const double *v) {
+		return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(v)), _mm_load_sd(v + 2), 1);
+	}
+
+	static void StoreVector(double *v, __m256d value) {
+		_mm_storeu_pd(v, _mm256_castpd256_pd128(value));
+		_mm_store_sd(v + 2, _mm256_extractf128_pd(value, 1));
+	}
+
+	//Hamilton product with the lanes of a already broadcast
+	static __m256d Multiply(__m256d aW, __m256d aX, __m256d aY, __m256d aZ, __m256d b) {
+		__m256d xSwap = _mm256_permute_pd(b, 0x5);//X, W, Z, Y
+		__m256d ySwap = _mm256_permute2f128_pd(b, b, 0x1);//Y, Z, W, X
+		__m256d zSwap = _mm256_permute_pd(ySwap, 0x5);//Z, Y, X, W
+
+		__m256d sum = _mm256_mul_pd(aW, b);
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(aX, _mm256_xor_pd(xSwap, _mm256_set_pd( 0.0, -0.0,  0.0, -0.0))));
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(aY, _mm256_xor_pd(ySwap, _mm256_set_pd(-0.0,  0.0,  0.0, -0.0))));
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(aZ, _mm256_xor_pd(zSwap, _mm256_set_pd( 0.0,  0.0, -0.0, -0.0))));
+
+		return sum;
+	}
+
+	//ScalarRotate with each cross product as a * b.yzx - a.yzx * b, turned back to xyz, every lane rounds as the
+	//scalar term it replaces
+	static void Rotate(const double *q, const double *v, double s, double *result) {
+		__m256d w = _mm256_broadcast_sd(q);
+		__m256d u = LoadVector(q + 1);
+		__m256d uYZX = _mm256_permute4x64_pd(u, _MM_SHUFFLE(3, 0, 2, 1));
+		__m256d vector = LoadVector(v);
+
+		__m256d uv = _mm256_sub_pd(_mm256_mul_pd(u, _mm256_permute4x64_pd(vector, _MM_SHUFFLE(3, 0, 2, 1))), _mm256_mul_pd(uYZX, vector));
+		__m256d t = _mm256_mul_pd(_mm256_set1_pd(s), _mm256_permute4x64_pd(uv, _MM_SHUFFLE(3, 0, 2, 1)));
+		__m256d ut = _mm256_sub_pd(_mm256_mul_pd(u, _mm256_permute4x64_pd(t, _MM_SHUFFLE(3, 0, 2, 1))), _mm256_mul_pd(uYZX, t));
+
+		StoreVector(result, _mm256_add_pd(_mm256_add_pd(vector, _mm256_mul_pd(w, t)), _mm256_permute4x64_pd(ut, _MM_SHUFFLE(3, 0, 2, 1))));
+	}
+
+	//Single precision forms of the above in SSE registers, a quaternion of floats is exactly one. The pair moves go
+	//through __m64, which may alias floats, a double pointer would let the compiler reorder them past float accesses
+	static __m128 LoadVector(const float *v) {
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)v), _mm_load_ss(v + 2));
+	}
+
+	static void StoreVector(float *v, __m128 value) {
+		_mm_storel_pi((__m64 *)v, value);
+		_mm_store_ss(v + 2, _mm_movehl_ps(value, value));
+	}
+
+	static __m128 Multiply(__m128 aW, __m128 aX, __m128 aY, __m128 aZ, __m128 b) {
+		__m128 xSwap = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));//X, W, Z, Y
+		__m128 ySwap = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));//Y, Z, W, X
+		__m128 zSwap = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));//Z, Y, X, W
+
+		__m128 sum = _mm_mul_ps(aW, b);
+		sum = _mm_add_ps(sum, _mm_mul_ps(aX, _mm_xor_ps(xSwap, _mm_set_ps( 0.0f, -0.0f,  0.0f, -0.0f))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(aY, _mm_xor_ps(ySwap, _mm_set_ps(-0.0f,  0.0f,  0.0f, -0.0f))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(aZ, _mm_xor_ps(zSwap, _mm_set_ps( 0.0f,  0.0f, -0.0f, -0.0f))));
+
+		return sum;
+	}
+
+	static void Rotate(const float *q, const float *v, float s, float *result) {
+		__m128 w = _mm_set1_ps(q[0]);
+		__m128 u = LoadVector(q + 1);
+		__m128 uYZX = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 vector = LoadVector(v);
+
+		__m128 uv = _mm_sub_ps(_mm_mul_ps(u, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(uYZX, vector));
+		__m128 t = _mm_mul_ps(_mm_set1_ps(s), _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 0, 2, 1)));
+		__m128 ut = _mm_sub_ps(_mm_mul_ps(u, _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1))), _mm_mul_ps(uYZX, t));
+
+		StoreVector(result, _mm_add_ps(_mm_add_ps(vector, _mm_mul_ps(w, t)), _mm_shuffle_ps(ut, ut, _MM_SHUFFLE(3, 0, 2, 1))));
+	}
+#endif
+
+	template <typename T>
+	static void Rotate(const T *q, const T *v, T s, T *result) {
+		ScalarRotate(q, v, s, result);
+	}
+
+	//Row major 3x3 matrix of the same rotation, 1 - s * (y^2 + z^2) and so on
+	template <typename T>
+	static void ScaledRotationMatrix(const T *q, T s, T *matrix) {
+		T w = q[0], x = q[1], y = q[2], z = q[3];
+
+		matrix[0] = T(1) - s * (y * y + z * z);
+		matrix[1] = s * (x * y - w * z);
+		matrix[2] = s * (x * z + w * y);
+		matrix[3] = s * (x * y + w * z);
+		matrix[4] = T(1) - s * (x * x + z * z);
+		matrix[5] = s * (y * z - w * x);
+		matrix[6] = s * (x * z - w * y);
+		matrix[7] = s * (y * z + w * x);
+		matrix[8] = T(1) - s * (x * x + y * y);
+	}
+
+public:
+	static const char* Backend() {
+#if defined(DTRQ_SIMD_AVX2)
+		return "AVX2";
+#else
+		return "Scalar";
+#endif
+	}
+
+	//Hamilton product a * b
+	static void QuaternionMultiply(const double *a, const double *b, double *result) {
+#if defined(DTRQ_SIMD_AVX2)
+		_mm256_storeu_pd(result, Multiply(_mm256_broadcast_sd(a), _mm256_broadcast_sd(a + 1), _mm256_broadcast_sd(a + 2), _mm256_broadcast_sd(a + 3), _mm256_loadu_pd(b)));
+#else
+		ScalarQuaternionMultiply(a, b, result);
+#endif
+	}
+
+	//q * (0, v) * q^-1 without forming the inverse or the pure quaternion, v + s * w * (u x v) + s * u x (u x v)
+	//with u the vector part and s = 2 / normal, valid for any non-zero quaternion
+	template <typename T>
+	static void RotateVector(const T *q, const T *v, T *result) {
+		Rotate(q, v, T(2) / Dot(q, q, 4), result);
+	}
+
+	//Same rotation with s = 2, only exact when q is a unit quaternion
+	template <typename T>
+	static void RotateUnitVector(const T *q, const T *v, T *result) {
+		Rotate(q, v, T(2), result);
+	}
+
+	//Expands q into a row major 3x3 matrix, scaled by the normal so it matches RotateVector for non-unit quaternions
+	template <typename T>
+	static void RotationMatrix(const T *q, T *matrix) {
+		ScaledRotationMatrix(q, T(2) / Dot(q, q, 4), matrix);
+	}
+
+	//Same matrix with s = 2 as RotateUnitVector, only exact when q is a unit quaternion
+	template <typename T>
+	static void UnitRotationMatrix(const T *q, T *matrix) {
+		ScaledRotationMatrix(q, T(2), matrix);
+	}
+
+	//Multiplies count packed three lane vectors by a row major 3x3 matrix, input and output may be the same array
+	static void TransformVectors(const double *matrix, const double *input, double *output, int count) {
+#if defined(DTRQ_SIMD_AVX2)
+		//Columns of the matrix, each result is column0 * x + column1 * y + column2 * z
+		__m256d column0 = _mm256_set_pd(0.0, matrix[6], matrix[3], matrix[0]);
+		__m256d column1 = _mm256_set_pd(0.0, matrix[7], matrix[4], matrix[1]);
+		__m256d column2 = _mm256_set_pd(0.0, matrix[8], matrix[5], matrix[2]);
+
+		for (int i = 0; i < count; i++) {
+			const double *v = input + i * 3;
+			__m256d sum = _mm256_mul_pd(column0, _mm256_broadcast_sd(v));
+
+			sum = _mm256_add_pd(sum, _mm256_mul_pd(column1, _mm256_broadcast_sd(v + 1)));
+			sum = _mm256_add_pd(sum, _mm256_mul_pd(column2, _mm256_broadcast_sd(v + 2)));
+
+			StoreVector(output + i * 3, sum);
+		}
+#else
+		for (int i = 0; i < count; i++) {
+			ScalarTransformVector(matrix, input + i * 3, output + i * 3);
+		}
+#endif
+	}
+
+	//Divides every lane by the sum of squares, matching Quaternion::UnitQuaternion
+	static void UnitQuaternion(const double *q, double *result) {
+		double n = Dot(q, q, 4);
+
+#if defined(DTRQ_SIMD_AVX2)
+		_mm256_storeu_pd(result, _mm256_div_pd(_mm256_loadu_pd(q), _mm256_set1_pd(n)));
+#else
+		double w = q[0] / n, x = q[1] / n, y = q[2] / n, z = q[3] / n;
+
+		result[0] = w;
+		result[1] = x;
+		result[2] = y;
+		result[3] = z;
+#endif
+	}
+
+	//Sum of count products added one at a time from the first, as a sequential scalar loop. The vector forms only
+	//multiply four at once, the compiler's own in order reduction spends more on lane extracts than it saves
+	static double OrderedDot(const double *a, const double *b, int count) {
+		int i = 0;
+#if defined(DTRQ_SIMD_AVX2)
+		__m128d sum = _mm_setzero_pd();
+
+		for (; i + 4 <= count; i += 4) {
+			__m256d products = _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+			__m128d low = _mm256_castpd256_pd128(products);
+			__m128d high = _mm256_extractf128_pd(products, 1);
+
+			sum = _mm_add_sd(sum, low);
+			sum = _mm_add_sd(sum, _mm_unpackhi_pd(low, low));
+			sum = _mm_add_sd(sum, high);
+			sum = _mm_add_sd(sum, _mm_unpackhi_pd(high, high));
+		}
+
+		double result = _mm_cvtsd_f64(sum);
+#else
+		double result = 0.0;
+#endif
+
+		for (; i < count; i++) {
+			result = result + a[i] * b[i];
+		}
+
+		return result;
+	}
+
+	//Four dot products over interleaved rows of four, lane j sums a[4i + j] * b[4i + j] with i counting up. Each lane
+	//adds in the order of a sequential scalar loop, so a channel per lane gives that loop's result exactly
+	static void InterleavedDot(const double *a, const double *b, int count, double *result) {
+#if defined(DTRQ_SIMD_AVX2)
+		__m256d sum = _mm256_setzero_pd();
+
+		for (int i = 0; i < count; i++) {
+			sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(a + i * 4), _mm256_loadu_pd(b + i * 4)));
+		}
+
+		_mm256_storeu_pd(result, sum);
+#else
+		ScalarInterleavedDot(a, b, count, result);
+#endif
+	}
+
+	//Eight dot products over count interleaved rows of eight with symmetric taps, only the first (count + 1) / 2 taps
+	//are given. Lane j sums (rows[8i + j] + rows[8(count - 1 - i) + j]) * taps[i] with i counting up, then the middle
+	//row alone when count is odd, half the multiplies of the unfolded sum. Eight lanes keep two vector addition
+	//chains in flight, with four the sum waits on the latency of each add
+	static void FoldedDot(const double *rows, const double *taps, int count, double *result) {
+#if defined(DTRQ_SIMD_AVX2)
+		int half = count / 2;
+		__m256d low = _mm256_setzero_pd(), high = _mm256_setzero_pd();
+
+		for (int i = 0; i < half; i++) {
+			const double *newer = rows + i * 8;
+			const double *older = rows + (count - 1 - i) * 8;
+			__m256d tap = _mm256_broadcast_sd(taps + i);
+
+			low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(newer), _mm256_loadu_pd(older)), tap));
+			high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(newer + 4), _mm256_loadu_pd(older + 4)), tap));
+		}
+
+		if (count % 2 == 1) {
+			__m256d tap = _mm256_broadcast_sd(taps + half);
+
+			low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_loadu_pd(rows + half * 8), tap));
+			high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_loadu_pd(rows + half * 8 + 4), tap));
+		}
+
+		_mm256_storeu_pd(result, low);
+		_mm256_storeu_pd(result + 4, high);
+#else
+		ScalarFoldedDot(rows, taps, count, result);
+#endif
+	}
+
+	//Same sums in single precision, a row of eight floats is one AVX register
+	static void FoldedDot(const float *rows, const float *taps, int count, float *result) {
+#if defined(DTRQ_SIMD_AVX2)
+		int half = count / 2;
+		__m256 sum = _mm256_setzero_ps();
+
+		for (int i = 0; i < half; i++) {
+			const float *newer = rows + i * 8;
+			const float *older = rows + (count - 1 - i) * 8;
+
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(newer), _mm256_loadu_ps(older)), _mm256_broadcast_ss(taps + i)));
+		}
+
+		if (count % 2 == 1) {
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(rows + half * 8), _mm256_broadcast_ss(taps + half)));
+		}
+
+		_mm256_storeu_ps(result, sum);
+#else
+		ScalarFoldedDot(rows, taps, count, result);
+#endif
+	}
+
+	//Sum of the products of the first lanes, accumulated from lane zero upwards, lanes is 3 or 4
+	static double Dot(const double *a, const double *b, int lanes) {
+#if defined(DTRQ_SIMD_AVX2)
+		__m128d low = _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b));
+		__m128d sum = _mm_add_sd(low, _mm_unpackhi_pd(low, low));
+
+		sum = _mm_add_sd(sum, _mm_mul_sd(_mm_load_sd(a + 2), _mm_load_sd(b + 2)));
+
+		if (lanes == 4) sum = _mm_add_sd(sum, _mm_mul_sd(_mm_load_sd(a + 3), _mm_load_sd(b + 3)));
+
+		return _mm_cvtsd_f64(sum);
+#else
+		return ScalarDot(a, b, lanes);
+#endif
+	}
+
+	//Three lanes do not pay for the cross-lane shuffles, the AVX2 form measured about half the speed of the scalar
+	//one, so every backend uses the scalar kernel
+	template <typename T>
+	static void CrossProduct(const T *a, const T *b, T *result) {
+		ScalarCrossProduct(a, b, result);
+	}
+
+	static void QuaternionMultiply(const float *a, const float *b, float *result) {
+#if defined(DTRQ_SIMD_AVX2)
+		_mm_storeu_ps(result, Multiply(_mm_set1_ps(a[0]), _mm_set1_ps(a[1]), _mm_set1_ps(a[2]), _mm_set1_ps(a[3]), _mm_loadu_ps(b)));
+#else
+		ScalarQuaternionMultiply(a, b, result);
+#endif
+	}
+
+	static void UnitQuaternion(const float *q, float *result) {
+		float n = ScalarDot(q, q, 4);
+
+#if defined(DTRQ_SIMD_AVX2)
+		_mm_storeu_ps(result, _mm_div_ps(_mm_loadu_ps(q), _mm_set1_ps(n)));
+#else
+		float w = q[0] / n, x = q[1] / n, y = q[2] / n, z = q[3] / n;
+
+		result[0] = w;
+		result[1] = x;
+		result[2] = y;
+		result[3] = z;
+#endif
+	}
+
+	//Other scalar types run the reference kernels, the double and float overloads above are preferred when they match
+	template <typename T>
+	static void QuaternionMultiply(const T *a, const T *b, T *result) {
+		ScalarQuaternionMultiply(a, b, result);
+	}
+
+	template <typename T>
+	static void TransformVectors(const T *matrix, const T *input, T *output, int count) {
+		for (int i = 0; i < count; i++) {
+			ScalarTransformVector(matrix, input + i * 3, output + i * 3);
+		}
+	}
+
+	template <typename T>
+	static void UnitQuaternion(const T *q, T *result) {
+		T n = Dot(q, q, 4);
+		T w = q[0] / n, x = q[1] / n, y = q[2] / n, z = q[3] / n;
+
+		result[0] = w;
+		result[1] = x;
+		result[2] = y;
+		result[3] = z;
+	}
+
+	template <typename T>
+	static T Dot(const T *a, const T *b, int lanes) {
+		return ScalarDot(a, b, lanes);
+	}
+
+	//Reference kernels, also the fallback when no vector unit is enabled
+
+	//v + s * w * (u x v) + s * u x (u x v) as t = s * (u x v), v + w * t + u x t
+	template <typename T>
+	static void ScalarRotate(const T *q, const T *v, T s, T *result) {
+		T w = q[0], x = q[1], y = q[2], z = q[3];
+		T tx = s * (y * v[2] - z * v[1]);
+		T ty = s * (z * v[0] - x * v[2]);
+		T tz = s * (x * v[1] - y * v[0]);
+
+		T rx = v[0] + w * tx + (y * tz - z * ty);
+		T ry = v[1] + w * ty + (z * tx - x * tz);
+		T rz = v[2] + w * tz + (x * ty - y * tx);
+
+		result[0] = rx;
+		result[1] = ry;
+		result[2] = rz;
+	}
+	template <typename T>
+	static void ScalarQuaternionMultiply(const T *a, const T *b, T *result) {
+		T w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+		T x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+		T y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+		T z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+
+		result[0] = w;
+		result[1] = x;
+		result[2] = y;
+		result[3] = z;
+	}
+
+	template <typename T>
+	static void ScalarTransformVector(const T *matrix, const T *v, T *result) {
+		T x = matrix[0] * v[0] + matrix[1] * v[1] + matrix[2] * v[2];
+		T y = matrix[3] * v[0] + matrix[4] * v[1] + matrix[5] * v[2];
+		T z = matrix[6] * v[0] + matrix[7] * v[1] + matrix[8] * v[2];
+
+		result[0] = x;
+		result[1] = y;
+		result[2] = z;
+	}
+
+	template <typename T>
+	static T ScalarDot(const T *a, const T *b, int lanes) {
+		T sum = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+
+		if (lanes == 4) sum = sum + a[3] * b[3];
+
+		return sum;
+	}
+
+	template <typename T>
+	static void ScalarInterleavedDot(const T *a, const T *b, int count, T *result) {
+		T sum[4] = { 0, 0, 0, 0 };
+
+		for (int i = 0; i < count; i++) {
+			for (int j = 0; j < 4; j++) {
+				sum[j] = sum[j] + a[i * 4 + j] * b[i * 4 + j];
+			}
+		}
+
+		for (int j = 0; j < 4; j++) {
+			result[j] = sum[j];
+		}
+	}
+
+	template <typename T>
+	static void ScalarFoldedDot(const T *rows, const T *taps, int count, T *result) {
+		T sum[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		int half = count / 2;
+
+		for (int i = 0; i < half; i++) {
+			for (int j = 0; j < 8; j++) {
+				sum[j] = sum[j] + (rows[i * 8 + j] + rows[(count - 1 - i) * 8 + j]) * taps[i];
+			}
+		}
+
+		if (count % 2 == 1) {
+			for (int j = 0; j < 8; j++) {
+				sum[j] = sum[j] + rows[half * 8 + j] * taps[half];
+			}
+		}
+
+		for (int j = 0; j < 8; j++) {
+			result[j] = sum[j];
+		}
+	}
+
+	template <typename T>
+	static void ScalarCrossProduct(const T *a, const T *b, T *result) {
+		T x = a[1] * b[2] - a[2] * b[1];
+		T y = a[2] * b[0] - a[0] * b[2];
+		T z = a[0] * b[1] - a[1] * b[0];
+
+		result[0] = x;
+		result[1] = y;
+		result[2] = z;
+	}
+};
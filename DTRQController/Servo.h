@@ -6,6 +6,8 @@ private:
 
 	//DShot dShot;
 public:
+	static constexpr double Resolution = 0.1;//degrees, smallest step the PWM output resolves
+
 	Servo();
 	void SetAngle(double value);
 	double GetAngle();
@@ -1,31 +1,30 @@
 #include "Thruster.h"
 
-Thruster::Thruster(Vector3D thrusterOffset, std::string name, bool simulation, double dT) {
+Thruster::Thruster(Vector3D thrusterOffset, std::string name, bool simulation, ActuatorBank *actuators, int firstChannel, bool verbose) {
 	this->ThrusterOffset = thrusterOffset;
 	this->name = name;
 	this->simulation = simulation;
-	this->dT = dT;
+	this->actuators = actuators;
+	this->firstChannel = firstChannel;
 
 	this->CurrentPosition = Vector3D(0, 0, 0);
 	this->TargetPosition = Vector3D(0, 0, 0);
 	this->CurrentRotation = Vector3D(0, 0, 0);
+	this->heldOutput = Vector3D(0, 0, 0);
 	this->disable = false;
 	
 	if (simulation) {
-		std::cout << "  Thruster initializing in simulation mode." << std::endl;
-		this->outerCDS = new CriticallyDampedSpring(dT, 75,  "Thruster " + this->name + " outer");
-		this->innerCDS = new CriticallyDampedSpring(dT, 75,  "Thruster " + this->name + " inner");
-		this->rotorCDS = new CriticallyDampedSpring(dT, 250, "Thruster " + this->name + " rotor");
+		if (verbose) std::cout << "  Thruster initializing in simulation mode." << std::endl;
+
+		this->actuators->SetSpringConstant(firstChannel + OuterChannel, 75);
+		this->actuators->SetSpringConstant(firstChannel + InnerChannel, 75);
+		this->actuators->SetSpringConstant(firstChannel + RotorChannel, 250);
 	}
 
-	std::cout << "  Thruster " << name << ": Offset:" << thrusterOffset.ToString() << " Simulation: " << simulation << " dT:" << dT << std::endl;
+	if (verbose) std::cout << "  Thruster " << name << ": Offset:" << thrusterOffset.ToString() << " Simulation: " << simulation << std::endl;
 }
 
-Thruster::~Thruster() {
-	delete outerCDS;
-	delete innerCDS;
-	delete rotorCDS;
-}
+Thruster::~Thruster() {}
 
 Vector3D Thruster::ReturnThrustVector() {
 	Vector3D thrustVector = Vector3D(0, rotor.GetOutput(), 0);
@@ -41,6 +40,15 @@ Vector3D Thruster::ReturnThrusterOutput() {
 }
 
 void Thruster::SetThrusterOutputs(Vector3D output) {
+	SetThrusterTargets(output);
+
+	if (simulation) {
+		actuators->Step(firstChannel, ActuatorChannels);
+		ReadActuators();
+	}
+}
+
+void Thruster::SetThrusterTargets(Vector3D output) {
 	//Disable negative thrust output
 	CheckIfDisabled();
 
@@ -51,11 +59,13 @@ void Thruster::SetThrusterOutputs(Vector3D output) {
 	//Sets current rotation of thruster for use in the visualization of the quad
 	CurrentRotation = Vector3D(-outerJoint.GetAngle(), 0, -innerJoint.GetAngle());
 
+	heldOutput = output;
+
 	//Sets the outputs of the thrusters
 	if (simulation) {
-		innerJoint.SetAngle(innerCDS->Calculate(output.X));
-		rotor.SetOutput(rotorCDS->Calculate(output.Y));
-		outerJoint.SetAngle(outerCDS->Calculate(output.Z));
+		actuators->SetTarget(firstChannel + InnerChannel, 0, output.X);
+		actuators->SetTarget(firstChannel + RotorChannel, 0, output.Y);
+		actuators->SetTarget(firstChannel + OuterChannel, 0, output.Z);
 	}
 	else {
 		innerJoint.SetAngle(output.X);
@@ -64,6 +74,25 @@ void Thruster::SetThrusterOutputs(Vector3D output) {
 	}
 }
 
+void Thruster::ReadActuators() {
+	if (simulation) {
+		innerJoint.SetAngle(actuators->GetPosition(firstChannel + InnerChannel, 0));
+		rotor.SetOutput(actuators->GetPosition(firstChannel + RotorChannel, 0));
+		outerJoint.SetAngle(actuators->GetPosition(firstChannel + OuterChannel, 0));
+	}
+}
+
+//Steps the actuator dynamics again towards the last command, used between control ticks
+void Thruster::HoldThrusterOutputs() {
+	if (simulation) {
+		actuators->SetTarget(firstChannel + InnerChannel, 0, heldOutput.X);
+		actuators->SetTarget(firstChannel + RotorChannel, 0, heldOutput.Y);
+		actuators->SetTarget(firstChannel + OuterChannel, 0, heldOutput.Z);
+		actuators->Step(firstChannel, ActuatorChannels);
+		ReadActuators();
+	}
+}
+
 bool Thruster::CheckIfDisabled() {
 	disable = false;
 
@@ -72,4 +101,48 @@ bool Thruster::CheckIfDisabled() {
 
 bool Thruster::IsDisabled() {
 	return disable;
-}
\ No newline at end of file
+}
+
+void Thruster::SaveState(double *state) {
+	const Vector3D vectors[5] = { heldOutput, ReturnThrusterOutput(), CurrentPosition, TargetPosition, CurrentRotation };
+
+	for (int i = 0; i < 9; i++) {
+		state[i] = 0;
+	}
+
+	if (simulation) {
+		for (int c = 0; c < ActuatorChannels; c++) {
+			state[c] = actuators->GetPosition(firstChannel + c, 0);
+			state[ActuatorChannels + c] = actuators->GetVelocity(firstChannel + c, 0);
+			state[2 * ActuatorChannels + c] = actuators->GetTarget(firstChannel + c, 0);
+		}
+	}
+
+	for (int i = 0; i < 5; i++) {
+		state[9 + i * 3 + 0] = vectors[i].X;
+		state[9 + i * 3 + 1] = vectors[i].Y;
+		state[9 + i * 3 + 2] = vectors[i].Z;
+	}
+}
+
+void Thruster::LoadState(const double *state) {
+	Vector3D vectors[5];
+
+	for (int i = 0; i < 5; i++) {
+		vectors[i] = Vector3D(state[9 + i * 3 + 0], state[9 + i * 3 + 1], state[9 + i * 3 + 2]);
+	}
+
+	if (simulation) {
+		for (int c = 0; c < ActuatorChannels; c++) {
+			actuators->SetState(firstChannel + c, 0, state[c], state[ActuatorChannels + c], state[2 * ActuatorChannels + c]);
+		}
+	}
+
+	heldOutput = vectors[0];
+	outerJoint.SetAngle(vectors[1].X);
+	rotor.SetOutput(vectors[1].Y);
+	innerJoint.SetAngle(vectors[1].Z);
+	CurrentPosition = vectors[2];
+	TargetPosition = vectors[3];
+	CurrentRotation = vectors[4];
+}
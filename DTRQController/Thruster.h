@@ -1,6 +1,6 @@
 #pragma once
 
-#include "CriticallyDampedSpring.h"
+#include "ActuatorBank.h"
 #include "Vector.h"
 #include "Servo.h"
 #include "Motor.h"
@@ -16,11 +16,17 @@ private:
 	std::string name;
 	bool disable;
 	bool simulation;
-	double dT;
+	Vector3D heldOutput;
 
-	CriticallyDampedSpring *outerCDS;
-	CriticallyDampedSpring *innerCDS;
-	CriticallyDampedSpring *rotorCDS;
+	//Outer joint, inner joint and rotor springs from firstChannel in the bank of the owning Quadcopter, only
+	//stepped in simulation
+	ActuatorBank *actuators;
+	int firstChannel;
+	enum ActuatorChannel {
+		OuterChannel,
+		InnerChannel,
+		RotorChannel
+	};
 
 	bool CheckIfDisabled();
 public:
@@ -29,10 +35,24 @@ public:
 	Vector3D CurrentRotation;
 	Vector3D ThrusterOffset;
 
+	static const int ActuatorChannels = 3;
+
+	//Actuator springs, held output, joint and rotor outputs and the public positions
+	static const int StateSize = 9 + 3 + 3 + 9;
+
 	~Thruster();
-	Thruster(Vector3D ThrusterOffset, std::string name, bool simulation, double dT);
+	Thruster(Vector3D ThrusterOffset, std::string name, bool simulation, ActuatorBank *actuators, int firstChannel, bool verbose);
 	void SetThrusterOutputs(Vector3D output);
+	void HoldThrusterOutputs();
+
+	//SetThrusterOutputs split for owners stepping the whole bank at once, SetThrusterTargets writes the command and
+	//ReadActuators takes the joint and rotor outputs back once the bank has stepped
+	void SetThrusterTargets(Vector3D output);
+	void ReadActuators();
+
 	Vector3D ReturnThrustVector();
 	Vector3D ReturnThrusterOutput();
 	bool IsDisabled();
+	void SaveState(double *state);
+	void LoadState(const double *state);
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "TriangleWaveFader.h"
+#include "Trigonometry.h"
 
 TriangleWaveFader::TriangleWaveFader() {
 	this->curvature = 1;
@@ -11,7 +12,7 @@ TriangleWaveFader::TriangleWaveFader(double curvature, double amplitude) {
 }
 
 double TriangleWaveFader::CalculateRatio(double value) {
-	return (1.0 / amplitude) * pow((amplitude - std::abs(fmod(value,(amplitude * 2.0)) - amplitude)), curvature) / pow(amplitude, curvature - 1.0);
+	return (1.0 / amplitude) * Trigonometry::Pow((amplitude - std::abs(fmod(value,(amplitude * 2.0)) - amplitude)), curvature) / Trigonometry::Pow(amplitude, curvature - 1.0);
 
 }
 
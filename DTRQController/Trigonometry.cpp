@@ -0,0 +1,11 @@
+#include "Trigonometry.h"
+
+std::atomic<Trigonometry::Policy> Trigonometry::policy(Trigonometry::Exact);
+
+void Trigonometry::SetPolicy(Policy policy) {
+	Trigonometry::policy.store(policy, std::memory_order_relaxed);
+}
+
+Trigonometry::Policy Trigonometry::GetPolicy() {
+	return policy.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include "Mathematics.h"
+
+//Math policy for the rotation conversions. Exact calls libm and is the default, recorded flights replay bit for bit
+//with it. Approximate uses the inline polynomial kernels below, measured maximum absolute errors (TrigonometryTest):
+//  Sin, Cos, SinCos  |x| < 1e5 rad    3e-9 rad
+//  Atan2                              1e-8 rad
+//  Asin, Acos        [-1, 1]          1e-9 rad
+//  Pow               integer exponents up to 16 by repeated squaring, within 16 ulp, libm otherwise
+//All are below 1e-6 degrees against the 0.1 degree servo resolution. The policy is process wide and atomic, each call
+//reads it once with relaxed ordering, so a switch while pool threads convert is safe but may land mid conversion.
+class Trigonometry {
+public:
+	enum Policy {
+		Exact,
+		Approximate
+	};
+
+	static void SetPolicy(Policy policy);
+	static Policy GetPolicy();
+
+	static double Sin(double radians) {
+		return IsExact() ? sin(radians) : ApproximateSin(radians);
+	}
+
+	static double Cos(double radians) {
+		return IsExact() ? cos(radians) : ApproximateCos(radians);
+	}
+
+	//One range reduction for both, the conversions need each pair
+	static void SinCos(double radians, double &s, double &c) {
+		if (IsExact()) {
+			s = sin(radians);
+			c = cos(radians);
+		}
+		else {
+			ApproximateSinCos(radians, s, c);
+		}
+	}
+
+	static double Asin(double value) {
+		return IsExact() ? asin(value) : ApproximateAsin(value);
+	}
+
+	static double Acos(double value) {
+		return IsExact() ? acos(value) : ApproximateAcos(value);
+	}
+
+	static double Atan2(double y, double x) {
+		return IsExact() ? atan2(y, x) : ApproximateAtan2(y, x);
+	}
+
+	static double Pow(double base, double exponent) {
+		return IsExact() ? pow(base, exponent) : ApproximatePow(base, exponent);
+	}
+
+	//Single precision forms for RotationF and the float conversions. Exact calls the float libm functions,
+	//Approximate rounds the double kernels
+	static float Sin(float radians) {
+		return IsExact() ? std::sin(radians) : (float)ApproximateSin(radians);
+	}
+
+	static float Cos(float radians) {
+		return IsExact() ? std::cos(radians) : (float)ApproximateCos(radians);
+	}
+
+	static void SinCos(float radians, float &s, float &c) {
+		if (IsExact()) {
+			s = std::sin(radians);
+			c = std::cos(radians);
+		}
+		else {
+			double sd, cd;
+
+			ApproximateSinCos(radians, sd, cd);
+
+			s = (float)sd;
+			c = (float)cd;
+		}
+	}
+
+	static float Asin(float value) {
+		return IsExact() ? std::asin(value) : (float)ApproximateAsin(value);
+	}
+
+	static float Acos(float value) {
+		return IsExact() ? std::acos(value) : (float)ApproximateAcos(value);
+	}
+
+	static float Atan2(float y, float x) {
+		return IsExact() ? std::atan2(y, x) : (float)ApproximateAtan2(y, x);
+	}
+
+	static float Pow(float base, float exponent) {
+		return IsExact() ? std::pow(base, exponent) : (float)ApproximatePow(base, exponent);
+	}
+
+	//Reduced to [-pi/4, pi/4] by the nearest multiple of pi/2, then Chebyshev fits of sin(r)/r and cos(r) in r^2, cos(0)
+	//is held at exactly one
+	static void ApproximateSinCos(double radians, double &s, double &c) {
+		if (!(std::abs(radians) < 1e5)) {//the two part reduction loses digits beyond, also NaN and infinity
+			s = sin(radians);
+			c = cos(radians);
+
+			return;
+		}
+
+		long long quadrant = (long long)(radians * 6.36619772367581382433e-01 + (radians < 0 ? -0.5 : 0.5));
+		double k = (double)quadrant;
+		double r = (radians - k * 1.57079632673412561417e+00) - k * 6.07710050650619224932e-11;
+		double z = r * r;
+
+		double sr = r * (9.99999996917703555e-01 + z * (-1.66666506739967736e-01 + z * (8.33203578559732074e-03 + z * -1.95039042508423163e-04)));
+		double cr = 1.0 + z * (-4.99999996148576108e-01 + z * (4.16666166925329863e-02 + z * (-1.38866179996507495e-03 + z * 2.43798312514460401e-05)));
+
+		double a = (quadrant & 1) ? cr : sr;
+		double b = (quadrant & 1) ? sr : cr;
+
+		s = (quadrant & 2) ? -a : a;
+		c = ((quadrant + 1) & 2) ? -b : b;
+	}
+
+	static double ApproximateSin(double radians) {
+		double s, c;
+
+		ApproximateSinCos(radians, s, c);
+
+		return s;
+	}
+
+	static double ApproximateCos(double radians) {
+		double s, c;
+
+		ApproximateSinCos(radians, s, c);
+
+		return c;
+	}
+
+	//Octant folded to a ratio in [0, 1], then a Chebyshev fit of atan(a)/a in a^2
+	static double ApproximateAtan2(double y, double x) {
+		double ax = std::abs(x), ay = std::abs(y);
+		double maximum = ax > ay ? ax : ay;
+		double minimum = ax > ay ? ay : ax;
+
+		if (!(maximum > 0 && maximum < std::numeric_limits<double>::infinity())) return atan2(y, x);//zeros, infinity and NaN
+
+		double a = minimum / maximum;
+		double t = a * a;
+		double r = a * (9.99999981788655726e-01 + t * (-3.33330367092862734e-01 + t * (1.99918720291090403e-01 + t * (-1.41977977940849604e-01 +
+			t * (1.06183706369534443e-01 + t * (-7.45685482600401097e-02 + t * (4.21376235891892782e-02 + t * (-1.57312491221824027e-02 + t * 2.76628350176189031e-03))))))));
+
+		r = ay > ax ? 1.57079632679489661923 - r : r;
+		r = x < 0 ? 3.14159265358979323846 - r : r;
+
+		return std::signbit(y) ? -r : r;
+	}
+
+	//Half angle reduction past 0.5, asin(v) = pi/2 - 2 asin(sqrt((1 - v) / 2)), keeps the fit on [0, 0.5]
+	static double ApproximateAsin(double value) {
+		double v = std::abs(value);
+
+		if (!(v <= 1.0)) return asin(value);//NaN outside the domain, as libm
+
+		double z = 0.5 * (1.0 - v);
+		double r = v > 0.5 ? 1.57079632679489661923 - 2.0 * AsinKernel(sqrt(z), z) : AsinKernel(v, v * v);
+
+		return std::signbit(value) ? -r : r;
+	}
+
+	static double ApproximateAcos(double value) {
+		double v = std::abs(value);
+
+		if (!(v <= 1.0)) return acos(value);
+
+		if (v <= 0.5) return 1.57079632679489661923 - AsinKernel(value, v * v);
+
+		double z = 0.5 * (1.0 - v);
+		double r = 2.0 * AsinKernel(sqrt(z), z);
+
+		return value < 0 ? 3.14159265358979323846 - r : r;
+	}
+
+	static double ApproximatePow(double base, double exponent) {
+		if (!(std::abs(exponent) <= 16.0) || exponent != (int)exponent) return pow(base, exponent);
+
+		int n = std::abs((int)exponent);
+		double result = 1.0;
+
+		while (n > 0) {
+			if (n & 1) result *= base;
+
+			base *= base;
+			n >>= 1;
+		}
+
+		return exponent < 0 ? 1.0 / result : result;
+	}
+
+private:
+	static std::atomic<Policy> policy;
+
+	static bool IsExact() {
+		return policy.load(std::memory_order_relaxed) == Exact;
+	}
+
+	//Chebyshev fit of asin(x)/x in z = x^2 over x in [0, 0.5]
+	static double AsinKernel(double x, double z) {
+		double p = 1.00000000023077831e+00 + z * (1.66666576395759036e-01 + z * (7.50057138102505280e-02 + z * (4.45087094985927895e-02 +
+			z * (3.18571888945408586e-02 + z * (1.42952560363726531e-02 + z * 3.76771383436919548e-02)))));
+
+		return x * p;
+	}
+};
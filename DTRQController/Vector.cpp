@@ -1,108 +1,81 @@
 #include "Vector.h"
+#include "SIMD.h"
 
-Vector3D::Vector3D() {
-	this->X = 0.0;
-	this->Y = 0.0;
-	this->Z = 0.0;
-}
-
-Vector3D::Vector3D(const Vector3D& vector) {
-	this->X = vector.X;
-	this->Y = vector.Y;
-	this->Z = vector.Z;
-}
-
-Vector3D::Vector3D(double X, double Y, double Z) {
-	this->X = X;
-	this->Y = Y;
-	this->Z = Z;
-}
+//The vector kernels read X, Y, Z as three contiguous scalars
+static_assert(sizeof(Vector3D) == 3 * sizeof(double), "Vector3D must stay three packed doubles.");
+static_assert(sizeof(Vector3F) == 3 * sizeof(float), "Vector3F must stay three packed floats.");
 
-Vector3D Vector3D::Absolute() {
-	return Vector3D{
+template <typename T>
+Vector3<T> Vector3<T>::Absolute() {
+	return Vector3{
 		std::abs(this->X),
 		std::abs(this->Y),
 		std::abs(this->Z)
 	};
 }
 
-Vector3D Vector3D::Normal() {
-	return Multiply(this->Magnitude() == 0 ? std::numeric_limits<double>::infinity() : 1 / this->Magnitude());
+template <typename T>
+Vector3<T> Vector3<T>::Normal() {
+	return Multiply(this->Magnitude() == 0 ? std::numeric_limits<T>::infinity() : 1 / this->Magnitude());
 }
 
-Vector3D Vector3D::Add(Vector3D vector) {
-	return Vector3D{
-		this->X + vector.X,
-		this->Y + vector.Y,
-		this->Z + vector.Z 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::Add(Vector3 vector) {
+	return *this + vector;
 }
 
-Vector3D Vector3D::Subtract(Vector3D vector) {
-	return Vector3D {
-		this->X - vector.X,
-		this->Y - vector.Y,
-		this->Z - vector.Z 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::Subtract(Vector3 vector) {
+	return *this - vector;
 }
 
-Vector3D Vector3D::Multiply(Vector3D vector) {
-	return Vector3D {
-		this->X * vector.X,
-		this->Y * vector.Y,
-		this->Z * vector.Z 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::Multiply(Vector3 vector) {
+	return *this * vector;
 }
 
-Vector3D Vector3D::Divide(Vector3D vector) {
-	return Vector3D {
-		this->X / vector.X,
-		this->Y / vector.Y,
-		this->Z / vector.Z 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::Divide(Vector3 vector) {
+	return *this / vector;
 }
 
-Vector3D Vector3D::Multiply(double scalar) {
-	return Vector3D {
-		this->X * scalar,
-		this->Y * scalar,
-		this->Z * scalar 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::Multiply(T scalar) {
+	return *this * scalar;
 }
 
-Vector3D Vector3D::Divide(double scalar) {
-	return Vector3D {
-		this->X / scalar,
-		this->Y / scalar,
-		this->Z / scalar
-	};
-
+template <typename T>
+Vector3<T> Vector3<T>::Divide(T scalar) {
+	return *this / scalar;
 }
 
-Vector3D Vector3D::CrossProduct(Vector3D vector) {
-	return Vector3D {
-		(this->Y * vector.Z) - (this->Z * vector.Y),
-		(this->Z * vector.X) - (this->X * vector.Z),
-		(this->X * vector.Y) - (this->Y * vector.X) 
-	};
+template <typename T>
+Vector3<T> Vector3<T>::CrossProduct(Vector3 vector) {
+	Vector3 result;
+
+	SIMD::CrossProduct(&this->X, &vector.X, &result.X);
+
+	return result;
 }
 
-Vector3D Vector3D::UnitSphere() {
-	Vector3D vector = Vector3D(this->X, this->Y, this->Z);
-	double length = vector.GetLength();
+template <typename T>
+Vector3<T> Vector3<T>::UnitSphere() {
+	Vector3 vector = Vector3(this->X, this->Y, this->Z);
+	T length = vector.GetLength();
 
 	if (length == 1) return vector;
-	if (length == 0) return Vector3D(0, 1, 0);
+	if (length == 0) return Vector3(0, 1, 0);
 
-	return Vector3D {
+	return Vector3 {
 		vector.X / length,
 		vector.Y / length,
 		vector.Z / length 
 	};
 }
 
-Vector3D Vector3D::Constrain(double minimum, double maximum) {
-	Vector3D vector = Vector3D(this->X, this->Y, this->Z);
+template <typename T>
+Vector3<T> Vector3<T>::Constrain(T minimum, T maximum) {
+	Vector3 vector = Vector3(this->X, this->Y, this->Z);
 
 	vector.X = Mathematics::Constrain(X, minimum, maximum);
 	vector.Y = Mathematics::Constrain(Y, minimum, maximum);
@@ -111,8 +84,9 @@ Vector3D Vector3D::Constrain(double minimum, double maximum) {
 	return vector;
 }
 
-Vector3D Vector3D::Constrain(Vector3D minimum, Vector3D maximum) {
-	Vector3D vector = Vector3D(this->X, this->Y, this->Z);
+template <typename T>
+Vector3<T> Vector3<T>::Constrain(Vector3 minimum, Vector3 maximum) {
+	Vector3 vector = Vector3(this->X, this->Y, this->Z);
 
 	vector.X = Mathematics::Constrain(X, minimum.X, maximum.X);
 	vector.Y = Mathematics::Constrain(Y, minimum.Y, maximum.Y);
@@ -121,32 +95,42 @@ Vector3D Vector3D::Constrain(Vector3D minimum, Vector3D maximum) {
 	return vector;
 }
 
-double Vector3D::Magnitude() {
-	Vector3D vector = Vector3D(this->X, this->Y, this->Z);
+template <typename T>
+T Vector3<T>::Magnitude() {
+	Vector3 vector = Vector3(this->X, this->Y, this->Z);
 
 	return sqrt(DotProduct(vector, vector));
 }
 
-double Vector3D::GetLength() {
+template <typename T>
+T Vector3<T>::GetLength() {
 	return sqrt(pow(this->X, 2) + pow(this->Y, 2) + pow(this->Z, 2));
 }
 
-double Vector3D::DotProduct(Vector3D vector) {
-	return (this->X * vector.X) + (this->Y * vector.Y) + (this->Z * vector.Z);
+template <typename T>
+T Vector3<T>::DotProduct(Vector3 vector) {
+	return SIMD::Dot(&this->X, &vector.X, 3);
 }
 
-double Vector3D::CalculateEuclideanDistance(Vector3D vector) {
+template <typename T>
+T Vector3<T>::CalculateEuclideanDistance(Vector3 vector) {
 	return sqrt(pow(this->X - vector.X, 2) + pow(this->Y - vector.Y, 2) + pow(this->Z - vector.Z, 2));
 }
 
-bool Vector3D::IsEqual(Vector3D vector) {
+template <typename T>
+bool Vector3<T>::IsEqual(Vector3 vector) {
 	return (this->X == vector.X) && (this->Y == vector.Y) && (this->Z == vector.Z);
 }
 
-std::string Vector3D::ToString() {
+template <typename T>
+std::string Vector3<T>::ToString() {
 	std::string x = Mathematics::DoubleToCleanString(this->X);
 	std::string y = Mathematics::DoubleToCleanString(this->Y);
 	std::string z = Mathematics::DoubleToCleanString(this->Z);
 
 	return "[" + x + ", " + y + ", " + z + "]";
 }
+
+//Double for the simulation, float for the flight build
+template struct Vector3<double>;
+template struct Vector3<float>;
@@ -2,102 +2,118 @@
 
 #include "Mathematics.h"
 
-typedef struct Vector3D {
+//Scalar type is double for the simulation and offline tools, float where memory traffic or vector width matters
+template <typename T>
+struct Vector3 {
 public:
-	double X = 0.0;
-	double Y = 0.0;
-	double Z = 0.0;
-
-	Vector3D();
-	Vector3D(const Vector3D& vector);
-	Vector3D(double x, double y, double z);
-	Vector3D Absolute();
-	Vector3D Normal();
-	Vector3D Add(Vector3D vector);
-	Vector3D Subtract(Vector3D vector);
-	Vector3D Multiply(Vector3D vector);
-	Vector3D Divide(Vector3D vector);
-	Vector3D Multiply(double scalar);
-	Vector3D Divide(double scalar);
-	Vector3D CrossProduct(Vector3D vector);
-	Vector3D UnitSphere();//unit sphere
-	Vector3D Constrain(double minimum, double maximum);
-	Vector3D Constrain(Vector3D minimum, Vector3D maximum);
-
-	double Magnitude();
-	double GetLength();
-	double DotProduct(Vector3D vector);
-	double CalculateEuclideanDistance(Vector3D vector);
-	bool IsEqual(Vector3D vector);
+	T X = 0.0;
+	T Y = 0.0;
+	T Z = 0.0;
+
+	constexpr Vector3() noexcept : X(0.0), Y(0.0), Z(0.0) {}
+	constexpr Vector3(const Vector3& vector) noexcept : X(vector.X), Y(vector.Y), Z(vector.Z) {}
+	constexpr Vector3(T x, T y, T z) noexcept : X(x), Y(y), Z(z) {}
+
+	template <typename U>
+	constexpr explicit Vector3(const Vector3<U>& vector) noexcept : X((T)vector.X), Y((T)vector.Y), Z((T)vector.Z) {}//between precisions
+
+	Vector3 Absolute();
+	Vector3 Normal();
+	Vector3 Add(Vector3 vector);
+	Vector3 Subtract(Vector3 vector);
+	Vector3 Multiply(Vector3 vector);
+	Vector3 Divide(Vector3 vector);
+	Vector3 Multiply(T scalar);
+	Vector3 Divide(T scalar);
+	Vector3 CrossProduct(Vector3 vector);
+	Vector3 UnitSphere();//unit sphere
+	Vector3 Constrain(T minimum, T maximum);
+	Vector3 Constrain(Vector3 minimum, Vector3 maximum);
+
+	T Magnitude();
+	T GetLength();
+	T DotProduct(Vector3 vector);
+	T CalculateEuclideanDistance(Vector3 vector);
+	bool IsEqual(Vector3 vector);
 	std::string ToString();
 
-	static Vector3D DegreesToRadians(Vector3D degrees) {
+	static Vector3 DegreesToRadians(Vector3 degrees) {
 		return degrees / (180.0 / Mathematics::PI);
 	}
 
-	static Vector3D RadiansToDegrees(Vector3D radians) {
+	static Vector3 RadiansToDegrees(Vector3 radians) {
 		return radians * (180.0 / Mathematics::PI);
 	}
 
 	//Static function declaractions
-	static Vector3D Normal(Vector3D vector) {
+	static Vector3 Normal(Vector3 vector) {
 		return vector.Normal();
 	}
 
-	static Vector3D Add(Vector3D v1, Vector3D v2) {
+	static Vector3 Add(Vector3 v1, Vector3 v2) {
 		return v1.Add(v2);
 	}
 
-	static Vector3D Subtract(Vector3D v1, Vector3D v2) {
+	static Vector3 Subtract(Vector3 v1, Vector3 v2) {
 		return v1.Subtract(v2);
 	}
 
-	static Vector3D Multiply(Vector3D v1, Vector3D v2) {
+	static Vector3 Multiply(Vector3 v1, Vector3 v2) {
 		return v1.Multiply(v2);
 	}
 
-	static Vector3D Divide(Vector3D v1, Vector3D v2) {
+	static Vector3 Divide(Vector3 v1, Vector3 v2) {
 		return v1.Divide(v2);
 	}
 
-	static Vector3D Multiply(Vector3D vector, double scalar) {
+	static Vector3 Multiply(Vector3 vector, T scalar) {
 		return vector.Multiply(scalar);
 	}
 
-	static Vector3D Multiply(double scalar, Vector3D vector) {
+	static Vector3 Multiply(T scalar, Vector3 vector) {
 		return vector.Multiply(scalar);
 	}
 
-	static Vector3D Divide(Vector3D vector, double scalar) {
+	static Vector3 Divide(Vector3 vector, T scalar) {
 		return vector.Divide(scalar);
 	}
 
-	static Vector3D CrossProduct(Vector3D v1, Vector3D v2) {
+	static Vector3 CrossProduct(Vector3 v1, Vector3 v2) {
 		return v1.CrossProduct(v2);
 	}
 
-	static double DotProduct(Vector3D v1, Vector3D v2) {
+	static T DotProduct(Vector3 v1, Vector3 v2) {
 		return v1.DotProduct(v2);
 	}
 
-	static double CalculateEuclideanDistance(Vector3D v1, Vector3D v2) {
+	static T CalculateEuclideanDistance(Vector3 v1, Vector3 v2) {
 		return v1.CalculateEuclideanDistance(v2);
 	}
 
-	static bool IsEqual(Vector3D v1, Vector3D v2) {
+	static bool IsEqual(Vector3 v1, Vector3 v2) {
 		return v1.IsEqual(v2);
 	}
 
-	//Operator overloads
-	bool operator ==(Vector3D vector) {
-		return this->IsEqual(vector);
+	//Fused forms of the integration updates, evaluated in the same order as the written out expressions so results
+	//do not change
+	static constexpr Vector3 MulAdd(const Vector3& vector, const Vector3& rate, T scalar) noexcept {
+		return Vector3(vector.X + rate.X * scalar, vector.Y + rate.Y * scalar, vector.Z + rate.Z * scalar);//vector + rate * scalar
 	}
 
-	bool operator !=(Vector3D vector) {
-		return !(this->IsEqual(vector));
+	static constexpr Vector3 MulSub(const Vector3& vector, const Vector3& rate, T scalar) noexcept {
+		return Vector3(vector.X - rate.X * scalar, vector.Y - rate.Y * scalar, vector.Z - rate.Z * scalar);//vector - rate * scalar
 	}
 
-	Vector3D operator  =(Vector3D vector) {
+	//Operator overloads, arguments by reference and results built in place
+	constexpr bool operator ==(const Vector3& vector) const noexcept {
+		return X == vector.X && Y == vector.Y && Z == vector.Z;
+	}
+
+	constexpr bool operator !=(const Vector3& vector) const noexcept {
+		return !(*this == vector);
+	}
+
+	constexpr Vector3& operator =(const Vector3& vector) noexcept {
 		this->X = vector.X;
 		this->Y = vector.Y;
 		this->Z = vector.Z;
@@ -105,39 +121,54 @@ public:
 		return *this;
 	}
 
-	Vector3D operator  +(Vector3D vector) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3 operator  -() const noexcept {
+		return Vector3(-X, -Y, -Z);
+	}
 
-		return v.Add(vector);
+	constexpr Vector3 operator  +(const Vector3& vector) const noexcept {
+		return Vector3(X + vector.X, Y + vector.Y, Z + vector.Z);
 	}
 
-	Vector3D operator  -(Vector3D vector) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3 operator  -(const Vector3& vector) const noexcept {
+		return Vector3(X - vector.X, Y - vector.Y, Z - vector.Z);
+	}
 
-		return v.Subtract(vector);
+	constexpr Vector3 operator  *(const Vector3& vector) const noexcept {
+		return Vector3(X * vector.X, Y * vector.Y, Z * vector.Z);
 	}
 
-	Vector3D operator  *(Vector3D vector) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3 operator  /(const Vector3& vector) const noexcept {
+		return Vector3(X / vector.X, Y / vector.Y, Z / vector.Z);
+	}
 
-		return v.Multiply(vector);
+	constexpr Vector3 operator  *(T value) const noexcept {
+		return Vector3(X * value, Y * value, Z * value);
 	}
 
-	Vector3D operator  /(Vector3D vector) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3 operator  /(T value) const noexcept {
+		return Vector3(X / value, Y / value, Z / value);
+	}
 
-		return v.Divide(vector);
+	constexpr Vector3& operator +=(const Vector3& vector) noexcept {
+		return *this = *this + vector;
 	}
 
-	Vector3D operator  *(double value) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3& operator -=(const Vector3& vector) noexcept {
+		return *this = *this - vector;
+	}
 
-		return v.Multiply(value);
+	constexpr Vector3& operator *=(T value) noexcept {
+		return *this = *this * value;
 	}
 
-	Vector3D operator  /(double value) {
-		Vector3D v = Vector3D(*this);
+	constexpr Vector3& operator /=(T value) noexcept {
+		return *this = *this / value;
+	}
 
-		return v.Divide(value);
+	friend constexpr Vector3 operator *(T value, const Vector3& vector) noexcept {
+		return vector * value;
 	}
-} Vector3D;
+};
+
+typedef Vector3<double> Vector3D;
+typedef Vector3<float> Vector3F;
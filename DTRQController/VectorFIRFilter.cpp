@@ -4,24 +4,76 @@ VectorFIRFilter::VectorFIRFilter() {
 	X = FiniteImpulseResponse();
 	Y = FiniteImpulseResponse();
 	Z = FiniteImpulseResponse();
+
+	SetupInterleaved();
 }
 
 VectorFIRFilter::VectorFIRFilter(FiniteImpulseResponse::Type type, int taps, double fs, double fx, double fxb) {
 	X = FiniteImpulseResponse(type, taps, fs, fx, fxb);
 	Y = FiniteImpulseResponse(type, taps, fs, fx, fxb);
 	Z = FiniteImpulseResponse(type, taps, fs, fx, fxb);
+
+	SetupInterleaved();
 }
 
 VectorFIRFilter::VectorFIRFilter(FiniteImpulseResponse::Type type, Vector3D taps, Vector3D fs, Vector3D fx, Vector3D fxb){
 	X = FiniteImpulseResponse(type, (int)taps.X, fs.X, fx.X, fxb.X);
 	Y = FiniteImpulseResponse(type, (int)taps.Y, fs.Y, fx.Y, fxb.Y);
 	Z = FiniteImpulseResponse(type, (int)taps.Z, fs.Z, fx.Z, fxb.Z);
+
+	SetupInterleaved();
 }
 
 Vector3D VectorFIRFilter::Filter(Vector3D input) {
-	return Vector3D{
-		X.Filter(input.X),
-		Y.Filter(input.Y),
-		Z.Filter(input.Z)
-	};
+	if (!interleaved) {
+		return Vector3D{
+			X.Filter(input.X),
+			Y.Filter(input.Y),
+			Z.Filter(input.Z)
+		};
+	}
+
+	//As FiniteImpulseResponse::Filter, the first sample never enters the delay line
+	if (!primed) {
+		input = Vector3D(0, 0, 0);
+		primed = true;
+	}
+
+	head = head == 0 ? numberTaps - 1 : head - 1;
+
+	double *row = &delay[head * 4];
+	double *mirror = &delay[(head + numberTaps) * 4];
+
+	row[0] = mirror[0] = input.X;
+	row[1] = mirror[1] = input.Y;
+	row[2] = mirror[2] = input.Z;
+
+	double output[4];
+
+	SIMD::InterleavedDot(row, taps.data(), numberTaps, output);
+
+	return Vector3D(output[0], output[1], output[2]);
+}
+
+void VectorFIRFilter::SetupInterleaved() {
+	numberTaps = X.GetNumberTaps();
+	interleaved = numberTaps > 0 && Y.GetNumberTaps() == numberTaps && Z.GetNumberTaps() == numberTaps;
+	head = 0;
+	primed = false;
+
+	if (!interleaved) {
+		taps.clear();
+		delay.clear();
+
+		return;
+	}
+
+	taps.assign(numberTaps * 4, 0.0);
+	delay.assign(numberTaps * 8, 0.0);
+
+	for (int i = 0; i < numberTaps; i++) {
+		taps[i * 4 + 0] = X.GetTaps()[i];
+		taps[i * 4 + 1] = Y.GetTaps()[i];
+		taps[i * 4 + 2] = Z.GetTaps()[i];
+	}
 }
@@ -1,14 +1,28 @@
 #pragma once
 
 #include "FiniteImpulseResponse.h"
+#include "SIMD.h"
 #include "Vector.h"
 
+//Three channels with a shared delay line when they have the same number of taps. Each row of the delay line and the
+//taps holds X, Y, Z and a zero lane, so one vector multiply-add per tap filters all three. Every lane sums in the
+//order of FiniteImpulseResponse::Filter and gives its result exactly. Channels with differing tap counts are
+//filtered one at a time.
 class VectorFIRFilter {
 private:
 	FiniteImpulseResponse X;
 	FiniteImpulseResponse Y;
 	FiniteImpulseResponse Z;
 
+	bool interleaved;
+	int numberTaps;
+	std::vector<double> taps;//numberTaps rows of four
+	std::vector<double> delay;//mirrored as FiniteImpulseResponse, 2 * numberTaps rows of four
+	int head;
+	bool primed;
+
+	void SetupInterleaved();
+
 public:
 	VectorFIRFilter();
 	VectorFIRFilter(FiniteImpulseResponse::Type type, int taps, double fs, double fx, double fxb);
@@ -16,4 +30,4 @@ public:
 
 	Vector3D Filter(Vector3D input);
 
-};
\ No newline at end of file
+};
@@ -6,9 +6,12 @@ VectorFeedbackController::~VectorFeedbackController() {
 	delete Z;
 }
 
-VectorFeedbackController::VectorFeedbackController(const VectorFeedbackController& vectorFeedbackController) : X(vectorFeedbackController.X), 
-																											   Y(vectorFeedbackController.Y), 
-																											   Z(vectorFeedbackController.Z) {}
+//Each axis controller is owned, so copies clone them rather than sharing the pointers
+VectorFeedbackController::VectorFeedbackController(const VectorFeedbackController& vectorFeedbackController) : X(vectorFeedbackController.X->Clone()), 
+																											   Y(vectorFeedbackController.Y->Clone()), 
+																											   Z(vectorFeedbackController.Z->Clone()) {
+	this->output = vectorFeedbackController.output;
+}
 
 VectorFeedbackController::VectorFeedbackController(FeedbackController *X, FeedbackController *Y, FeedbackController *Z) : X(X), Y(Y), Z(Z) {
 	this->X = X;
@@ -24,10 +27,43 @@ Vector3D VectorFeedbackController::Calculate(Vector3D setpoint, Vector3D process
 	return output;
 }
 
+int VectorFeedbackController::GetStateSize() {
+	return 3 + X->GetStateSize() + Y->GetStateSize() + Z->GetStateSize();
+}
+
+void VectorFeedbackController::SaveState(double *state) {
+	state[0] = output.X;
+	state[1] = output.Y;
+	state[2] = output.Z;
+
+	X->SaveState(&state[3]);
+	Y->SaveState(&state[3 + X->GetStateSize()]);
+	Z->SaveState(&state[3 + X->GetStateSize() + Y->GetStateSize()]);
+}
+
+void VectorFeedbackController::LoadState(const double *state) {
+	output = Vector3D(state[0], state[1], state[2]);
+
+	X->LoadState(&state[3]);
+	Y->LoadState(&state[3 + X->GetStateSize()]);
+	Z->LoadState(&state[3 + X->GetStateSize() + Y->GetStateSize()]);
+}
+
 VectorFeedbackController& VectorFeedbackController::operator =(const VectorFeedbackController& vectorFeedbackController) {
-	this->X = vectorFeedbackController.X;
-	this->Y = vectorFeedbackController.Y;
-	this->Z = vectorFeedbackController.Z;
+	if (this == &vectorFeedbackController) return *this;
+
+	FeedbackController *x = vectorFeedbackController.X->Clone();
+	FeedbackController *y = vectorFeedbackController.Y->Clone();
+	FeedbackController *z = vectorFeedbackController.Z->Clone();
+
+	delete X;
+	delete Y;
+	delete Z;
+
+	this->X = x;
+	this->Y = y;
+	this->Z = z;
+	this->output = vectorFeedbackController.output;
 
 	return *this;
 }
@@ -15,5 +15,9 @@ public:
 	VectorFeedbackController(FeedbackController *X, FeedbackController *Y, FeedbackController *Z);
 	Vector3D Calculate(Vector3D setpoint, Vector3D processVariable, double dT);
 
+	int GetStateSize();
+	void SaveState(double *state);
+	void LoadState(const double *state);
+
 	VectorFeedbackController& operator =(const VectorFeedbackController& vectorFeedbackController);
 };
@@ -0,0 +1,82 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool() {
+	int hardware = (int)std::thread::hardware_concurrency();
+
+	this->threads = hardware > 0 ? hardware : 1;
+}
+
+WorkStealingPool::WorkStealingPool(int threads) {
+	this->threads = threads > 0 ? threads : 1;
+}
+
+int WorkStealingPool::GetThreadCount() {
+	return threads;
+}
+
+void WorkStealingPool::Run(int count, const std::function<void(int)> &task) {
+	int workers = count < threads ? (count > 0 ? count : 1) : threads;
+	std::vector<Queue> queues(workers);
+
+	//Contiguous blocks per worker, stealing evens out runs that take longer than others
+	for (int worker = 0; worker < workers; worker++) {
+		int begin = (int)((long long)count * worker / workers);
+		int end = (int)((long long)count * (worker + 1) / workers);
+
+		for (int i = begin; i < end; i++) {
+			queues[worker].Tasks.push_back(i);
+		}
+	}
+
+	std::vector<std::thread> pool;
+
+	for (int worker = 1; worker < workers; worker++) {
+		pool.emplace_back(&WorkStealingPool::Work, this, std::ref(queues), worker, std::cref(task));
+	}
+
+	Work(queues, 0, task);
+
+	for (std::thread &thread : pool) {
+		thread.join();
+	}
+}
+
+void WorkStealingPool::Work(std::vector<Queue> &queues, int worker, const std::function<void(int)> &task) {
+	int index;
+
+	//No tasks are added once running, so a failed pop and steal means everything has been claimed
+	while (Pop(queues, worker, index) || Steal(queues, worker, index)) {
+		task(index);
+	}
+}
+
+bool WorkStealingPool::Pop(std::vector<Queue> &queues, int worker, int &task) {
+	std::lock_guard<std::mutex> guard(queues[worker].Lock);
+
+	if (queues[worker].Tasks.empty()) {
+		return false;
+	}
+
+	task = queues[worker].Tasks.back();
+	queues[worker].Tasks.pop_back();
+
+	return true;
+}
+
+bool WorkStealingPool::Steal(std::vector<Queue> &queues, int worker, int &task) {
+	int workers = (int)queues.size();
+
+	for (int offset = 1; offset < workers; offset++) {
+		Queue &victim = queues[(worker + offset) % workers];
+		std::lock_guard<std::mutex> guard(victim.Lock);
+
+		if (!victim.Tasks.empty()) {
+			task = victim.Tasks.front();
+			victim.Tasks.pop_front();
+
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Runs indexed tasks across worker threads, idle workers steal from the front of busy workers' queues
+class WorkStealingPool {
+private:
+	typedef struct Queue {
+		std::mutex Lock;
+		std::deque<int> Tasks;
+	} Queue;
+
+	int threads;
+
+	bool Pop(std::vector<Queue> &queues, int worker, int &task);
+	bool Steal(std::vector<Queue> &queues, int worker, int &task);
+	void Work(std::vector<Queue> &queues, int worker, const std::function<void(int)> &task);
+
+public:
+	WorkStealingPool();
+	WorkStealingPool(int threads);
+
+	int GetThreadCount();
+	void Run(int count, const std::function<void(int)> &task);
+};
@@ -1,33 +1,41 @@
 #include "YawPitchRoll.h"
 
-YawPitchRoll::YawPitchRoll() {
+template <typename T>
+YawPitchRollT<T>::YawPitchRollT() {
 	this->Yaw = 0.0;
 	this->Pitch = 0.0;
 	this->Roll = 0.0;
 }
 
-YawPitchRoll::YawPitchRoll(Vector3D vector) {
+template <typename T>
+YawPitchRollT<T>::YawPitchRollT(Vector3<T> vector) {
 	this->Yaw = vector.X;
 	this->Pitch = vector.Y;
 	this->Roll = vector.Z;
 }
 
-YawPitchRoll::YawPitchRoll(const YawPitchRoll& ypr) {
+template <typename T>
+YawPitchRollT<T>::YawPitchRollT(const YawPitchRollT& ypr) {
 	this->Yaw = ypr.Yaw;
 	this->Pitch = ypr.Pitch;
 	this->Roll = ypr.Roll;
 }
 
-YawPitchRoll::YawPitchRoll(double yaw, double pitch, double roll) {
+template <typename T>
+YawPitchRollT<T>::YawPitchRollT(T yaw, T pitch, T roll) {
 	this->Yaw = yaw;
 	this->Pitch = pitch;
 	this->Roll = roll;
 }
 
-std::string YawPitchRoll::ToString() {
+template <typename T>
+std::string YawPitchRollT<T>::ToString() {
 	std::string y = Mathematics::DoubleToCleanString(this->Yaw);
 	std::string p = Mathematics::DoubleToCleanString(this->Pitch);
 	std::string r = Mathematics::DoubleToCleanString(this->Roll);
 
 	return "[" + y + ", " + p + ", " + r + "]";
 }
+
+template struct YawPitchRollT<double>;
+template struct YawPitchRollT<float>;
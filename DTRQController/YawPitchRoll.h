@@ -2,18 +2,23 @@
 
 #include "Vector.h"
 
-typedef struct YawPitchRoll {
+//Scalar type as in Vector3, the double alias keeps the YawPitchRoll name
+template <typename T>
+struct YawPitchRollT {
 private:
 
 public:
-	double Yaw;
-	double Pitch;
-	double Roll;
+	T Yaw;
+	T Pitch;
+	T Roll;
 
-	YawPitchRoll();
-	YawPitchRoll(Vector3D vector);
-	YawPitchRoll(const YawPitchRoll& ypr);
-	YawPitchRoll(double yaw, double pitch, double roll);
+	YawPitchRollT();
+	YawPitchRollT(Vector3<T> vector);
+	YawPitchRollT(const YawPitchRollT& ypr);
+	YawPitchRollT(T yaw, T pitch, T roll);
 
 	std::string ToString();
-} YawPitchRoll;
\ No newline at end of file
+};
+
+typedef YawPitchRollT<double> YawPitchRoll;
+typedef YawPitchRollT<float> YawPitchRollF;
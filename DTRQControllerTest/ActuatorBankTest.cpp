@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <ActuatorBank.h>
+#include <CriticallyDampedSpring.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(ActuatorBankTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Step response of x'' = k * (1 - x) - 2 * sqrt(k) * x' from rest at zero
+		double Analytic(double k, double t) {
+			double w = sqrt(k);
+
+			return 1.0 - (1.0 + w * t) * exp(-w * t);
+		}
+
+		TEST_METHOD(TestMatchesAnalyticSolution) {
+			double dTs[] = { 0.001, 0.01, 0.1, 0.5 };
+
+			for (double dT : dTs) {
+				ActuatorBank bank = ActuatorBank(2, 3, dT);
+				double maxError = 0.0;
+
+				bank.SetSpringConstant(0, 75);
+				bank.SetSpringConstant(1, 250);
+
+				for (int vehicle = 0; vehicle < 3; vehicle++) {
+					bank.SetTarget(0, vehicle, 1.0);
+					bank.SetTarget(1, vehicle, 1.0);
+				}
+
+				for (int i = 1; i * dT <= 2.0; i++) {
+					bank.Step();
+
+					for (int vehicle = 0; vehicle < 3; vehicle++) {
+						maxError = std::max(maxError, fabs(bank.GetPosition(0, vehicle) - Analytic(75, i * dT)));
+						maxError = std::max(maxError, fabs(bank.GetPosition(1, vehicle) - Analytic(250, i * dT)));
+					}
+				}
+
+				Print("dT: " + std::to_string(dT) + " max error: " + std::to_string(maxError));
+
+				Assert::AreEqual(0.0, maxError, 1e-12, L"Bank does not follow the analytic step response.");
+			}
+		}
+
+		TEST_METHOD(TestStableAtLargeTimeStep) {
+			//Forward Euler diverges once dT * sqrt(k) grows past about 2, the closed form only decays
+			ActuatorBank bank = ActuatorBank(1, 1, 1.0);
+			CriticallyDampedSpring spring = CriticallyDampedSpring(1.0, 250);
+			double bankPosition = 0.0, springPosition = 0.0;
+
+			bank.SetSpringConstant(0, 250);
+			bank.SetTarget(0, 0, 10.0);
+
+			for (int i = 0; i < 100; i++) {
+				bank.Step();
+				bankPosition = bank.GetPosition(0, 0);
+				springPosition = spring.Calculate(10.0);
+
+				Assert::IsTrue(fabs(bankPosition) <= 10.0 + 1e-9, L"Bank overshoots the target.");
+			}
+
+			Assert::AreEqual(10.0, bankPosition, 1e-9, L"Bank does not settle on the target.");
+			Assert::AreEqual(bankPosition, springPosition, 1e-12, L"Spring and bank disagree.");
+		}
+
+		TEST_METHOD(TestIndependentOfTimeStep) {
+			ActuatorBank coarse = ActuatorBank(1, 1, 0.02);
+			ActuatorBank fine = ActuatorBank(1, 1, 0.02);
+
+			coarse.SetSpringConstant(0, 75);
+			fine.SetSpringConstant(0, 75);
+			coarse.SetTarget(0, 0, 1.0);
+			fine.SetTarget(0, 0, 1.0);
+			fine.SetTimeStep(0.005);
+
+			for (int i = 0; i < 50; i++) {
+				coarse.Step();
+
+				for (int j = 0; j < 4; j++) fine.Step();
+			}
+
+			Assert::AreEqual(coarse.GetPosition(0, 0), fine.GetPosition(0, 0), 1e-12, L"Result depends on the step size.");
+			Assert::AreEqual(coarse.GetVelocity(0, 0), fine.GetVelocity(0, 0), 1e-12, L"Velocity depends on the step size.");
+		}
+
+		//A Quadcopter bank of 12 channels stepped whole against each thruster stepping its own three
+		TEST_METHOD(TestChannelRangeMatchesWholeBank) {
+			ActuatorBank whole = ActuatorBank(12, 1, 0.01);
+			ActuatorBank ranges = ActuatorBank(12, 1, 0.01);
+
+			for (int channel = 0; channel < 12; channel++) {
+				whole.SetSpringConstant(channel, channel % 3 == 2 ? 250 : 75);
+				ranges.SetSpringConstant(channel, channel % 3 == 2 ? 250 : 75);
+				whole.SetTarget(channel, 0, channel - 5.5);
+				ranges.SetTarget(channel, 0, channel - 5.5);
+			}
+
+			for (int i = 0; i < 20; i++) {
+				whole.Step();
+
+				for (int first = 0; first < 12; first += 3) ranges.Step(first, 3);
+			}
+
+			for (int channel = 0; channel < 12; channel++) {
+				Assert::AreEqual(whole.GetPosition(channel, 0), ranges.GetPosition(channel, 0), L"Ranges differ from the whole bank.");
+				Assert::AreEqual(whole.GetVelocity(channel, 0), ranges.GetVelocity(channel, 0), L"Ranges differ from the whole bank.");
+			}
+
+			//Channels outside the range are left alone
+			ranges.SetTarget(0, 0, 100.0);
+			ranges.SetTarget(3, 0, 100.0);
+			ranges.Step(3, 3);
+
+			Assert::AreEqual(whole.GetPosition(0, 0), ranges.GetPosition(0, 0), L"Channel outside the range stepped.");
+			Assert::IsTrue(ranges.GetPosition(3, 0) > whole.GetPosition(3, 0), L"Channel inside the range not stepped.");
+		}
+
+		TEST_METHOD(TestBankThroughput) {
+			const int count = 1024;
+			const int steps = 2000;
+			ActuatorBank bank = ActuatorBank(12, count, 0.002);
+
+			for (int channel = 0; channel < 12; channel++) {
+				bank.SetSpringConstant(channel, channel % 3 == 2 ? 250 : 75);
+
+				for (int vehicle = 0; vehicle < count; vehicle++) {
+					bank.SetTarget(channel, vehicle, sin(channel + vehicle * 0.1));
+				}
+			}
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < steps; i++) {
+				bank.Step();
+			}
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			Print("Actuator updates per second: " + std::to_string(12.0 * count * steps / seconds));
+
+			Assert::AreEqual(sin(1.0), bank.GetPosition(1, 0), 1e-6, L"Bank did not settle.");
+		}
+
+	};
+}
@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <ControlAllocation.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(ControlAllocationTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		TEST_METHOD(TestAllocationMatchesMixingPattern) {
+			//Rotor sign pattern previously written out in Quadcopter::CalculateCombinedThrustVector
+			const double pattern[4][3] = {
+				{ -1, -1,  1 },
+				{ -1,  1, -1 },
+				{  1, -1, -1 },
+				{  1,  1,  1 }
+			};
+			double geometry[3][2] = { { 0.3, 55 }, { 0.2, 30 }, { 0.5, 80 } };
+
+			for (int g = 0; g < 3; g++) {
+				ControlAllocation allocation = ControlAllocation(geometry[g][0], geometry[g][1]);
+
+				for (int thruster = 0; thruster < 4; thruster++) {
+					for (int axis = 0; axis < 3; axis++) {
+						Assert::AreEqual(pattern[thruster][axis], allocation.GetAllocation(thruster, axis), 1e-12, L"Allocation differs from the mixing pattern.");
+					}
+				}
+
+				double outputs[4];
+
+				allocation.Allocate(Vector3D(3, -2, 5), outputs);
+
+				Print("Outputs: " + std::to_string(outputs[0]) + " " + std::to_string(outputs[1]) + " " + std::to_string(outputs[2]) + " " + std::to_string(outputs[3]));
+
+				Assert::AreEqual(-3 + 2 + 5.0, outputs[0], 1e-12, L"TB output mismatch.");
+				Assert::AreEqual( 3 - 2 + 5.0, outputs[3], 1e-12, L"TE output mismatch.");
+			}
+		}
+
+		TEST_METHOD(TestEffectivenessMatchesTorqueModel) {
+			ControlAllocation allocation = ControlAllocation(0.3, 55);
+			double t = 0.3 * sin(Mathematics::DegreesToRadians(180 - 55)) * 5;
+			Vector3D thrust[4] = { Vector3D(0.1, 2.0, -0.3), Vector3D(-0.2, 2.5, 0.1), Vector3D(0.3, 1.5, 0.2), Vector3D(0.05, 1.8, -0.1) };
+			const Vector3D &B = thrust[0], &C = thrust[1], &D = thrust[2], &E = thrust[3];
+
+			Vector3D expected = Vector3D::DegreesToRadians(Vector3D(
+				( B.Y + C.Y - D.Y - E.Y) * t + (B.X + D.X - (C.X + E.X)),
+				( B.X + C.X - D.X - E.X) * t + ( B.Z - C.Z - D.Z + E.Z) * t + (B.Y + D.Y - (C.Y + E.Y)),
+				(-B.Y + C.Y + D.Y - E.Y) * t + (B.Z + D.Z - (C.Z + E.Z))
+			));
+
+			Vector3D actual = allocation.CalculateAngularAcceleration(thrust);
+
+			Assert::AreEqual(t, allocation.GetTorque(), 1e-15, L"Torque arm mismatch.");
+			Assert::AreEqual(expected.X, actual.X, 1e-12, L"Angular acceleration X mismatch.");
+			Assert::AreEqual(expected.Y, actual.Y, 1e-12, L"Angular acceleration Y mismatch.");
+			Assert::AreEqual(expected.Z, actual.Z, 1e-12, L"Angular acceleration Z mismatch.");
+		}
+
+		TEST_METHOD(TestAllocationDecouplesAxes) {
+			ControlAllocation allocation = ControlAllocation(0.25, 40);
+
+			for (int axis = 0; axis < 3; axis++) {
+				double command[3] = { 0, 0, 0 };
+				double outputs[4];
+
+				command[axis] = 1;
+
+				allocation.Allocate(Vector3D(command[0], command[1], command[2]), outputs);
+
+				Vector3D thrust[4] = { Vector3D(0, outputs[0], 0), Vector3D(0, outputs[1], 0), Vector3D(0, outputs[2], 0), Vector3D(0, outputs[3], 0) };
+				Vector3D response = allocation.CalculateAngularAcceleration(thrust);
+				double values[3] = { response.X, response.Y, response.Z };
+
+				for (int other = 0; other < 3; other++) {
+					if (other == axis) {
+						Assert::IsTrue(values[other] < 0, L"Commanded axis does not respond against the controller output.");
+					}
+					else {
+						Assert::AreEqual(0.0, values[other], 1e-12, L"Command leaks into another axis.");
+					}
+				}
+			}
+		}
+
+	};
+}
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <EulerConversion.h>
+#include <Rotation.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(EulerConversionTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//The specialised conversion has to reproduce the runtime order exactly for flights to replay bit for bit, which
+		//holds in builds without fused multiply-adds (see CMakeLists.txt)
+		template <typename Order>
+		void AssertMatchesRuntime(EulerOrder order, std::string name) {
+			std::mt19937 generator(7);
+			std::uniform_real_distribution<double> angle(-180.0, 180.0);
+
+			Assert::AreEqual((int)order.InitialAxis, (int)Order::Order().InitialAxis, L"Tag initial axis differs.");
+			Assert::AreEqual((int)order.AxisPermutation, (int)Order::Order().AxisPermutation, L"Tag parity differs.");
+			Assert::AreEqual((int)order.InitialAxisRepetition, (int)Order::Order().InitialAxisRepetition, L"Tag repetition differs.");
+			Assert::AreEqual((int)order.FrameTaken, (int)Order::Order().FrameTaken, L"Tag frame differs.");
+			Assert::IsTrue(order.Permutation.IsEqual(Order::Order().Permutation), L"Tag permutation differs.");
+
+			for (int i = 0; i < 100; i++) {
+				Vector3D angles = Vector3D(angle(generator), angle(generator), angle(generator));
+				Rotation rotation = Rotation(EulerAngles(angles, order));
+				Quaternion q = EulerConversion::ToQuaternion<Order>(angles);
+
+				Assert::IsTrue(rotation.GetQuaternion().IsEqual(q), L"Specialised quaternion differs from the runtime order.");
+				Assert::IsTrue(rotation.GetEulerAngles(order).Angles.IsEqual(rotation.GetEulerAngles<Order>().Angles), L"Specialised Euler angles differ from the runtime order.");
+
+				RotationMatrix rM = EulerConversion::ToRotationMatrix<Order>(angles);
+
+				Assert::IsTrue(rM.IsEqual(EulerConversion::ToRotationMatrix(EulerAngles(angles, order))), L"Specialised rotation matrix differs from the runtime order.");
+			}
+
+			Print(name + " matches the runtime order.");
+		}
+
+		TEST_METHOD(TestStaticOrdersMatchRuntime) {
+			AssertMatchesRuntime<EulerConstants::EulerOrderXYZSTag>(EulerConstants::EulerOrderXYZS, "XYZS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXYXSTag>(EulerConstants::EulerOrderXYXS, "XYXS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXZYSTag>(EulerConstants::EulerOrderXZYS, "XZYS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXZXSTag>(EulerConstants::EulerOrderXZXS, "XZXS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYZXSTag>(EulerConstants::EulerOrderYZXS, "YZXS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYZYSTag>(EulerConstants::EulerOrderYZYS, "YZYS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYXZSTag>(EulerConstants::EulerOrderYXZS, "YXZS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYXYSTag>(EulerConstants::EulerOrderYXYS, "YXYS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZXYSTag>(EulerConstants::EulerOrderZXYS, "ZXYS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZXZSTag>(EulerConstants::EulerOrderZXZS, "ZXZS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZYXSTag>(EulerConstants::EulerOrderZYXS, "ZYXS");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZYZSTag>(EulerConstants::EulerOrderZYZS, "ZYZS");
+		}
+
+		TEST_METHOD(TestRotatingOrdersMatchRuntime) {
+			AssertMatchesRuntime<EulerConstants::EulerOrderZYXRTag>(EulerConstants::EulerOrderZYXR, "ZYXR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXYXRTag>(EulerConstants::EulerOrderXYXR, "XYXR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYZXRTag>(EulerConstants::EulerOrderYZXR, "YZXR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXZXRTag>(EulerConstants::EulerOrderXZXR, "XZXR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXZYRTag>(EulerConstants::EulerOrderXZYR, "XZYR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYZYRTag>(EulerConstants::EulerOrderYZYR, "YZYR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZXYRTag>(EulerConstants::EulerOrderZXYR, "ZXYR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYXYRTag>(EulerConstants::EulerOrderYXYR, "YXYR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderYXZRTag>(EulerConstants::EulerOrderYXZR, "YXZR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZXZRTag>(EulerConstants::EulerOrderZXZR, "ZXZR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderXYZRTag>(EulerConstants::EulerOrderXYZR, "XYZR");
+			AssertMatchesRuntime<EulerConstants::EulerOrderZYZRTag>(EulerConstants::EulerOrderZYZR, "ZYZR");
+		}
+
+		TEST_METHOD(TestKnownQuaternion) {
+			//Half turn about X alone
+			Quaternion q = EulerConversion::ToQuaternion<EulerConstants::EulerOrderXYZSTag>(Vector3D(180, 0, 0));
+
+			Assert::AreEqual(0.0, q.W, 1e-12, L"W incorrect.");
+			Assert::AreEqual(1.0, q.X, 1e-12, L"X incorrect.");
+			Assert::AreEqual(0.0, q.Y, 1e-12, L"Y incorrect.");
+			Assert::AreEqual(0.0, q.Z, 1e-12, L"Z incorrect.");
+
+			Vector3D angles = EulerConversion::ToAngles<EulerConstants::EulerOrderXYZSTag>(EulerConversion::ToRotationMatrix<EulerConstants::EulerOrderXYZSTag>(Vector3D(30, -20, 45)));
+
+			Assert::AreEqual(30.0, angles.X, 1e-9, L"Round trip X incorrect.");
+			Assert::AreEqual(-20.0, angles.Y, 1e-9, L"Round trip Y incorrect.");
+			Assert::AreEqual(45.0, angles.Z, 1e-9, L"Round trip Z incorrect.");
+		}
+
+	};
+}
@@ -1,7 +1,11 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
-#include <FastFourierTransform.h>
+#include <FIRBank.h>
 #include <FiniteImpulseResponse.h>
+#include <RealFFTPlan.h>
+#include <VectorFIRFilter.h>
+#include <random>
+#include <sstream>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -13,53 +17,215 @@ namespace DTRQControllerTest
 			Logger::WriteMessage((str + "\n").c_str());
 		}
 
+		//The shift register the delay line replaced, recorded flights were filtered with it
+		double ShiftRegisterFilter(std::vector<double> &sr, const std::vector<double> &taps, double sample) {
+			double output = 0.0;
+
+			sr.insert(sr.begin(), sample);
+			sr.pop_back();
+
+			sr.resize(taps.size());
+
+			for (int i = 0; i < (int)taps.size(); i++) {
+				output += sr.at(i) * taps.at(i);
+			}
+
+			return output;
+		}
+
+		//Bit for bit against the shift register, for the single channel and both vector paths
+		TEST_METHOD(TestDelayLineMatchesShiftRegister) {
+			std::mt19937 generator(3);
+			std::uniform_real_distribution<double> value(-2.0, 2.0);
+
+			FiniteImpulseResponse fir = FiniteImpulseResponse(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+			VectorFIRFilter shared = VectorFIRFilter(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+			VectorFIRFilter separate = VectorFIRFilter(FiniteImpulseResponse::Low, Vector3D(31, 64, 7), Vector3D(1000, 1000, 1000), Vector3D(15, 40, 100), Vector3D(0, 0, 0));
+
+			FiniteImpulseResponse x = FiniteImpulseResponse(FiniteImpulseResponse::High, 100, 1000, 15, 0);
+			FiniteImpulseResponse lowX = FiniteImpulseResponse(FiniteImpulseResponse::Low, 31, 1000, 15, 0);
+			FiniteImpulseResponse lowY = FiniteImpulseResponse(FiniteImpulseResponse::Low, 64, 1000, 40, 0);
+			FiniteImpulseResponse lowZ = FiniteImpulseResponse(FiniteImpulseResponse::Low, 7, 1000, 100, 0);
+
+			std::vector<double> sr, srX, srY, srZ, srLowX, srLowY, srLowZ;
+
+			for (int i = 0; i < 1000; i++) {
+				Vector3D sample = Vector3D(value(generator), value(generator), value(generator));
+
+				Assert::AreEqual(ShiftRegisterFilter(sr, x.GetTaps(), sample.X), fir.Filter(sample.X), L"Delay line differs from the shift register.");
+
+				Vector3D filtered = shared.Filter(sample);
+
+				Assert::AreEqual(ShiftRegisterFilter(srX, x.GetTaps(), sample.X), filtered.X, L"Interleaved X differs from the shift register.");
+				Assert::AreEqual(ShiftRegisterFilter(srY, x.GetTaps(), sample.Y), filtered.Y, L"Interleaved Y differs from the shift register.");
+				Assert::AreEqual(ShiftRegisterFilter(srZ, x.GetTaps(), sample.Z), filtered.Z, L"Interleaved Z differs from the shift register.");
+
+				filtered = separate.Filter(sample);
+
+				Assert::AreEqual(ShiftRegisterFilter(srLowX, lowX.GetTaps(), sample.X), filtered.X, L"Separate X differs from the shift register.");
+				Assert::AreEqual(ShiftRegisterFilter(srLowY, lowY.GetTaps(), sample.Y), filtered.Y, L"Separate Y differs from the shift register.");
+				Assert::AreEqual(ShiftRegisterFilter(srLowZ, lowZ.GetTaps(), sample.Z), filtered.Z, L"Separate Z differs from the shift register.");
+			}
+		}
+
+		//Folded banks round differently so they only have to agree closely, unfolded taps must match exactly
+		TEST_METHOD(TestBankMatchesSingleChannels) {
+			std::mt19937 generator(5);
+			std::uniform_real_distribution<double> value(-2.0, 2.0);
+			std::vector<double> skewed(17);
+
+			for (int i = 0; i < 17; i++) skewed[i] = value(generator);
+
+			FIRBank highBank = FIRBank(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+			FIRBank lowBank = FIRBank(FiniteImpulseResponse::Low, 31, 1000, 15, 0, 5);
+			FIRBank skewedBank = FIRBank(skewed.data(), 17, 3);
+
+			Assert::IsTrue(highBank.IsFolded(), L"Even high pass taps not folded.");
+			Assert::IsTrue(lowBank.IsFolded(), L"Odd low pass taps not folded.");
+			Assert::IsFalse(skewedBank.IsFolded(), L"Asymmetric taps folded.");
+
+			std::vector<FiniteImpulseResponse> high(6, FiniteImpulseResponse(FiniteImpulseResponse::High, 100, 1000, 15, 0));
+			std::vector<FiniteImpulseResponse> low(5, FiniteImpulseResponse(FiniteImpulseResponse::Low, 31, 1000, 15, 0));
+			std::vector<double> sr[3];
+			double worst = 0.0;
+
+			for (int i = 0; i < 1000; i++) {
+				double samples[6], filtered[6];
+
+				for (int c = 0; c < 6; c++) samples[c] = value(generator);
+
+				highBank.Filter(samples, filtered);
+
+				for (int c = 0; c < 6; c++) {
+					double error = std::abs(high[c].Filter(samples[c]) - filtered[c]);
+
+					worst = error > worst ? error : worst;
+
+					Assert::IsTrue(error < 1e-13, L"Folded high pass differs from the single channel.");
+				}
+
+				lowBank.Filter(samples, filtered);
+
+				for (int c = 0; c < 5; c++) {
+					Assert::AreEqual(low[c].Filter(samples[c]), filtered[c], 1e-13, L"Folded low pass differs from the single channel.");
+				}
+
+				//In place, as the flight loop filters
+				std::copy(samples, samples + 3, filtered);
+
+				skewedBank.Filter(filtered, filtered);
+
+				for (int c = 0; c < 3; c++) {
+					Assert::AreEqual(ShiftRegisterFilter(sr[c], skewed, samples[c]), filtered[c], L"Unfolded bank differs from the shift register.");
+				}
+			}
+
+			std::ostringstream stream;
+
+			stream << "Worst folded difference: " << std::scientific << worst;
+
+			Print(stream.str());
+		}
+
+		//Blocks of any size continue the stream, the direct path exactly and the FFT path to rounding
+		TEST_METHOD(TestFilterBlockMatchesFilter) {
+			std::mt19937 generator(9);
+			std::uniform_real_distribution<double> value(-2.0, 2.0);
+			int sizes[] = { 1, 7, 300, 2, 5000, 64, 1 };
+			int taps[] = { 100, FiniteImpulseResponse::BlockCrossover, 1000 };
+			std::vector<double> input(5375), output(5375);
+
+			for (double &sample : input) sample = value(generator);
+
+			for (int numberTaps : taps) {
+				FiniteImpulseResponse single = FiniteImpulseResponse(FiniteImpulseResponse::Low, numberTaps, 1000, 50, 0);
+				FiniteImpulseResponse blocks = FiniteImpulseResponse(FiniteImpulseResponse::Low, numberTaps, 1000, 50, 0);
+				double tolerance = numberTaps < FiniteImpulseResponse::BlockCrossover ? 0.0 : 1e-12;
+				double worst = 0.0;
+				int position = 0;
+
+				for (int size : sizes) {
+					//A single sample through Filter between blocks
+					if (size == 2) {
+						output[position] = blocks.Filter(input[position]);
+						position++;
+						size--;
+					}
+
+					blocks.FilterBlock(&input[position], &output[position], size);
+
+					position += size;
+				}
+
+				for (int i = 0; i < position; i++) {
+					double error = std::abs(single.Filter(input[i]) - output[i]);
+
+					worst = error > worst ? error : worst;
+
+					Assert::IsTrue(error <= tolerance, L"Block output differs from Filter.");
+				}
+
+				std::ostringstream stream;
+
+				stream << numberTaps << " taps, worst block difference: " << std::scientific << worst;
+
+				Print(stream.str());
+			}
+		}
+
+		//Designs past 1000 taps are limited, FilterBlock sizes its transform and the bank its delay lines from the limit
+		TEST_METHOD(TestTapLimit) {
+			FiniteImpulseResponse fir = FiniteImpulseResponse(FiniteImpulseResponse::Low, 5000, 1000, 50, 0);
+			FIRBank bank = FIRBank(FiniteImpulseResponse::Low, 5000, 1000, 50, 0, 3);
+
+			Assert::AreEqual(1000, fir.GetNumberTaps(), L"Tap count not limited.");
+			Assert::AreEqual(1000, (int)fir.GetTaps().size(), L"Designed taps not limited.");
+			Assert::AreEqual(1000, bank.GetNumberTaps(), L"Bank tap count not limited.");
+
+			std::vector<double> block(4096, 1.0);
+
+			double gain = 0.0;
+
+			for (double tap : fir.GetTaps()) gain += tap;
+
+			fir.FilterBlock(block.data(), block.data(), (int)block.size());
+
+			Assert::AreEqual(gain, block.back(), 1e-12, L"Limited filter's DC gain incorrect.");
+		}
+
 		TEST_METHOD(TestFIR) {
-			int samples = 10000;
+			int samples = 8192;
 			double samplingFrequency = 44100;
 			double hpFrequency = 100;
 			double generateFrequency = 20;
 
 			FiniteImpulseResponse hpf = FiniteImpulseResponse(FiniteImpulseResponse::High, 100, samplingFrequency, hpFrequency, 44100);
 
-			double* sineWave = new double[samples];
-			double* filteredWave = new double[samples];
+			std::vector<double> sineWave(samples);
+			std::vector<double> filteredWave(samples);
 
 			for (int i = 0; i < samples; i++) {
 				sineWave[i] = sin(generateFrequency * (2.0 * Mathematics::PI) * double(i) / samplingFrequency);
-				filteredWave[i] = hpf.Filter(sineWave[i]);
 			}
 
-			Print("Getting samples");
+			hpf.FilterBlock(sineWave.data(), filteredWave.data(), samples);
 
-			//generate fourier complex samples
-			std::complex<double>* filtered = new std::complex<double>[samples];  // get temp heap storage
-			std::complex<double>* unfiltered = new std::complex<double>[samples];  // get temp heap storage
+			Print("Getting samples");
 
-			for (int i = 0; i < samples; i++) {
-				// copy all odd elements to heap storage
-				filtered[i] = std::complex<double>(filteredWave[i], 0.0);
-				unfiltered[i] = std::complex<double>(sineWave[i], 0.0);
-			}
+			//one sided spectra of both waves
+			RealFFTPlan plan = RealFFTPlan(samples);
+			std::vector<std::complex<double>> filtered(plan.GetBins());
+			std::vector<std::complex<double>> unfiltered(plan.GetBins());
 
 			Print("Performing FFT");
 
-			FastFourierTransform::FFT(filtered, 10000);
-			FastFourierTransform::FFT(unfiltered, 10000);
-
-			double* filt = FastFourierTransform::GetImagValues(filtered, 10000);
-			double* unfi = FastFourierTransform::GetImagValues(unfiltered, 10000);
+			plan.Forward(filteredWave.data(), filtered.data());
+			plan.Forward(sineWave.data(), unfiltered.data());
 
-			for (int i = 0; i < samples; i++) {
-				Print(Mathematics::DoubleToCleanString(filt[i]) + ", " + Mathematics::DoubleToCleanString(unfi[i]));
+			for (int i = 0; i < plan.GetBins(); i++) {
+				Print(Mathematics::DoubleToCleanString(filtered[i].imag()) + ", " + Mathematics::DoubleToCleanString(unfiltered[i].imag()));
 			}
-
-			delete[] filtered;
-			delete[] unfiltered;
-			delete[] filt;
-			delete[] unfi;
-			delete[] sineWave;
-			delete[] filteredWave;
 		}
 
 	};
-}
\ No newline at end of file
+}
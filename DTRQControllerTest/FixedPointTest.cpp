@@ -0,0 +1,122 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <FixedPoint.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(FixedPointTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		Quaternion RandomUnitQuaternion(std::mt19937 &generator) {
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+			Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+
+			return q.Divide(q.Magnitude());//UnitQuaternion divides by the normal
+		}
+
+		TEST_METHOD(TestSquareRoot) {
+			std::mt19937_64 generator(5);
+
+			for (int i = 0; i < 10000; i++) {
+				uint64_t value = generator() >> (i % 40);
+				uint64_t root = FixedPoint::SquareRoot(value);
+
+				Assert::IsTrue(root * root <= value && (root + 1) * (root + 1) > value, L"Square root is not the floor.");
+			}
+		}
+
+		//Q30 carries nine decimal digits, the products and normalisation stay within a few units of the last place
+		TEST_METHOD(TestQuaternionMatchesDouble) {
+			std::mt19937 generator(7);
+			double tolerance = 8.0 / (1 << FixedPoint::Q30);
+
+			for (int i = 0; i < 1000; i++) {
+				Quaternion a = RandomUnitQuaternion(generator);
+				Quaternion b = RandomUnitQuaternion(generator);
+
+				Quaternion product = QuaternionQ30::FromQuaternion(a).Multiply(QuaternionQ30::FromQuaternion(b)).ToQuaternion();
+				Quaternion expected = a.Multiply(b);
+
+				Assert::AreEqual(expected.W, product.W, tolerance, L"Product W incorrect.");
+				Assert::AreEqual(expected.X, product.X, tolerance, L"Product X incorrect.");
+				Assert::AreEqual(expected.Y, product.Y, tolerance, L"Product Y incorrect.");
+				Assert::AreEqual(expected.Z, product.Z, tolerance, L"Product Z incorrect.");
+
+				//DMP samples drift slightly off unit
+				Quaternion drifted = a.Multiply(1.0 + (i % 7 - 3) * 1e-4);
+				Quaternion unit = QuaternionQ30::FromQuaternion(drifted).UnitQuaternion().ToQuaternion();
+
+				Assert::AreEqual(a.W, unit.W, tolerance, L"Normalised W incorrect.");
+				Assert::AreEqual(a.X, unit.X, tolerance, L"Normalised X incorrect.");
+				Assert::AreEqual(a.Y, unit.Y, tolerance, L"Normalised Y incorrect.");
+				Assert::AreEqual(a.Z, unit.Z, tolerance, L"Normalised Z incorrect.");
+			}
+
+			Assert::IsTrue(QuaternionQ30(0, 0, 0, 0).UnitQuaternion() == QuaternionQ30(), L"Zero quaternion does not normalise to identity.");
+		}
+
+		//Within one Q14 step of the double rotation, the accelerometer resolution
+		TEST_METHOD(TestRotateAndGravity) {
+			std::mt19937 generator(9);
+			std::uniform_real_distribution<double> value(-1.5, 1.5);
+			double tolerance = 1.0 / (1 << FixedPoint::Q14);
+			Vector3Q14 vectors[16];
+			Vector3Q14 rotated[16];
+
+			for (int i = 0; i < 200; i++) {
+				Quaternion q = RandomUnitQuaternion(generator);
+				QuaternionQ30 fixed = QuaternionQ30::FromQuaternion(q);
+
+				for (int j = 0; j < 16; j++) {
+					vectors[j] = Vector3Q14::FromVector3D(Vector3D(value(generator), value(generator), value(generator)));
+				}
+
+				fixed.RotateVectors(vectors, rotated, 16);
+
+				for (int j = 0; j < 16; j++) {
+					Vector3D expected = q.RotateVector(vectors[j].ToVector3D());
+					Vector3D actual = rotated[j].ToVector3D();
+
+					Assert::AreEqual(expected.X, actual.X, tolerance, L"Rotated X incorrect.");
+					Assert::AreEqual(expected.Y, actual.Y, tolerance, L"Rotated Y incorrect.");
+					Assert::AreEqual(expected.Z, actual.Z, tolerance, L"Rotated Z incorrect.");
+				}
+
+				//MPU6050::dmpGetGravity in double
+				Vector3D gravity = Vector3D(2 * (q.X * q.Z - q.W * q.Y), 2 * (q.W * q.X + q.Y * q.Z), q.W * q.W - q.X * q.X - q.Y * q.Y + q.Z * q.Z);
+				Vector3D actual = fixed.Gravity().ToVector3D();
+
+				Assert::AreEqual(gravity.X, actual.X, tolerance, L"Gravity X incorrect.");
+				Assert::AreEqual(gravity.Y, actual.Y, tolerance, L"Gravity Y incorrect.");
+				Assert::AreEqual(gravity.Z, actual.Z, tolerance, L"Gravity Z incorrect.");
+			}
+		}
+
+		TEST_METHOD(TestDMPWords) {
+			//Level and at rest, the accelerometer reads 1g on Z and the linear acceleration is zero
+			int32_t words[4] = { 1 << 30, 0, 0, 0 };
+			QuaternionQ30 q = QuaternionQ30::FromDMP(words);
+
+			Assert::IsTrue(q.LinearAcceleration(Vector3Q14(0, 0, 16384)) == Vector3Q14(0, 0, 0), L"Gravity not removed when level.");
+
+			//Rolled 90 degrees about X, gravity moves to Y
+			int32_t rolled[4] = { 759250125, 759250125, 0, 0 };//cos(45), sin(45) in Q30
+
+			Vector3Q14 gravity = QuaternionQ30::FromDMP(rolled).Gravity();
+
+			Print("Rolled gravity: " + gravity.ToString());
+
+			Assert::AreEqual(0, gravity.X, L"Rolled gravity X incorrect.");
+			Assert::AreEqual(16384, gravity.Y, L"Rolled gravity Y incorrect.");
+			Assert::AreEqual(0, gravity.Z, L"Rolled gravity Z incorrect.");
+		}
+
+	};
+}
@@ -0,0 +1,97 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <cstdio>
+#include <FlightLoop.h>
+#include <FlightRecorder.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(FlightRecorderTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		FlightLoop::Inputs Inputs(int tick) {
+			FlightLoop::Inputs inputs;
+			double angle = 0.05 * sin(tick * 0.01);
+
+			inputs.dT = 0.002 + 0.0001 * sin(tick * 0.37);
+			inputs.MainFRotation = Quaternion(cos(angle), sin(angle), 0, 0);
+			inputs.MainBRotation = Quaternion(cos(angle), 0, 0, sin(angle));
+			inputs.MainFAcceleration = Vector3D(0.01 * sin(tick * 1.7), 1.0 + 0.02 * sin(tick * 2.3), 0.01 * cos(tick * 1.1));
+			inputs.MainBAcceleration = Vector3D(0.01 * cos(tick * 1.9), 1.0 + 0.02 * cos(tick * 2.9), 0.01 * sin(tick * 1.3));
+			inputs.TargetPosition = Vector3D(0, 0, 0);
+			inputs.TargetRotation = Quaternion(1, 0, 0, 0);
+
+			return inputs;
+		}
+
+		void AssertSame(Vector3D expected, Vector3D actual, const wchar_t* message) {
+			Assert::AreEqual(expected.X, actual.X, message);
+			Assert::AreEqual(expected.Y, actual.Y, message);
+			Assert::AreEqual(expected.Z, actual.Z, message);
+		}
+
+		void AssertSame(Quaternion expected, Quaternion actual, const wchar_t* message) {
+			Assert::AreEqual(expected.W, actual.W, message);
+			Assert::AreEqual(expected.X, actual.X, message);
+			Assert::AreEqual(expected.Y, actual.Y, message);
+			Assert::AreEqual(expected.Z, actual.Z, message);
+		}
+
+		TEST_METHOD(TestReplayMatchesRecording) {
+			const int ticks = 500;
+			const std::string path = "FlightRecorderTest.trace";
+			Vector3D forwardOffset = Vector3D(0.01, -1.0, 0.02);
+			Vector3D backOffset = Vector3D(-0.02, -1.0, 0.01);
+
+			FlightLoop live = FlightLoop(forwardOffset, backOffset);
+			FlightRecorder writer;
+
+			Assert::IsTrue(writer.OpenWrite(path, forwardOffset, backOffset), L"Could not open trace for writing.");
+
+			for (int i = 0; i < ticks; i++) {
+				FlightLoop::Inputs inputs = Inputs(i);
+
+				Assert::IsTrue(writer.Record(inputs, live.Tick(inputs)), L"Could not record tick.");
+			}
+
+			writer.Close();
+
+			FlightRecorder reader;
+
+			Assert::IsTrue(reader.OpenRead(path), L"Could not open trace for reading.");
+			AssertSame(forwardOffset, reader.GetForwardOffset(), L"Forward offset not restored.");
+			AssertSame(backOffset, reader.GetBackOffset(), L"Back offset not restored.");
+
+			FlightLoop replay = FlightLoop(reader.GetForwardOffset(), reader.GetBackOffset());
+			FlightLoop::Inputs inputs;
+			FlightLoop::Outputs recorded;
+
+			while (reader.Read(inputs, recorded)) {
+				FlightLoop::Inputs expected = Inputs(reader.GetTicks() - 1);
+				FlightLoop::Outputs replayed = replay.Tick(inputs);
+
+				Assert::AreEqual(expected.dT, inputs.dT, L"dT not restored.");
+				AssertSame(expected.MainFRotation, inputs.MainFRotation, L"Rotation input not restored.");
+				AssertSame(expected.MainBAcceleration, inputs.MainBAcceleration, L"Acceleration input not restored.");
+
+				AssertSame(recorded.Rotation, replayed.Rotation, L"Replayed rotation differs.");
+				AssertSame(recorded.Position, replayed.Position, L"Replayed position differs.");
+				AssertSame(recorded.ThrustB, replayed.ThrustB, L"Replayed thrust B differs.");
+				AssertSame(recorded.ThrustE, replayed.ThrustE, L"Replayed thrust E differs.");
+			}
+
+			Print("Replayed ticks: " + std::to_string(reader.GetTicks()) + " final position: " + recorded.Position.ToString());
+
+			Assert::AreEqual(ticks, reader.GetTicks(), L"Tick count differs.");
+
+			reader.Close();
+			remove(path.c_str());
+		}
+
+	};
+}
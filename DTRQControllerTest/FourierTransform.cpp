@@ -2,6 +2,10 @@
 #include "CppUnitTest.h"
 #include <FastFourierTransform.h>
 #include <HighPassFilter.h>
+#include <PowerSpectralDensity.h>
+#include <RealFFTPlan.h>
+#include <random>
+#include <sstream>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -14,15 +18,14 @@ namespace DTRQControllerTest
 		}
 		
 		TEST_METHOD(TestHighPassFilter) {
-			int samples = 10000;
+			int samples = 8192;
 			double samplingFrequency = 44100;
 			double hpFrequency = 500;
 			double generateFrequency = 500;
 
 			HighPassFilter hpf = HighPassFilter(samplingFrequency, hpFrequency, samples);
 
-			double* sineWave = new double[samples];
-			double* filteredWave = new double[samples];
+			std::vector<double> sineWave(samples);
 
 			for (int i = 0; i < samples; i++) {
 				sineWave[i] = sin(generateFrequency * (2.0 * Mathematics::PI) * double(i) / samplingFrequency);
@@ -31,36 +34,165 @@ namespace DTRQControllerTest
 
 			Print("Getting samples");
 
-			filteredWave = hpf.GetSamples();
+			double* filteredWave = hpf.GetSamples();
 
-			//generate fourier complex samples
-			std::complex<double>* filtered = new std::complex<double>[samples];  // get temp heap storage
-			std::complex<double>* unfiltered = new std::complex<double>[samples];  // get temp heap storage
+			//one sided spectra of both waves
+			RealFFTPlan plan = RealFFTPlan(samples);
+			std::vector<std::complex<double>> filtered(plan.GetBins());
+			std::vector<std::complex<double>> unfiltered(plan.GetBins());
 
-			for (int i = 0; i < samples; i++) {
-				// copy all odd elements to heap storage
-				filtered[i] = std::complex<double>(filteredWave[i], 0.0);
-				unfiltered[i] = std::complex<double>(sineWave[i], 0.0);
+			Print("Performing FFT");
+
+			plan.Forward(filteredWave, filtered.data());
+			plan.Forward(sineWave.data(), unfiltered.data());
+
+			for (int i = 0; i < plan.GetBins(); i++) {
+				Print(Mathematics::DoubleToCleanString(filtered[i].imag()) + ", " + Mathematics::DoubleToCleanString(unfiltered[i].imag()));
 			}
+		}
 
-			Print("Performing FFT");
+		//Every size up to 4096 against the direct sum, odd and even stage counts, then the inverse back to the input
+		TEST_METHOD(TestPlanMatchesDiscreteTransform) {
+			std::mt19937 generator(13);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+			double worst = 0.0;
 
-			FastFourierTransform::FFT(filtered, 10000);
-			FastFourierTransform::FFT(unfiltered, 10000);
+			for (int length = 1; length <= 4096; length *= 2) {
+				std::vector<std::complex<double>> input(length), data(length);
+				FFTPlan plan = FFTPlan(length);
 
-			double* filt = FastFourierTransform::GetImagValues(filtered, 10000);
-			double* unfi = FastFourierTransform::GetImagValues(unfiltered, 10000);
+				for (int i = 0; i < length; i++) input[i] = std::complex<double>(value(generator), value(generator));
 
-			for (int i = 0; i < samples; i++) {
-				Print(Mathematics::DoubleToCleanString(filt[i]) + ", " + Mathematics::DoubleToCleanString(unfi[i]));
+				data = input;
+
+				Assert::IsTrue(plan.Forward(data.data()), L"Power of two length rejected.");
+
+				for (int k = 0; k < length; k++) {
+					std::complex<double> expected = 0.0;
+
+					for (int i = 0; i < length; i++) {
+						double angle = -2.0 * Mathematics::PI * (double)((long long)i * k % length) / length;
+
+						expected += input[i] * std::complex<double>(cos(angle), sin(angle));
+					}
+
+					double error = std::abs(expected - data[k]) / sqrt((double)length);
+
+					worst = error > worst ? error : worst;
+
+					Assert::IsTrue(error < 1e-12, L"Transform differs from the direct sum.");
+				}
+
+				plan.Inverse(data.data(), true);
+
+				for (int i = 0; i < length; i++) {
+					Assert::IsTrue(std::abs(input[i] - data[i]) < 1e-13, L"Inverse does not return the input.");
+				}
 			}
 
-			delete[] filtered;
-			delete[] unfiltered;
-			delete[] filt;
-			delete[] unfi;
-			delete[] sineWave;
-			delete[] filteredWave;
+			std::ostringstream stream;
+
+			stream << "Worst scaled difference from the direct sum: " << std::scientific << worst;
+
+			Print(stream.str());
+
+			//Other lengths are rejected and the data is left as it was
+			std::complex<double> data[12] = { 1.0, 2.0, 3.0 };
+
+			Assert::IsFalse(FFTPlan(12).IsValid(), L"Length 12 accepted.");
+			Assert::IsFalse(FFTPlan(0).Forward(data), L"Empty plan transformed.");
+			Assert::IsFalse(FastFourierTransform::FFT(data, 12), L"Length 12 transformed.");
+			Assert::AreEqual(2.0, data[1].real(), L"Rejected transform changed the data.");
+		}
+
+		//The one sided spectrum against the complex transform of the same samples with zero imaginary parts
+		TEST_METHOD(TestRealPlanMatchesComplexPlan) {
+			std::mt19937 generator(17);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+			for (int length = 2; length <= 4096; length *= 2) {
+				std::vector<double> input(length), output(length);
+				std::vector<std::complex<double>> expected(length), spectrum(length / 2 + 1);
+				RealFFTPlan plan = RealFFTPlan(length);
+				FFTPlan reference = FFTPlan(length);
+
+				for (int i = 0; i < length; i++) {
+					input[i] = value(generator);
+					expected[i] = input[i];
+				}
+
+				reference.Forward(expected.data());
+
+				Assert::IsTrue(plan.Forward(input.data(), spectrum.data()), L"Power of two length rejected.");
+				Assert::AreEqual(length / 2 + 1, plan.GetBins(), L"Wrong number of bins.");
+
+				for (int k = 0; k <= length / 2; k++) {
+					Assert::IsTrue(std::abs(expected[k] - spectrum[k]) / sqrt((double)length) < 1e-13, L"Real transform differs from the complex transform.");
+				}
+
+				plan.Inverse(spectrum.data(), output.data());
+
+				for (int i = 0; i < length; i++) {
+					Assert::AreEqual(input[i], output[i], 1e-13, L"Inverse does not return the input.");
+				}
+			}
+
+			double data[12] = { 1.0, 2.0, 3.0 };
+			std::complex<double> spectrum[7];
+
+			Assert::IsFalse(RealFFTPlan(12).IsValid(), L"Length 12 accepted.");
+			Assert::IsFalse(RealFFTPlan(1).IsValid(), L"Length 1 accepted.");
+			Assert::IsFalse(RealFFTPlan(12).Forward(data, spectrum), L"Length 12 transformed.");
+		}
+
+		//A sine at a bin centre peaks at its bin, and the densities integrate to the variance of the stream
+		TEST_METHOD(TestWelchDensity) {
+			int count = 16384;
+			int segmentLength = 1024;
+			double samplingFrequency = 1000.0;
+			double amplitude = 3.0;
+			double frequency = 125.0;//bin 128
+			std::vector<double> wave(count);
+			double variance = 0.0;
+
+			for (int i = 0; i < count; i++) {
+				wave[i] = 2.0 + amplitude * sin(2.0 * Mathematics::PI * frequency * i / samplingFrequency);
+			}
+
+			for (int i = 0; i < count; i++) {
+				variance += (wave[i] - 2.0) * (wave[i] - 2.0) / count;
+			}
+
+			PowerSpectralDensity psd = PowerSpectralDensity(segmentLength, segmentLength / 2, samplingFrequency);
+			std::vector<double> density(psd.GetBins());
+
+			Assert::AreEqual(segmentLength / 2 + 1, psd.GetBins(), L"Wrong number of bins.");
+			Assert::AreEqual(31, psd.GetSegments(count), L"Wrong number of segments.");
+			Assert::IsTrue(psd.Estimate(wave.data(), count, density.data()), L"Estimate failed.");
+
+			int peak = 0;
+			double total = 0.0;
+
+			for (int k = 0; k < psd.GetBins(); k++) {
+				if (density[k] > density[peak]) peak = k;
+
+				total += density[k] * psd.GetFrequency(1);
+			}
+
+			std::ostringstream stream;
+
+			stream << "Peak " << psd.GetFrequency(peak) << " Hz, integrated " << total << " against variance " << variance;
+
+			Print(stream.str());
+
+			Assert::AreEqual(128, peak, L"Peak at the wrong bin.");
+			Assert::AreEqual(frequency, psd.GetFrequency(peak), 1e-12, L"Peak at the wrong frequency.");
+			Assert::AreEqual(variance, total, variance * 1e-6, L"Densities do not integrate to the variance.");
+			Assert::IsTrue(density[0] < 1e-20, L"Mean leaked into the DC bin.");
+
+			Assert::IsFalse(psd.Estimate(wave.data(), segmentLength - 1, density.data()), L"Short stream estimated.");
+			Assert::IsFalse(PowerSpectralDensity(1000, 500, samplingFrequency).IsValid(), L"Length 1000 accepted.");
+			Assert::IsFalse(PowerSpectralDensity(1024, 1024, samplingFrequency).IsValid(), L"Full overlap accepted.");
 		}
 
 		TEST_METHOD(TestFourierDoubleConversion) {
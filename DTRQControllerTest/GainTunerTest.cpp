@@ -0,0 +1,49 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <GainTuner.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(GainTunerTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		TEST_METHOD(TestTuningReducesCost) {
+			GainTuner tuner = GainTuner(GainTuner::PIDControl, 200, 0.05);
+
+			GainTuner::Result result = tuner.Tune(30, 2);
+
+			Print(tuner.ToString(result));
+
+			Assert::IsTrue(result.Cost < result.InitialCost, L"Tuned gains score no better than the starting gains.");
+			Assert::AreEqual(result.Cost, tuner.Evaluate(result.Gains), 1e-12, L"Reported cost does not match a fresh evaluation.");
+
+			for (GainTuner::Evaluation evaluation : result.Scenarios) {
+				Assert::IsFalse(evaluation.Diverged, L"Tuned gains diverge.");
+			}
+		}
+
+		TEST_METHOD(TestThreadCountDoesNotChangeResult) {
+			GainTuner serial = GainTuner(GainTuner::PIDControl, 100, 0.05);
+			GainTuner parallel = GainTuner(GainTuner::PIDControl, 100, 0.05);
+
+			serial.SetBatchSize(3);
+			parallel.SetBatchSize(3);
+
+			GainTuner::Result one = serial.Tune(5, 1);
+			GainTuner::Result many = parallel.Tune(5, 4);
+
+			Assert::AreEqual(one.Cost, many.Cost, L"Cost depends on thread count.");
+			Assert::AreEqual(one.Evaluations, many.Evaluations, L"Evaluation count depends on thread count.");
+
+			for (int i = 0; i < (int)one.Gains.size(); i++) {
+				Assert::AreEqual(one.Gains[i], many.Gains[i], L"Gains depend on thread count.");
+			}
+		}
+
+	};
+}
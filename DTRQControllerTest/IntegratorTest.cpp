@@ -0,0 +1,146 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <Quadcopter.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(IntegratorTest) {
+	public:
+		typedef struct Trajectory {
+			Vector3D Position;
+			Quaternion Rotation;
+			double Seconds;//wall time spent stepping the physics
+		} Trajectory;
+
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Open loop flight with held thruster outputs, the actuators are settled first so every step size
+		//integrates the same forces and only the rigid body integration differs
+		Trajectory Fly(Quadcopter::Integrator integrator, double dT, double duration) {
+			VectorFeedbackController *pos = new VectorFeedbackController{ new PID{ 0, 0, 0 }, new PID{ 0, 0, 0 }, new PID{ 0, 0, 0 } };
+			VectorFeedbackController *rot = new VectorFeedbackController{ new PID{ 0, 0, 0 }, new PID{ 0, 0, 0 }, new PID{ 0, 0, 0 } };
+			Quadcopter quad(true, 0.3, 55, dT, pos, rot);
+			int steps = (int)(duration / dT + 0.5);
+			int settle = (int)(20.0 / dT);
+
+			quad.SetIntegrator(integrator);
+
+			for (int i = 0; i < settle; i++) {
+				quad.TB->SetThrusterOutputs(Vector3D( 15, 3.5,  10));
+				quad.TC->SetThrusterOutputs(Vector3D(-10, 2.0,  5));
+				quad.TD->SetThrusterOutputs(Vector3D( 8, 3.0, -12));
+				quad.TE->SetThrusterOutputs(Vector3D(-5, 1.5,  6));
+			}
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < steps; i++) {
+				quad.SimulateCurrent(Vector3D(0, -9.81, 0));
+			}
+
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			return Trajectory{ quad.CurrentPosition, quad.CurrentRotation.GetQuaternion(), elapsed };
+		}
+
+		//Closed loop recovery from a tilt, the controllers run at dT while physics and actuators run substeps times faster
+		Trajectory FlyClosedLoop(int substeps, double dT, double duration) {
+			VectorFeedbackController *pos = new VectorFeedbackController{ new PID{ 10, 0, 12.5 }, new PID{ 1, 0, 0.2 }, new PID{ 10, 0, 12.5 } };
+			VectorFeedbackController *rot = new VectorFeedbackController{ new PID{ 0.05, 0, 0.325 }, new PID{ 0.05, 0, 0.325 }, new PID{ 0.05, 0, 0.325 } };
+			Quadcopter quad(true, 0.3, 55, dT, pos, rot);
+			int steps = (int)(duration / dT + 0.5);
+
+			quad.SetFeedbackEnabled(true);
+			quad.SetPhysicsSubsteps(substeps);
+			quad.SetCurrent(Vector3D(0.5, 0, 0), Rotation(EulerAngles(Vector3D(15, 0, -10), EulerConstants::EulerOrderXYZS)));
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < steps; i++) {
+				quad.SetTarget(Vector3D(0, 0, 0), Rotation(Quaternion(1, 0, 0, 0)));
+				quad.SimulateCurrent(Vector3D(0, -9.81, 0));
+				quad.CalculateCombinedThrustVector();
+			}
+
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			return Trajectory{ quad.CurrentPosition, quad.CurrentRotation.GetQuaternion(), elapsed };
+		}
+
+		std::string Scientific(double value) {
+			std::ostringstream stream;
+
+			stream << std::scientific << std::setprecision(2) << value;
+
+			return stream.str();
+		}
+
+		double AttitudeError(Quaternion a, Quaternion b) {
+			double dot = std::abs(a.DotProduct(b)) / (a.Magnitude() * b.Magnitude());
+
+			return Mathematics::RadiansToDegrees(2.0 * acos(Mathematics::Constrain(dot, -1, 1)));
+		}
+
+		TEST_METHOD(TestAccuracyAgainstFineStepReference) {
+			const double duration = 2.0;
+			const double steps[3] = { 0.05, 0.025, 0.01 };
+			const Quadcopter::Integrator integrators[3] = { Quadcopter::SemiImplicitEuler, Quadcopter::ExponentialMap, Quadcopter::RungeKutta4 };
+			const std::string names[3] = { "SemiImplicitEuler", "ExponentialMap   ", "RungeKutta4      " };
+			double positionError[3][3];
+
+			Trajectory reference = Fly(Quadcopter::RungeKutta4, 0.0002, duration);
+
+			Print("Reference RK4 dT:0.0002 " + reference.Position.ToString() + " " + reference.Rotation.ToString());
+
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					Trajectory result = Fly(integrators[i], steps[j], duration);
+
+					positionError[i][j] = result.Position.CalculateEuclideanDistance(reference.Position);
+
+					Print(names[i] + " dT:" + Mathematics::DoubleToCleanString(steps[j]) +
+						" Position error:" + Scientific(positionError[i][j]) +
+						" Attitude error:" + Scientific(AttitudeError(result.Rotation, reference.Rotation)) +
+						" us/step:" + Mathematics::DoubleToCleanString(result.Seconds * 1e6 * steps[j] / duration) +
+						" us/simulated s:" + Mathematics::DoubleToCleanString(result.Seconds * 1e6 / duration));
+				}
+			}
+
+			Assert::IsTrue(positionError[2][0] < positionError[0][0], L"RK4 is less accurate than semi-implicit Euler at the same step.");
+			Assert::IsTrue(positionError[2][0] < positionError[0][2], L"RK4 at 0.05 is less accurate than semi-implicit Euler at 0.01.");
+			Assert::IsTrue(positionError[2][2] < positionError[2][0], L"RK4 error does not shrink with the step size.");
+		}
+
+		TEST_METHOD(TestPhysicsSubstepsConverge) {
+			const double duration = 5.0;
+			const int substeps[4] = { 1, 2, 5, 10 };
+			double positionError[4];
+
+			Trajectory reference = FlyClosedLoop(200, 0.05, duration);
+
+			Print("Reference substeps:200 " + reference.Position.ToString() + " " + reference.Rotation.ToString());
+
+			for (int i = 0; i < 4; i++) {
+				Trajectory result = FlyClosedLoop(substeps[i], 0.05, duration);
+
+				positionError[i] = result.Position.CalculateEuclideanDistance(reference.Position);
+
+				Print("Substeps:" + std::to_string(substeps[i]) +
+					" Position error:" + Scientific(positionError[i]) +
+					" Attitude error:" + Scientific(AttitudeError(result.Rotation, reference.Rotation)) +
+					" us/simulated s:" + Mathematics::DoubleToCleanString(result.Seconds * 1e6 / duration));
+			}
+
+			Assert::IsTrue(positionError[3] < positionError[0], L"Substepping does not approach the fine physics reference.");
+			Assert::IsTrue(positionError[3] < positionError[1], L"Error does not shrink with more substeps.");
+		}
+
+	};
+}
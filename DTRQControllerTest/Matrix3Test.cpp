@@ -0,0 +1,100 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <Matrix3.h>
+#include <RotationMatrix.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(Matrix3Test) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		void AssertVector(Vector3D expected, Vector3D actual, double tolerance, const wchar_t *message) {
+			Assert::AreEqual(expected.X, actual.X, tolerance, message);
+			Assert::AreEqual(expected.Y, actual.Y, tolerance, message);
+			Assert::AreEqual(expected.Z, actual.Z, tolerance, message);
+		}
+
+		//Previous RotationMatrix::RotateVector, one axis at a time in the order X, Y, Z
+		Vector3D RotateAxisByAxis(Vector3D rotate, Vector3D v) {
+			double c = cos(Mathematics::DegreesToRadians(rotate.X)), s = sin(Mathematics::DegreesToRadians(rotate.X));
+
+			v = Vector3D(v.X, c * v.Y + s * v.Z, -s * v.Y + c * v.Z);
+
+			c = cos(Mathematics::DegreesToRadians(rotate.Y));
+			s = sin(Mathematics::DegreesToRadians(rotate.Y));
+
+			v = Vector3D(c * v.X - s * v.Z, v.Y, s * v.X + c * v.Z);
+
+			c = cos(Mathematics::DegreesToRadians(rotate.Z));
+			s = sin(Mathematics::DegreesToRadians(rotate.Z));
+
+			return Vector3D(c * v.X + s * v.Y, -s * v.X + c * v.Y, v.Z);
+		}
+
+		TEST_METHOD(TestRotationMatchesAxisByAxis) {
+			std::mt19937 generator(3);
+			std::uniform_real_distribution<double> angle(-180.0, 180.0);
+			std::uniform_real_distribution<double> value(-10.0, 10.0);
+
+			for (int i = 0; i < 1000; i++) {
+				Vector3D rotate = Vector3D(angle(generator), angle(generator), angle(generator));
+				Vector3D v = Vector3D(value(generator), value(generator), value(generator));
+				Vector3D expected = RotateAxisByAxis(rotate, v);
+
+				AssertVector(expected, RotationMatrix::RotateVector(rotate, v), 1e-12, L"RotateVector differs from the axis by axis rotation.");
+				AssertVector(expected, Matrix3::RotationXYZ(rotate).Multiply(v), 1e-12, L"RotationXYZ differs from the axis by axis rotation.");
+
+				Matrix3 composed = Matrix3::RotationX(rotate.X).Compose(Matrix3::RotationY(rotate.Y)).Compose(Matrix3::RotationZ(rotate.Z));
+
+				AssertVector(expected, composed.Multiply(v), 1e-12, L"Composed rotation differs from the axis by axis rotation.");
+			}
+		}
+
+		TEST_METHOD(TestRotationIsOrthonormal) {
+			Matrix3 rotation = Matrix3::RotationXYZ(Vector3D(35, -70, 125));
+			Matrix3 identity = rotation.Transpose().Multiply(rotation);
+
+			Assert::AreEqual(1.0, rotation.Determinant(), 1e-12, L"Rotation determinant is not one.");
+
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					Assert::AreEqual(i == j ? 1.0 : 0.0, identity.M[i][j], 1e-12, L"Transpose is not the inverse.");
+				}
+			}
+
+			AssertVector(Vector3D(1, 2, 3), rotation.Transpose().Multiply(rotation.Multiply(Vector3D(1, 2, 3))), 1e-12, L"Transpose does not undo the rotation.");
+		}
+
+		TEST_METHOD(TestMultiply) {
+			Matrix3 a = Matrix3(Vector3D(1, 2, 3), Vector3D(4, 5, 6), Vector3D(7, 8, 10));
+			Matrix3 b = Matrix3(Vector3D(2, 0, 1), Vector3D(1, 3, 0), Vector3D(0, 1, 4));
+			Matrix3 product = a.Multiply(b);
+
+			AssertVector(Vector3D(4, 9, 13), product.GetRow(0), 0, L"Product row 0 incorrect.");
+			AssertVector(Vector3D(13, 21, 28), product.GetRow(1), 0, L"Product row 1 incorrect.");
+			AssertVector(Vector3D(22, 34, 47), product.GetRow(2), 0, L"Product row 2 incorrect.");
+
+			Assert::AreEqual(-3.0, a.Determinant(), 1e-12, L"Determinant incorrect.");
+			Assert::IsTrue(a.Compose(b).IsEqual(b.Multiply(a)), L"Compose does not apply this first.");
+			Assert::IsTrue(Matrix3().Multiply(a).IsEqual(a), L"Identity product changes the matrix.");
+
+			Vector3D vectors[5] = { Vector3D(1, 0, 0), Vector3D(0, 1, 0), Vector3D(0, 0, 1), Vector3D(1, -2, 3), Vector3D(-4, 5, 0.5) };
+			Vector3D batch[5];
+
+			a.Multiply(vectors, batch, 5);
+
+			for (int i = 0; i < 5; i++) {
+				AssertVector(a.Multiply(vectors[i]), batch[i], 0, L"Batch multiply differs from the single vector multiply.");
+			}
+
+			Print(a.ToString());
+		}
+
+	};
+}
@@ -0,0 +1,64 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <MonteCarloCampaign.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(MonteCarloCampaignTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		MonteCarloCampaign::Distribution DisturbedDistribution() {
+			MonteCarloCampaign::Distribution distribution = MonteCarloCampaign::Distribution();
+
+			distribution.ExternalAcceleration.X = MonteCarloCampaign::Range(-1, 1);
+			distribution.ExternalAcceleration.Z = MonteCarloCampaign::Range(-1, 1);
+			distribution.InitialRotation.X = MonteCarloCampaign::Range(-10, 10);
+			distribution.InitialRotation.Z = MonteCarloCampaign::Range(-10, 10);
+			distribution.ArmLength = MonteCarloCampaign::Range(0.25, 0.35);
+			distribution.ArmAngle = MonteCarloCampaign::Range(50, 60);
+			distribution.RotationGains.Kp = MonteCarloCampaign::Range(0.025, 0.1);
+
+			return distribution;
+		}
+
+		TEST_METHOD(TestRunIsDeterministicPerSeed) {
+			MonteCarloCampaign campaign = MonteCarloCampaign(DisturbedDistribution(), 16, 100, 0.05, 42);
+
+			for (int run = 0; run < 4; run++) {
+				MonteCarloCampaign::Outcome first = campaign.RunSingle(run);
+				MonteCarloCampaign::Outcome second = campaign.RunSingle(run);
+
+				Assert::AreEqual(first.MaxAttitudeError, second.MaxAttitudeError, L"Attitude error differs between identical runs.");
+				Assert::AreEqual(first.FinalPositionError, second.FinalPositionError, L"Position error differs between identical runs.");
+				Assert::AreEqual(first.SettlingTime, second.SettlingTime, L"Settling time differs between identical runs.");
+			}
+
+			MonteCarloCampaign::Sample a = campaign.Draw(0);
+			MonteCarloCampaign::Sample b = campaign.Draw(1);
+
+			Assert::IsFalse(a.ArmLength == b.ArmLength, L"Runs drew identical parameters.");
+		}
+
+		TEST_METHOD(TestThreadCountDoesNotChangeSummary) {
+			MonteCarloCampaign serial = MonteCarloCampaign(DisturbedDistribution(), 32, 100, 0.05, 7);
+			MonteCarloCampaign parallel = MonteCarloCampaign(DisturbedDistribution(), 32, 100, 0.05, 7);
+
+			MonteCarloCampaign::Summary one = serial.Run(1);
+			MonteCarloCampaign::Summary many = parallel.Run(4);
+
+			Print(one.ToString());
+			Print(many.ToString());
+
+			Assert::AreEqual(one.Diverged, many.Diverged, L"Divergence count depends on thread count.");
+			Assert::AreEqual(one.Settled, many.Settled, L"Settled count depends on thread count.");
+			Assert::AreEqual(one.MeanMaxAttitudeError, many.MeanMaxAttitudeError, L"Attitude statistics depend on thread count.");
+			Assert::AreEqual(one.MeanSettlingTime, many.MeanSettlingTime, L"Settling statistics depend on thread count.");
+		}
+
+	};
+}
@@ -0,0 +1,82 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <Quaternion.h>
+#include <Vector.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+//The element wise operators fold at compile time
+static_assert((Vector3D(1, 2, 3) + Vector3D(4, 5, 6) * 2.0) == Vector3D(9, 12, 15), "Vector3D operators are not constexpr.");
+static_assert(Vector3D::MulAdd(Vector3D(1, 1, 1), Vector3D(1, 2, 3), 0.5) == Vector3D(1.5, 2, 2.5), "Vector3D::MulAdd is not constexpr.");
+static_assert((Quaternion(1, 2, 3, 4) - Quaternion(1, 1, 1, 1)) / 2.0 == Quaternion(0, 0.5, 1, 1.5), "Quaternion operators are not constexpr.");
+static_assert(noexcept(Quaternion() * Quaternion()), "Quaternion product can throw.");
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(OperatorTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Replays are compared bit for bit, so the operators and fused forms must match the named methods exactly
+		TEST_METHOD(TestOperatorsMatchMethods) {
+			std::mt19937 generator(11);
+			std::uniform_real_distribution<double> value(-10.0, 10.0);
+
+			for (int i = 0; i < 1000; i++) {
+				Vector3D a = Vector3D(value(generator), value(generator), value(generator));
+				Vector3D b = Vector3D(value(generator), value(generator), value(generator));
+				Vector3D c = Vector3D(value(generator), value(generator), value(generator));
+				Quaternion p = Quaternion(value(generator), value(generator), value(generator), value(generator));
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+				double s = value(generator);
+
+				Assert::IsTrue((a + b).IsEqual(a.Add(b)), L"Vector3D + differs from Add.");
+				Assert::IsTrue((a - b).IsEqual(a.Subtract(b)), L"Vector3D - differs from Subtract.");
+				Assert::IsTrue((a * s).IsEqual(a.Multiply(s)), L"Vector3D * differs from Multiply.");
+				Assert::IsTrue((s * a).IsEqual(a.Multiply(s)), L"Scalar * Vector3D differs from Multiply.");
+				Assert::IsTrue((a / s).IsEqual(a.Divide(s)), L"Vector3D / differs from Divide.");
+				Assert::IsTrue(Vector3D::MulAdd(a, b, s).IsEqual(a.Add(b.Multiply(s))), L"Vector3D::MulAdd differs.");
+				Assert::IsTrue(Vector3D::MulSub(Vector3D::MulAdd(a, b, s), c, s).IsEqual(a.Add(b.Multiply(s)).Subtract(c.Multiply(s))), L"Vector3D::MulSub differs.");
+
+				Assert::IsTrue((p + q).IsEqual(p.Add(q)), L"Quaternion + differs from Add.");
+				Assert::IsTrue((p * q).IsEqual(p.Multiply(q)), L"Quaternion * differs from Multiply.");
+				Assert::IsTrue((p / q).IsEqual(p.Divide(q)), L"Quaternion / differs from Divide.");
+				Assert::IsTrue((s * p).IsEqual(p.Multiply(s)), L"Scalar * Quaternion differs from Multiply.");
+				Assert::IsTrue(Quaternion::MulAdd(p, q, p).IsEqual(p.Add(q.Multiply(p))), L"Quaternion::MulAdd product differs.");
+				Assert::IsTrue(Quaternion::MulAdd(p, q, s).IsEqual(p.Add(q.Multiply(s))), L"Quaternion::MulAdd scalar differs.");
+				Assert::IsTrue(p.RotateAdd(a, b).IsEqual(p.RotateVector(a).Add(b)), L"RotateAdd differs.");
+			}
+		}
+
+		TEST_METHOD(TestCompoundAssignment) {
+			Vector3D v = Vector3D(1, 2, 3);
+			Vector3D u;
+
+			(u = v) += Vector3D(1, 1, 1);
+
+			Assert::IsTrue(u.IsEqual(Vector3D(2, 3, 4)), L"Assignment does not return the assigned vector.");
+			Assert::IsTrue(v.IsEqual(Vector3D(1, 2, 3)), L"Assignment changed its source.");
+
+			u *= 2.0;
+			u -= v;
+			u /= 3.0;
+
+			Assert::IsTrue(u.IsEqual(Vector3D(1, 4.0 / 3.0, 5.0 / 3.0)), L"Compound assignment incorrect.");
+
+			Quaternion q = Quaternion(0.5, 0.5, 0.5, 0.5);
+			Quaternion r = q;
+
+			r *= q.Conjugate();
+			r -= Quaternion(1, 0, 0, 0);
+
+			Assert::AreEqual(0.0, r.W, 1e-15, L"Product with the conjugate is not one.");
+			Assert::IsTrue((-q).IsEqual(q.AdditiveInverse()), L"Negation differs from AdditiveInverse.");
+
+			Print(u.ToString() + " " + r.ToString());
+		}
+
+	};
+}
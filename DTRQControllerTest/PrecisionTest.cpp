@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <FIRBank.h>
+#include <Quaternion.h>
+#include <QuaternionKalmanFilter.h>
+#include <Rotation.h>
+#include <Vector.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(PrecisionTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Single precision keeps about seven digits, the inputs are of order one
+		TEST_METHOD(TestFloatMatchesDouble) {
+			std::mt19937 generator(5);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+			const double tolerance = 1e-5;
+
+			for (int i = 0; i < 1000; i++) {
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+				Quaternion p = Quaternion(value(generator), value(generator), value(generator), value(generator));
+				Vector3D v = Vector3D(value(generator), value(generator), value(generator));
+				Vector3D u = Vector3D(value(generator), value(generator), value(generator));
+
+				q = q.Multiply(1.0 / q.Magnitude());
+
+				QuaternionF qF = QuaternionF(q), pF = QuaternionF(p);
+				Vector3F vF = Vector3F(v), uF = Vector3F(u);
+
+				Quaternion product = q.Multiply(p);
+				QuaternionF productF = qF.Multiply(pF);
+
+				Assert::AreEqual(product.W, (double)productF.W, tolerance, L"Float quaternion product W differs.");
+				Assert::AreEqual(product.Z, (double)productF.Z, tolerance, L"Float quaternion product Z differs.");
+
+				Vector3D rotated = q.RotateVector(v);
+				Vector3D rotatedF = Vector3D(qF.RotateVector(vF));
+
+				Assert::IsTrue(rotated.CalculateEuclideanDistance(rotatedF) < tolerance, L"Float rotation differs.");
+
+				Vector3D cross = v.CrossProduct(u);
+				Vector3D crossF = Vector3D(vF.CrossProduct(uF));
+
+				Assert::IsTrue(cross.CalculateEuclideanDistance(crossF) < tolerance, L"Float cross product differs.");
+				Assert::AreEqual(v.DotProduct(u), (double)vF.DotProduct(uF), tolerance, L"Float dot product differs.");
+			}
+		}
+
+		TEST_METHOD(TestConversionBetweenPrecisions) {
+			Vector3D v = Vector3D(0.1, -2.5, 1e3);
+			Vector3F vF = Vector3F(v);
+			Vector3D back = Vector3D(vF);
+
+			Assert::AreEqual(0.1f, vF.X, L"Conversion to float X incorrect.");
+			Assert::AreEqual(-2.5, back.Y, L"Round trip Y incorrect.");
+			Assert::AreEqual(1e3, back.Z, L"Round trip Z incorrect.");
+
+			QuaternionF qF = QuaternionF(Quaternion(0.5, 0.5, -0.5, 0.5));
+
+			Assert::AreEqual(-0.5f, qF.Y, L"Quaternion conversion incorrect.");
+			Assert::AreEqual(1.0f, qF.Magnitude(), 1e-6f, L"Float magnitude incorrect.");
+
+			Print("Vector3F: " + vF.ToString() + " QuaternionF: " + qF.ToString());
+		}
+
+		//The flight loop's float conversions and filters against the double ones it replaced
+		TEST_METHOD(TestFloatRotationMatchesDouble) {
+			std::mt19937 generator(9);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+			EulerOrder order = EulerConstants::EulerOrderXYZS;
+
+			for (int i = 0; i < 1000; i++) {
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+
+				q = q.Multiply(1.0 / q.Magnitude());
+
+				Rotation rotation = Rotation(q);
+				RotationF rotationF = RotationF(QuaternionF(q));
+
+				Vector3D angles = rotation.GetEulerAngles(order).Angles;
+				Vector3D anglesF = Vector3D(rotationF.GetEulerAngles(order).Angles);
+
+				Assert::IsTrue(angles.CalculateEuclideanDistance(anglesF) < 1e-2, L"Float Euler angles differ.");
+
+				RotationMatrix matrix = rotation.GetRotationMatrix();
+				RotationMatrixF matrixF = rotationF.GetRotationMatrix();
+
+				Assert::IsTrue(matrix.XAxis.CalculateEuclideanDistance(Vector3D(matrixF.XAxis)) < 1e-5, L"Float rotation matrix differs.");
+				Assert::IsTrue(matrix.ZAxis.CalculateEuclideanDistance(Vector3D(matrixF.ZAxis)) < 1e-5, L"Float rotation matrix differs.");
+
+				Quaternion back = Quaternion(RotationF(matrixF).GetQuaternion());
+
+				Assert::IsTrue(std::abs(std::abs(back.DotProduct(q)) - 1.0) < 1e-5, L"Float matrix round trip differs.");
+			}
+		}
+
+		TEST_METHOD(TestFloatFiltersMatchDouble) {
+			std::mt19937 generator(11);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+			FIRBank bank = FIRBank(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+			FIRBankF bankF = FIRBankF(FiniteImpulseResponse::High, 100, 1000, 15, 0, 6);
+			QuaternionKalmanFilter filter = QuaternionKalmanFilter(0.75, 10);
+			QuaternionKalmanFilterF filterF = QuaternionKalmanFilterF(0.75f, 10);
+			double bankError = 0.0, filterError = 0.0;
+
+			for (int i = 0; i < 2000; i++) {
+				double samples[6];
+				float samplesF[6];
+
+				for (int j = 0; j < 6; j++) {
+					samples[j] = value(generator);
+					samplesF[j] = (float)samples[j];
+				}
+
+				bank.Filter(samples, samples);
+				bankF.Filter(samplesF, samplesF);
+
+				for (int j = 0; j < 6; j++) bankError = std::max(bankError, std::abs(samples[j] - samplesF[j]));
+
+				Quaternion q = Quaternion(1.0, 0.1 * value(generator), 0.1 * value(generator), 0.1 * value(generator));
+				Quaternion filtered = filter.Filter(q);
+				Quaternion filteredF = Quaternion(filterF.Filter(QuaternionF(q)));
+
+				filterError = std::max(filterError, std::abs(filtered.W - filteredF.W) + std::abs(filtered.X - filteredF.X) +
+					std::abs(filtered.Y - filteredF.Y) + std::abs(filtered.Z - filteredF.Z));
+			}
+
+			Assert::IsTrue(bankError < 1e-5, L"Float FIR bank differs.");
+			Assert::IsTrue(filterError < 1e-5, L"Float quaternion filter differs.");
+		}
+
+	};
+}
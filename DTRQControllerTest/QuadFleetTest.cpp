@@ -0,0 +1,144 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <QuadFleet.h>
+#include <Quadcopter.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(QuadFleetTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		Quadcopter* CreateQuadcopter() {
+			VectorFeedbackController *pos = new VectorFeedbackController{
+				new PID{ 10, 0, 12.5 },
+				new PID{ 1, 0, 0.2 },
+				new PID{ 10, 0, 12.5 }
+			};
+
+			VectorFeedbackController *rot = new VectorFeedbackController{
+				new PID{ 0.05, 0, 0.325 },
+				new PID{ 0.05, 0, 0.325 },
+				new PID{ 0.05, 0, 0.325 }
+			};
+
+			return new Quadcopter(true, 0.3, 55, 0.05, pos, rot);
+		}
+
+		//Deterministic thruster commands that differ per vehicle, thruster and step
+		Vector3D Command(int vehicle, int thruster, int step) {
+			double phase = vehicle * 0.37 + thruster * 1.1 + step * 0.05;
+
+			return Vector3D(20 * sin(phase), 3 + sin(phase * 0.5), 15 * cos(phase * 0.7));
+		}
+
+		void AssertClose(double expected, double actual, const wchar_t* message) {
+			Assert::AreEqual(expected, actual, 1e-9 * (1.0 + std::abs(expected)), message);
+		}
+
+		TEST_METHOD(TestFleetMatchesQuadcopter) {
+			const int vehicles = 8;
+			const int steps = 200;
+			const double dT = 0.05;
+
+			QuadFleet fleet = QuadFleet(vehicles, 0.3, 55);
+			Quadcopter* quads[vehicles];
+
+			for (int i = 0; i < vehicles; i++) {
+				quads[i] = CreateQuadcopter();
+			}
+
+			for (int step = 0; step < steps; step++) {
+				for (int i = 0; i < vehicles; i++) {
+					Thruster* thrusters[4] = { quads[i]->TB, quads[i]->TC, quads[i]->TD, quads[i]->TE };
+
+					quads[i]->SimulateCurrent(Vector3D(0, -9.81, 0));
+
+					for (int t = 0; t < 4; t++) {
+						thrusters[t]->SetThrusterOutputs(Command(i, t, step));
+						fleet.SetThrusterOutputs(i, (QuadFleet::ThrusterIndex)t, Command(i, t, step));
+					}
+				}
+
+				fleet.Step(dT);
+			}
+
+			for (int i = 0; i < vehicles; i++) {
+				Vector3D position = fleet.GetPosition(i);
+				Quaternion rotation = fleet.GetRotation(i);
+				Quaternion expected = quads[i]->CurrentRotation.GetQuaternion();
+
+				Print(position.ToString() + " " + quads[i]->CurrentPosition.ToString());
+
+				AssertClose(quads[i]->CurrentPosition.X, position.X, L"Fleet position X mismatch.");
+				AssertClose(quads[i]->CurrentPosition.Y, position.Y, L"Fleet position Y mismatch.");
+				AssertClose(quads[i]->CurrentPosition.Z, position.Z, L"Fleet position Z mismatch.");
+
+				AssertClose(expected.W, rotation.W, L"Fleet rotation W mismatch.");
+				AssertClose(expected.X, rotation.X, L"Fleet rotation X mismatch.");
+				AssertClose(expected.Y, rotation.Y, L"Fleet rotation Y mismatch.");
+				AssertClose(expected.Z, rotation.Z, L"Fleet rotation Z mismatch.");
+
+				Vector3D output = fleet.GetThrusterOutput(i, QuadFleet::TD);
+				Vector3D expectedOutput = quads[i]->TD->ReturnThrusterOutput();
+
+				AssertClose(expectedOutput.X, output.X, L"Fleet thruster output X mismatch.");
+				AssertClose(expectedOutput.Y, output.Y, L"Fleet thruster output Y mismatch.");
+				AssertClose(expectedOutput.Z, output.Z, L"Fleet thruster output Z mismatch.");
+
+				delete quads[i];
+			}
+		}
+
+		TEST_METHOD(TestFleetThroughput) {
+			const int vehicles = 1000;
+			const int steps = 100;
+			const double dT = 0.05;
+
+			QuadFleet fleet = QuadFleet(vehicles, 0.3, 55);
+			std::vector<Quadcopter*> quads;
+
+			for (int i = 0; i < vehicles; i++) {
+				quads.push_back(CreateQuadcopter());
+
+				for (int t = 0; t < 4; t++) {
+					fleet.SetThrusterOutputs(i, (QuadFleet::ThrusterIndex)t, Command(i, t, 0));
+				}
+			}
+
+			for (int step = 0; step < steps; step++) {
+				fleet.Step(dT);
+			}
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (int step = 0; step < steps; step++) {
+				for (int i = 0; i < vehicles; i++) {
+					quads[i]->SimulateCurrent(Vector3D(0, -9.81, 0));
+					quads[i]->TB->SetThrusterOutputs(Command(i, 0, 0));
+					quads[i]->TC->SetThrusterOutputs(Command(i, 1, 0));
+					quads[i]->TD->SetThrusterOutputs(Command(i, 2, 0));
+					quads[i]->TE->SetThrusterOutputs(Command(i, 3, 0));
+				}
+			}
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			double quadRate = (double)vehicles * steps / seconds;
+
+			Print("QuadFleet vehicles stepped per second:  " + Mathematics::DoubleToCleanString(fleet.GetVehiclesSteppedPerSecond()));
+			Print("Quadcopter vehicles stepped per second: " + Mathematics::DoubleToCleanString(quadRate));
+
+			for (int i = 0; i < vehicles; i++) {
+				delete quads[i];
+			}
+
+			Assert::IsTrue(fleet.GetVehiclesSteppedPerSecond() > 0, L"Fleet throughput not recorded.");
+		}
+
+	};
+}
@@ -0,0 +1,136 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <RotationBatch.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(RotationBatchTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Recorded samples, mostly near unit with a few off the sphere, level and upside down
+		void CreateSamples(int count, std::vector<double> &w, std::vector<double> &x, std::vector<double> &y, std::vector<double> &z) {
+			std::mt19937 generator(23);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+			w.resize(count); x.resize(count); y.resize(count); z.resize(count);
+
+			for (int i = 0; i < count; i++) {
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+
+				q = q.Divide(q.Magnitude());
+
+				if (i % 97 == 0) q = q.Multiply(1.5);
+				if (i % 101 == 0) q = Quaternion(1, 0, 0, 0);
+				if (i % 103 == 0) q = Quaternion(0, 0, 0, 1);
+
+				w[i] = q.W; x[i] = q.X; y[i] = q.Y; z[i] = q.Z;
+			}
+		}
+
+		//Every representation must equal the one Rotation returns for the same sample, under both policies
+		TEST_METHOD(TestMatchesRotation) {
+			const int count = 5000;
+			std::vector<double> w, x, y, z;
+			std::vector<double> v[9];
+			std::vector<double> rotations(count);
+			EulerOrder orders[3] = { EulerConstants::EulerOrderXYZS, EulerConstants::EulerOrderZYXR, EulerConstants::EulerOrderXYXS };
+			Trigonometry::Policy policies[2] = { Trigonometry::Exact, Trigonometry::Approximate };
+
+			CreateSamples(count, w, x, y, z);
+
+			for (int i = 0; i < 9; i++) v[i].resize(count);
+
+			RotationBatch::QuaternionArrays quaternions = { w.data(), x.data(), y.data(), z.data() };
+			RotationBatch::VectorArrays a = { v[0].data(), v[1].data(), v[2].data() };
+			RotationBatch::VectorArrays b = { v[3].data(), v[4].data(), v[5].data() };
+			RotationBatch::VectorArrays c = { v[6].data(), v[7].data(), v[8].data() };
+			WorkStealingPool pool = WorkStealingPool(1);
+
+			for (Trigonometry::Policy policy : policies) {
+				Trigonometry::SetPolicy(policy);
+
+				for (EulerOrder order : orders) {
+					RotationBatch::ToEulerAngles(quaternions, order, a, count, pool);
+
+					for (int i = 0; i < count; i++) {
+						Vector3D expected = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetEulerAngles(order).Angles;
+
+						Assert::IsTrue(expected.IsEqual(Vector3D(v[0][i], v[1][i], v[2][i])), L"Euler angles differ.");
+					}
+				}
+
+				RotationBatch::ToAxisAngles(quaternions, a, rotations.data(), count, pool);
+
+				for (int i = 0; i < count; i++) {
+					AxisAngle expected = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetAxisAngle();
+
+					Assert::IsTrue(expected.Axis.IsEqual(Vector3D(v[0][i], v[1][i], v[2][i])), L"Axis differs.");
+					Assert::AreEqual(expected.Rotation, rotations[i], L"Axis rotation differs.");
+				}
+
+				RotationBatch::ToDirectionAngles(quaternions, a, rotations.data(), count, pool);
+
+				for (int i = 0; i < count; i++) {
+					DirectionAngle expected = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetDirectionAngle();
+
+					Assert::IsTrue(expected.Direction.IsEqual(Vector3D(v[0][i], v[1][i], v[2][i])), L"Direction differs.");
+					Assert::AreEqual(expected.Rotation, rotations[i], L"Direction rotation differs.");
+				}
+
+				RotationBatch::ToRotationMatrices(quaternions, a, b, c, count, pool);
+
+				for (int i = 0; i < count; i++) {
+					RotationMatrix expected = Rotation(Quaternion(w[i], x[i], y[i], z[i])).GetRotationMatrix();
+
+					Assert::IsTrue(expected.XAxis.IsEqual(Vector3D(v[0][i], v[1][i], v[2][i])), L"Matrix X axis differs.");
+					Assert::IsTrue(expected.YAxis.IsEqual(Vector3D(v[3][i], v[4][i], v[5][i])), L"Matrix Y axis differs.");
+					Assert::IsTrue(expected.ZAxis.IsEqual(Vector3D(v[6][i], v[7][i], v[8][i])), L"Matrix Z axis differs.");
+				}
+			}
+
+			Trigonometry::SetPolicy(Trigonometry::Exact);
+		}
+
+		//Chunks on the pool write disjoint ranges, the result must not depend on the thread count
+		TEST_METHOD(TestThreadsMatchSingle) {
+			const int count = 300000;
+			std::vector<double> w, x, y, z;
+			std::vector<double> single[4], parallel[4];
+
+			CreateSamples(count, w, x, y, z);
+
+			for (int i = 0; i < 4; i++) {
+				single[i].assign(count, 0.0);
+				parallel[i].assign(count, 0.0);
+			}
+
+			RotationBatch::QuaternionArrays quaternions = { w.data(), x.data(), y.data(), z.data() };
+			WorkStealingPool serial = WorkStealingPool(1);
+			WorkStealingPool four = WorkStealingPool(4);
+			WorkStealingPool three = WorkStealingPool(3);
+
+			RotationBatch::ToDirectionAngles(quaternions, { single[0].data(), single[1].data(), single[2].data() }, single[3].data(), count, serial);
+			RotationBatch::ToDirectionAngles(quaternions, { parallel[0].data(), parallel[1].data(), parallel[2].data() }, parallel[3].data(), count, four);
+
+			for (int i = 0; i < 4; i++) {
+				Assert::IsTrue(single[i] == parallel[i], L"Threaded conversion differs from single threaded.");
+			}
+
+			RotationBatch::ToEulerAngles(quaternions, EulerConstants::EulerOrderZYXS, { single[0].data(), single[1].data(), single[2].data() }, count, serial);
+			RotationBatch::ToEulerAngles(quaternions, EulerConstants::EulerOrderZYXS, { parallel[0].data(), parallel[1].data(), parallel[2].data() }, count, three);
+
+			for (int i = 0; i < 3; i++) {
+				Assert::IsTrue(single[i] == parallel[i], L"Threaded Euler conversion differs from single threaded.");
+			}
+
+			Print("Last sample Euler ZYXS: " + Vector3D(single[0][count - 1], single[1][count - 1], single[2][count - 1]).ToString());
+		}
+
+	};
+}
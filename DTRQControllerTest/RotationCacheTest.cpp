@@ -0,0 +1,87 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <Rotation.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(RotationCacheTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Cached representations must be the values a fresh Rotation computes, bit for bit
+		TEST_METHOD(TestCachedMatchesFresh) {
+			std::mt19937 generator(17);
+			std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+			for (int i = 0; i < 200; i++) {
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+
+				q = q.Divide(q.Magnitude());//pitch is NaN off the unit sphere
+
+				Rotation cached = Rotation(q);
+
+				for (int pass = 0; pass < 2; pass++) {
+					Assert::IsTrue(cached.GetDirectionAngle().Direction.IsEqual(Rotation(q).GetDirectionAngle().Direction), L"Direction differs.");
+					Assert::AreEqual(Rotation(q).GetDirectionAngle().Rotation, cached.GetDirectionAngle().Rotation, L"Direction rotation differs.");
+					Assert::IsTrue(cached.GetRotationMatrix().XAxis.IsEqual(Rotation(q).GetRotationMatrix().XAxis), L"Rotation matrix differs.");
+					Assert::IsTrue(cached.GetAxisAngle().Axis.IsEqual(Rotation(q).GetAxisAngle().Axis), L"Axis angle differs.");
+					Assert::AreEqual(Rotation(q).GetYawPitchRoll().Pitch, cached.GetYawPitchRoll().Pitch, L"Yaw pitch roll differs.");
+					Assert::IsTrue(cached.GetEulerAngles(EulerConstants::EulerOrderZYXS).Angles.IsEqual(
+						Rotation(q).GetEulerAngles(EulerConstants::EulerOrderZYXS).Angles), L"Euler angles differ.");
+					Assert::IsTrue(cached.GetEulerAngles<EulerConstants::EulerOrderXYZRTag>().Angles.IsEqual(
+						Rotation(q).GetEulerAngles(EulerConstants::EulerOrderXYZR).Angles), L"Template Euler angles differ.");
+				}
+			}
+		}
+
+		TEST_METHOD(TestHitsAndInvalidation) {
+			Rotation rotation = Rotation(EulerAngles(Vector3D(20, -10, 30), EulerConstants::EulerOrderXYZS));
+
+			Rotation::ResetCacheCounters();
+
+			DirectionAngle first = rotation.GetDirectionAngle();
+
+			rotation.GetDirectionAngle();
+			rotation.GetDirectionAngle();
+
+			Assert::AreEqual(2ULL, Rotation::GetCacheHits(), L"Repeated requests did not hit.");
+			Assert::AreEqual(1ULL, Rotation::GetCacheMisses(), L"First request did not miss.");
+
+			//A new quaternion drops every entry
+			rotation.SetQuaternion(Quaternion(1, 0, 0, 0));
+
+			DirectionAngle level = rotation.GetDirectionAngle();
+
+			Assert::AreEqual(2ULL, Rotation::GetCacheMisses(), L"SetQuaternion did not invalidate.");
+			Assert::IsFalse(level.Direction.IsEqual(first.Direction), L"Stale direction returned.");
+			Assert::IsTrue(level.Direction.IsEqual(Rotation(Quaternion(1, 0, 0, 0)).GetDirectionAngle().Direction), L"Level direction incorrect.");
+
+			//Another order replaces the cached Euler angles
+			rotation.GetEulerAngles(EulerConstants::EulerOrderXYZS);
+			rotation.GetEulerAngles(EulerConstants::EulerOrderXYZS);
+
+			unsigned long long misses = Rotation::GetCacheMisses();
+
+			rotation.GetEulerAngles(EulerConstants::EulerOrderZYXS);
+
+			Assert::AreEqual(misses + 1, Rotation::GetCacheMisses(), L"Changing the Euler order did not miss.");
+
+			//Switching the trigonometry policy drops every entry
+			Trigonometry::SetPolicy(Trigonometry::Approximate);
+
+			rotation.GetDirectionAngle();
+
+			Trigonometry::SetPolicy(Trigonometry::Exact);
+
+			Assert::AreEqual(misses + 2, Rotation::GetCacheMisses(), L"Policy change did not invalidate.");
+
+			Print("Hits: " + std::to_string(Rotation::GetCacheHits()) + " Misses: " + std::to_string(Rotation::GetCacheMisses()));
+		}
+
+	};
+}
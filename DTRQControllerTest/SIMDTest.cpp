@@ -0,0 +1,236 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <sstream>
+#include <Quaternion.h>
+#include <SIMD.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(SIMDTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		//Vector kernels must match the scalar reference bit for bit so traces replay across builds
+		TEST_METHOD(TestKernelsMatchScalarReference) {
+			std::mt19937 generator(7);
+			std::uniform_real_distribution<double> value(-10.0, 10.0);
+
+			Print(std::string("Backend: ") + SIMD::Backend());
+
+			for (int i = 0; i < 10000; i++) {
+				double a[4] = { value(generator), value(generator), value(generator), value(generator) };
+				double b[4] = { value(generator), value(generator), value(generator), value(generator) };
+				double vector[3] = { b[1], b[2], b[3] };
+				double expected[4], actual[4];
+
+				SIMD::ScalarQuaternionMultiply(a, b, expected);
+				SIMD::QuaternionMultiply(a, b, actual);
+
+				for (int j = 0; j < 4; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Quaternion multiply differs from the reference.");
+				}
+
+				SIMD::ScalarCrossProduct(a, b, expected);
+				SIMD::CrossProduct(a, b, actual);
+
+				for (int j = 0; j < 3; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Cross product differs from the reference.");
+				}
+
+				Assert::AreEqual(SIMD::ScalarDot(a, b, 4), SIMD::Dot(a, b, 4), L"Dot product differs from the reference.");
+				Assert::AreEqual(SIMD::ScalarDot(a, b, 3), SIMD::Dot(a, b, 3), L"Dot product differs from the reference.");
+
+				double matrix[9];
+
+				SIMD::RotationMatrix(a, matrix);
+				SIMD::ScalarTransformVector(matrix, vector, expected);
+				SIMD::TransformVectors(matrix, vector, actual, 1);
+
+				for (int j = 0; j < 3; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Matrix transform differs from the reference.");
+				}
+
+				Quaternion q = Quaternion(a[0], a[1], a[2], a[3]);
+				double n = a[0] * a[0] + a[1] * a[1] + a[2] * a[2] + a[3] * a[3];
+				Quaternion unit = q.UnitQuaternion();
+
+				Assert::AreEqual(a[0] / n, unit.W, L"Unit quaternion W differs from the reference.");
+				Assert::AreEqual(a[3] / n, unit.Z, L"Unit quaternion Z differs from the reference.");
+
+				SIMD::ScalarRotate(a, vector, 2.0 / n, expected);
+				SIMD::RotateVector(a, vector, actual);
+
+				for (int j = 0; j < 3; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Rotation differs from the reference.");
+				}
+
+				//Single precision kernels in the SSE registers
+				float aF[4] = { (float)a[0], (float)a[1], (float)a[2], (float)a[3] };
+				float bF[4] = { (float)b[0], (float)b[1], (float)b[2], (float)b[3] };
+				float vectorF[3] = { bF[1], bF[2], bF[3] };
+				float expectedF[4], actualF[4];
+
+				SIMD::ScalarQuaternionMultiply(aF, bF, expectedF);
+				SIMD::QuaternionMultiply(aF, bF, actualF);
+
+				for (int j = 0; j < 4; j++) {
+					Assert::AreEqual(expectedF[j], actualF[j], L"Float quaternion multiply differs from the reference.");
+				}
+
+				float nF = SIMD::ScalarDot(aF, aF, 4);
+
+				SIMD::ScalarRotate(aF, vectorF, 2.0f / nF, expectedF);
+				SIMD::RotateVector(aF, vectorF, actualF);
+
+				for (int j = 0; j < 3; j++) {
+					Assert::AreEqual(expectedF[j], actualF[j], L"Float rotation differs from the reference.");
+				}
+
+				QuaternionF unitF = QuaternionF(aF[0], aF[1], aF[2], aF[3]).UnitQuaternion();
+
+				Assert::AreEqual(aF[0] / nF, unitF.W, L"Float unit quaternion W differs from the reference.");
+				Assert::AreEqual(aF[3] / nF, unitF.Z, L"Float unit quaternion Z differs from the reference.");
+			}
+
+			//The ordered dot product is the sequential sum for any length, including the tail past the vector width
+			std::vector<double> first(23), second(23);
+
+			for (int i = 0; i < 23; i++) {
+				first[i] = value(generator);
+				second[i] = value(generator);
+			}
+
+			for (int count = 0; count <= 23; count++) {
+				double sum = 0.0;
+
+				for (int i = 0; i < count; i++) sum += first[i] * second[i];
+
+				Assert::AreEqual(sum, SIMD::OrderedDot(first.data(), second.data(), count), L"Ordered dot product differs from the sequential sum.");
+			}
+
+			std::vector<double> rows(4 * 37), taps(4 * 37);
+
+			for (int i = 0; i < 4 * 37; i++) {
+				rows[i] = value(generator);
+				taps[i] = value(generator);
+			}
+
+			//Folded rows of eight against the reference, even and odd counts
+			for (int count = 0; count * 8 <= 4 * 37; count++) {
+				double expected[8], actual[8];
+
+				SIMD::ScalarFoldedDot(rows.data(), taps.data(), count, expected);
+				SIMD::FoldedDot(rows.data(), taps.data(), count, actual);
+
+				for (int j = 0; j < 8; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Folded dot product differs from the reference.");
+				}
+			}
+
+			//The single precision row is one vector, same sums
+			std::vector<float> rowsF(rows.begin(), rows.end()), tapsF(taps.begin(), taps.end());
+
+			for (int count = 0; count * 8 <= 4 * 37; count++) {
+				float expected[8], actual[8];
+
+				SIMD::ScalarFoldedDot(rowsF.data(), tapsF.data(), count, expected);
+				SIMD::FoldedDot(rowsF.data(), tapsF.data(), count, actual);
+
+				for (int j = 0; j < 8; j++) {
+					Assert::AreEqual(expected[j], actual[j], L"Float folded dot product differs from the reference.");
+				}
+			}
+
+			//Each lane of the interleaved dot product is the sequential sum of its channel
+			double lanes[4];
+
+			SIMD::InterleavedDot(rows.data(), taps.data(), 37, lanes);
+
+			for (int j = 0; j < 4; j++) {
+				double sum = 0.0;
+
+				for (int i = 0; i < 37; i++) sum += rows[i * 4 + j] * taps[i * 4 + j];
+
+				Assert::AreEqual(sum, lanes[j], L"Interleaved dot product differs from the sequential sum.");
+			}
+		}
+
+		//The expanded rotation, the unit fast path and both batch matrices must agree with q * (0, v) * q^-1
+		TEST_METHOD(TestRotationPathsMatchHamiltonProduct) {
+			std::mt19937 generator(11);
+			std::uniform_real_distribution<double> value(-10.0, 10.0);
+			Vector3D vectors[64], rotated[64], unitRotated[64];
+			double worst = 0.0;
+
+			for (int i = 0; i < 1000; i++) {
+				Quaternion q = Quaternion(value(generator), value(generator), value(generator), value(generator));
+				double magnitude = q.Magnitude();
+				Quaternion unit = Quaternion(q.W / magnitude, q.X / magnitude, q.Y / magnitude, q.Z / magnitude);
+
+				for (int j = 0; j < 64; j++) {
+					vectors[j] = Vector3D(value(generator), value(generator), value(generator));
+				}
+
+				Quaternion::RotateVectors(q, vectors, rotated, 64);
+				Quaternion::RotateUnitVectors(unit, vectors, unitRotated, 64);
+
+				for (int j = 0; j < 64; j++) {
+					Vector3D expected = q.Multiply(Quaternion(vectors[j])).Multiply(q.MultiplicativeInverse()).GetBiVector();
+					double scale = vectors[j].GetLength();
+
+					Vector3D paths[4] = { q.RotateVector(vectors[j]), unit.RotateUnitVector(vectors[j]), rotated[j], unitRotated[j] };
+
+					for (int k = 0; k < 4; k++) {
+						double error = paths[k].CalculateEuclideanDistance(expected) / scale;
+
+						worst = error > worst ? error : worst;
+
+						Assert::IsTrue(error < 1e-13, L"Rotation differs from the Hamilton product.");
+					}
+				}
+			}
+
+			//In place batch rotation
+			Quaternion q = Quaternion(0.3, -0.2, 0.9, 0.1);
+			Vector3D expected = q.RotateVector(vectors[5]);
+
+			Quaternion::RotateVectors(q, vectors, vectors, 64);
+
+			Assert::AreEqual(expected.X, vectors[5].X, 1e-12, L"In place rotation X incorrect.");
+			Assert::AreEqual(expected.Y, vectors[5].Y, 1e-12, L"In place rotation Y incorrect.");
+			Assert::AreEqual(expected.Z, vectors[5].Z, 1e-12, L"In place rotation Z incorrect.");
+
+			std::ostringstream stream;
+
+			stream << "Worst relative rotation error: " << std::scientific << worst;
+
+			Print(stream.str());
+		}
+
+		TEST_METHOD(TestRotationOfUnitQuaternion) {
+			double angle = Mathematics::DegreesToRadians(90) / 2;
+			Quaternion q = Quaternion(cos(angle), 0, 0, sin(angle));
+
+			Vector3D rotated = q.RotateVector(Vector3D(1, 0, 0));
+
+			Assert::AreEqual(0.0, rotated.X, 1e-12, L"Rotation X incorrect.");
+			Assert::AreEqual(1.0, rotated.Y, 1e-12, L"Rotation Y incorrect.");
+			Assert::AreEqual(0.0, rotated.Z, 1e-12, L"Rotation Z incorrect.");
+
+			rotated = q.RotateUnitVector(Vector3D(1, 0, 0));
+
+			Assert::AreEqual(0.0, rotated.X, 1e-12, L"Unit rotation X incorrect.");
+			Assert::AreEqual(1.0, rotated.Y, 1e-12, L"Unit rotation Y incorrect.");
+
+			Vector3D cross = Vector3D(1, 0, 0).CrossProduct(Vector3D(0, 1, 0));
+
+			Assert::AreEqual(1.0, cross.Z, L"Cross product incorrect.");
+		}
+
+	};
+}
@@ -0,0 +1,166 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <chrono>
+#include <Quadcopter.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(SnapshotTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		Quadcopter* CreateQuadcopter(bool adrc) {
+			VectorFeedbackController *pos;
+			VectorFeedbackController *rot;
+
+			if (adrc) {
+				pos = new VectorFeedbackController{ new ADRC{ 10, 20, 0.5, 10, PID{ 10, 0, 12.5 } }, new ADRC{ 10, 20, 0.5, 10, PID{ 1, 0, 0.2 } }, new ADRC{ 10, 20, 0.5, 10, PID{ 10, 0, 12.5 } } };
+				rot = new VectorFeedbackController{ new ADRC{ 2, 10, 1, 1, PID{ 0.05, 0, 0.325 } }, new ADRC{ 2, 10, 1, 1, PID{ 0.05, 0, 0.325 } }, new ADRC{ 2, 10, 1, 1, PID{ 0.05, 0, 0.325 } } };
+			}
+			else {
+				pos = new VectorFeedbackController{ new PID{ 10, 0.5, 12.5 }, new PID{ 1, 0.1, 0.2 }, new PID{ 10, 0.5, 12.5 } };
+				rot = new VectorFeedbackController{ new PID{ 0.05, 0, 0.325 }, new PID{ 0.05, 0, 0.325 }, new PID{ 0.05, 0, 0.325 } };
+			}
+
+			Quadcopter *quad = new Quadcopter(true, 0.3, 55, 0.05, pos, rot);
+
+			quad->SetFeedbackEnabled(true);
+			quad->SetPhysicsSubsteps(2);
+			quad->SetCurrent(Vector3D(0.5, 0, 0), Rotation(EulerAngles(Vector3D(15, 0, -10), EulerConstants::EulerOrderXYZS)));
+
+			return quad;
+		}
+
+		void Fly(Quadcopter *quad, int steps, Vector3D target) {
+			for (int i = 0; i < steps; i++) {
+				quad->SetTarget(target, Rotation(Quaternion(1, 0, 0, 0)));
+				quad->SimulateCurrent(Vector3D(0, -9.81, 0));
+				quad->CalculateCombinedThrustVector();
+			}
+		}
+
+		void AssertSame(Quadcopter *expected, Quadcopter *actual) {
+			Quaternion expectedRotation = expected->CurrentRotation.GetQuaternion();
+			Quaternion actualRotation = actual->CurrentRotation.GetQuaternion();
+
+			Assert::AreEqual(expected->CurrentPosition.X, actual->CurrentPosition.X, L"Position X differs.");
+			Assert::AreEqual(expected->CurrentPosition.Y, actual->CurrentPosition.Y, L"Position Y differs.");
+			Assert::AreEqual(expected->CurrentPosition.Z, actual->CurrentPosition.Z, L"Position Z differs.");
+			Assert::AreEqual(expectedRotation.W, actualRotation.W, L"Rotation W differs.");
+			Assert::AreEqual(expectedRotation.X, actualRotation.X, L"Rotation X differs.");
+			Assert::AreEqual(expectedRotation.Z, actualRotation.Z, L"Rotation Z differs.");
+			Assert::AreEqual(expected->TD->ReturnThrusterOutput().Y, actual->TD->ReturnThrusterOutput().Y, L"Thruster output differs.");
+		}
+
+		TEST_METHOD(TestForkMatchesContinuedFlight) {
+			bool controllers[2] = { false, true };
+
+			for (bool adrc : controllers) {
+				Quadcopter *quad = CreateQuadcopter(adrc);
+				Quadcopter::Snapshot snapshot;
+
+				Fly(quad, 60, Vector3D(0, 0, 0));
+
+				Assert::IsTrue(quad->SaveSnapshot(snapshot), L"Snapshot failed.");
+
+				std::vector<std::unique_ptr<Quadcopter>> branches = quad->Fork(snapshot, 3);
+
+				Fly(quad, 60, Vector3D(0, 0, 0));
+
+				for (std::unique_ptr<Quadcopter> &branch : branches) {
+					Fly(branch.get(), 60, Vector3D(0, 0, 0));
+
+					AssertSame(quad, branch.get());
+				}
+
+				Print(std::string(adrc ? "ADRC" : "PID") + " branch position: " + branches[0]->CurrentPosition.ToString());
+
+				delete quad;
+			}
+		}
+
+		TEST_METHOD(TestRestoreRewindsState) {
+			Quadcopter *quad = CreateQuadcopter(true);
+			Quadcopter::Snapshot snapshot;
+
+			Fly(quad, 40, Vector3D(0, 0, 0));
+
+			Assert::IsTrue(quad->SaveSnapshot(snapshot), L"Snapshot failed.");
+
+			std::unique_ptr<Quadcopter> reference = quad->Clone();
+
+			//Diverge with a different manoeuvre, then rewind
+			Fly(quad, 40, Vector3D(2, 1, -1));
+
+			Assert::IsTrue(quad->RestoreSnapshot(snapshot), L"Restore failed.");
+
+			Fly(quad, 40, Vector3D(0, 0, 0));
+			Fly(reference.get(), 40, Vector3D(0, 0, 0));
+
+			AssertSame(reference.get(), quad);
+
+			delete quad;
+		}
+
+		TEST_METHOD(TestControllerCopyIsIndependent) {
+			VectorFeedbackController original = VectorFeedbackController{ new PID{ 1, 1, 0 }, new PID{ 1, 1, 0 }, new PID{ 1, 1, 0 } };
+
+			original.Calculate(Vector3D(1, 1, 1), Vector3D(0, 0, 0), 0.1);
+
+			VectorFeedbackController copy = original;
+
+			Vector3D first = original.Calculate(Vector3D(1, 1, 1), Vector3D(0, 0, 0), 0.1);
+			Vector3D second = copy.Calculate(Vector3D(1, 1, 1), Vector3D(0, 0, 0), 0.1);
+
+			Assert::IsTrue(original.X != copy.X, L"Copy shares the controller.");
+			Assert::AreEqual(first.X, second.X, L"Copy did not keep the integral.");
+		}
+
+		TEST_METHOD(TestForkThroughput) {
+			const int branches = 50;
+			const int prefix = 400;
+			const int manoeuvre = 40;
+			Quadcopter *quad = CreateQuadcopter(false);
+			Quadcopter::Snapshot snapshot;
+
+			std::streambuf *log = std::cout.rdbuf(nullptr);
+
+			Fly(quad, prefix, Vector3D(0, 0, 0));
+			quad->SaveSnapshot(snapshot);
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (std::unique_ptr<Quadcopter> &branch : quad->Fork(snapshot, branches)) {
+				Fly(branch.get(), manoeuvre, Vector3D(1, 0, 0));
+			}
+
+			double forked = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			start = std::chrono::steady_clock::now();
+
+			for (int i = 0; i < branches; i++) {
+				Quadcopter *replay = CreateQuadcopter(false);
+
+				Fly(replay, prefix, Vector3D(0, 0, 0));
+				Fly(replay, manoeuvre, Vector3D(1, 0, 0));
+
+				delete replay;
+			}
+
+			double replayed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			std::cout.rdbuf(log);
+
+			Print("Forked: " + std::to_string(forked) + "s Replayed from start: " + std::to_string(replayed) + "s");
+
+			Assert::IsTrue(forked < replayed, L"Forking is slower than replaying.");
+
+			delete quad;
+		}
+
+	};
+}
@@ -0,0 +1,145 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include <random>
+#include <Quadcopter.h>
+#include <PID.h>
+#include <Servo.h>
+#include <Trigonometry.h>
+#include <VectorFeedbackController.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DTRQControllerTest
+{
+	TEST_CLASS(TrigonometryTest) {
+	public:
+		void Print(std::string str) {
+			Logger::WriteMessage((str + "\n").c_str());
+		}
+
+		std::string Scientific(double value) {
+			std::ostringstream stream;
+
+			stream << std::scientific << std::setprecision(2) << value;
+
+			return stream.str();
+		}
+
+		//The bounds documented in Trigonometry.h
+		TEST_METHOD(TestApproximationErrors) {
+			std::mt19937 generator(13);
+			std::uniform_real_distribution<double> wide(-1e5, 1e5);
+			std::uniform_real_distribution<double> angle(-10.0, 10.0);
+			std::uniform_real_distribution<double> unit(-1.0, 1.0);
+			double sinError = 0, atanError = 0, asinError = 0, powError = 0;
+
+			for (int i = 0; i < 200000; i++) {
+				double x = i % 2 ? wide(generator) : angle(generator);
+				double s, c;
+
+				Trigonometry::ApproximateSinCos(x, s, c);
+
+				sinError = std::max(sinError, std::max(std::abs(s - sin(x)), std::abs(c - cos(x))));
+
+				double y = angle(generator), z = angle(generator);
+
+				atanError = std::max(atanError, std::abs(Trigonometry::ApproximateAtan2(y, z) - atan2(y, z)));
+
+				double u = unit(generator);
+
+				asinError = std::max(asinError, std::abs(Trigonometry::ApproximateAsin(u) - asin(u)));
+				asinError = std::max(asinError, std::abs(Trigonometry::ApproximateAcos(u) - acos(u)));
+
+				int n = (int)(unit(generator) * 16);
+				double reference = pow(z, n);
+
+				powError = std::max(powError, std::abs(Trigonometry::ApproximatePow(z, n) - reference) / std::abs(reference));
+			}
+
+			Print("Maximum errors, SinCos: " + Scientific(sinError) + " Atan2: " + Scientific(atanError) +
+				" Asin/Acos: " + Scientific(asinError) + " Pow relative: " + Scientific(powError));
+
+			Assert::IsTrue(sinError < 3e-9, L"SinCos exceeds its documented error.");
+			Assert::IsTrue(atanError < 1e-8, L"Atan2 exceeds its documented error.");
+			Assert::IsTrue(asinError < 1e-9, L"Asin or Acos exceeds its documented error.");
+			Assert::IsTrue(powError < 16 * std::numeric_limits<double>::epsilon(), L"Pow exceeds its documented error.");
+		}
+
+		TEST_METHOD(TestEdgeCases) {
+			double s, c;
+
+			Trigonometry::ApproximateSinCos(0.0, s, c);
+
+			Assert::AreEqual(0.0, s, L"sin(0) is not zero.");
+			Assert::AreEqual(1.0, c, L"cos(0) is not one.");
+
+			Assert::AreEqual(atan2(0.0, -1.0), Trigonometry::ApproximateAtan2(0.0, -1.0), L"atan2(0, -1) incorrect.");
+			Assert::AreEqual(atan2(-0.0, -1.0), Trigonometry::ApproximateAtan2(-0.0, -1.0), L"atan2(-0, -1) incorrect.");
+			Assert::AreEqual(atan2(1.0, 0.0), Trigonometry::ApproximateAtan2(1.0, 0.0), L"atan2(1, 0) incorrect.");
+			Assert::AreEqual(Mathematics::PI / 2, Trigonometry::ApproximateAsin(1.0), 1e-8, L"asin(1) incorrect.");
+			Assert::AreEqual(0.0, Trigonometry::ApproximateAcos(1.0), L"acos(1) incorrect.");
+			Assert::IsTrue(Mathematics::IsNaN(Trigonometry::ApproximateAsin(1.5)), L"asin outside the domain is not NaN.");
+			Assert::IsTrue(Mathematics::IsNaN(Trigonometry::ApproximateAtan2(std::nan(""), 1.0)), L"atan2 of NaN is not NaN.");
+		}
+
+		Quadcopter *CreateQuadcopter() {
+			VectorFeedbackController *pos = new VectorFeedbackController{
+				new PID{ 10, 0, 12.5 },
+				new PID{ 1, 0, 0.2 },
+				new PID{ 10, 0, 12.5 }
+			};
+
+			VectorFeedbackController *rot = new VectorFeedbackController{
+				new PID{ 0.05, 0, 0.325 },
+				new PID{ 0.05, 0, 0.325 },
+				new PID{ 0.05, 0, 0.325 }
+			};
+
+			Quadcopter *quad = new Quadcopter(true, 0.3, 55, 0.001, pos, rot);
+
+			quad->SetFeedbackEnabled(true);
+			quad->SetCurrent(Vector3D(1, 2, -1), Rotation(EulerAngles(Vector3D(20, -10, 30), EulerConstants::EulerOrderXYZS)));
+
+			return quad;
+		}
+
+		//Flies the same recovery under both policies, a step at a time, the joint commands have to agree within the
+		//servo resolution for the whole flight
+		TEST_METHOD(TestServoCommandsWithinResolution) {
+			Quadcopter *exact = CreateQuadcopter();
+			Quadcopter *approximate = CreateQuadcopter();
+			Quadcopter *quads[2] = { exact, approximate };
+			Trigonometry::Policy policies[2] = { Trigonometry::Exact, Trigonometry::Approximate };
+			double maximum = 0;
+
+			for (int step = 0; step < 3000; step++) {
+				for (int i = 0; i < 2; i++) {
+					Trigonometry::SetPolicy(policies[i]);
+
+					quads[i]->SetTarget(Vector3D(0, 0, 0), Rotation(Quaternion(1, 0, 0, 0)));
+					quads[i]->SimulateCurrent(Vector3D(0, 0, 0));
+					quads[i]->CalculateCombinedThrustVector();
+				}
+
+				Thruster *exactThrusters[4] = { exact->TB, exact->TC, exact->TD, exact->TE };
+				Thruster *approximateThrusters[4] = { approximate->TB, approximate->TC, approximate->TD, approximate->TE };
+
+				for (int t = 0; t < 4; t++) {
+					Vector3D difference = (exactThrusters[t]->ReturnThrusterOutput() - approximateThrusters[t]->ReturnThrusterOutput()).Absolute();
+
+					maximum = std::max(maximum, std::max(difference.X, difference.Z));
+				}
+			}
+
+			Trigonometry::SetPolicy(Trigonometry::Exact);
+
+			Print("Maximum joint command difference deg: " + Scientific(maximum));
+
+			Assert::IsTrue(maximum < Servo::Resolution, L"Approximate policy moves a joint by more than the servo resolution.");
+
+			delete exact;
+			delete approximate;
+		}
+
+	};
+}
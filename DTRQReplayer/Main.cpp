@@ -0,0 +1,146 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "FlightLoop.h"
+#include "FlightRecorder.h"
+
+//Feeds a trace recorded by DTRQArmController back through FlightLoop as fast as possible and checks every
+//output against the recording bit for bit. --generate writes a synthetic trace for use without the hardware
+void PrintUsage() {
+	std::cout << "Usage: DTRQReplayer <trace>" << std::endl;
+	std::cout << "       DTRQReplayer --generate <trace> <ticks>" << std::endl;
+}
+
+bool BitEqual(double a, double b) {
+	return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool BitEqual(Vector3D a, Vector3D b) {
+	return BitEqual(a.X, b.X) && BitEqual(a.Y, b.Y) && BitEqual(a.Z, b.Z);
+}
+
+bool BitEqual(Quaternion a, Quaternion b) {
+	return BitEqual(a.W, b.W) && BitEqual(a.X, b.X) && BitEqual(a.Y, b.Y) && BitEqual(a.Z, b.Z);
+}
+
+bool BitEqual(FlightLoop::Outputs a, FlightLoop::Outputs b) {
+	return BitEqual(a.Rotation, b.Rotation) && BitEqual(a.WorldAcceleration, b.WorldAcceleration) &&
+		BitEqual(a.Position, b.Position) && BitEqual(a.ThrustB, b.ThrustB) && BitEqual(a.ThrustC, b.ThrustC) &&
+		BitEqual(a.ThrustD, b.ThrustD) && BitEqual(a.ThrustE, b.ThrustE);
+}
+
+//Deterministic stand in for the DMP readings, a slow wobble with accelerometer noise at roughly the loop rate
+FlightLoop::Inputs SyntheticInputs(int tick) {
+	FlightLoop::Inputs inputs;
+	double t = tick * 0.002;
+	double roll = 0.1 * sin(t * 1.3);
+	double pitch = 0.08 * sin(t * 0.7 + 1.0);
+
+	inputs.dT = 0.002 + 0.0001 * sin(tick * 0.37);
+	inputs.MainFRotation = Quaternion(cos(roll), sin(roll), 0, 0).Multiply(Quaternion(cos(pitch), 0, 0, sin(pitch)));
+	inputs.MainBRotation = Quaternion(cos(roll), sin(roll), 0, 0).Multiply(Quaternion(cos(pitch * 1.01), 0, 0, sin(pitch * 1.01)));
+	inputs.MainFAcceleration = Vector3D(0.01 * sin(tick * 1.7), 1.0 + 0.02 * sin(tick * 2.3), 0.01 * cos(tick * 1.1));
+	inputs.MainBAcceleration = Vector3D(0.01 * cos(tick * 1.9), 1.0 + 0.02 * cos(tick * 2.9), 0.01 * sin(tick * 1.3));
+	inputs.TargetPosition = Vector3D(0, 0, 0);
+	inputs.TargetRotation = Quaternion(1, 0, 0, 0);
+
+	return inputs;
+}
+
+int Generate(std::string path, int ticks) {
+	Vector3D offset = Vector3D(0, -1.0, 0);
+	FlightLoop flightLoop = FlightLoop(offset, offset);
+	FlightRecorder recorder;
+
+	if (!recorder.OpenWrite(path, offset, offset)) {
+		return 1;
+	}
+
+	for (int i = 0; i < ticks; i++) {
+		FlightLoop::Inputs inputs = SyntheticInputs(i);
+
+		if (!recorder.Record(inputs, flightLoop.Tick(inputs))) {
+			std::cout << "Failed writing tick " << i << " to " << path << std::endl;
+			return 1;
+		}
+	}
+
+	recorder.Close();
+
+	std::cout << "Generated " << ticks << " ticks in " << path << std::endl;
+
+	return 0;
+}
+
+int Replay(std::string path) {
+	FlightRecorder recorder;
+
+	if (!recorder.OpenRead(path)) {
+		return 1;
+	}
+
+	FlightLoop flightLoop = FlightLoop(recorder.GetForwardOffset(), recorder.GetBackOffset());
+	FlightLoop::Inputs inputs;
+	FlightLoop::Outputs recorded;
+	int mismatches = 0;
+	int firstMismatch = -1;
+	double flightTime = 0.0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (recorder.Read(inputs, recorded)) {
+		FlightLoop::Outputs replayed = flightLoop.Tick(inputs);
+
+		if (!BitEqual(replayed, recorded)) {
+			if (firstMismatch < 0) {
+				firstMismatch = recorder.GetTicks() - 1;
+
+				std::cout << "First mismatch at tick " << firstMismatch << ": recorded " << recorded.ThrustB.ToString() <<
+					" " << recorded.Rotation.ToString() << " replayed " << replayed.ThrustB.ToString() <<
+					" " << replayed.Rotation.ToString() << std::endl;
+			}
+
+			mismatches++;
+		}
+
+		flightTime += inputs.dT;
+	}
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	int ticks = recorder.GetTicks();
+
+	std::cout << "Ticks: " << ticks << " Mismatches: " << mismatches << std::endl;
+	std::cout << "Recorded seconds: " << Mathematics::DoubleToCleanString(flightTime) <<
+		" Replay seconds: " << Mathematics::DoubleToCleanString(elapsed) <<
+		" Ticks/s: " << Mathematics::DoubleToCleanString(ticks / elapsed) <<
+		" Speedup: " << Mathematics::DoubleToCleanString(flightTime / elapsed) << std::endl;
+
+	if (ticks == 0) {
+		std::cout << "Trace " << path << " holds no ticks." << std::endl;
+		return 1;
+	}
+
+	return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc == 2 && std::string(argv[1]) != "--generate") {
+		return Replay(argv[1]);
+	}
+
+	if (argc == 4 && std::string(argv[1]) == "--generate") {
+		char *end = nullptr;
+		int ticks = (int)strtol(argv[3], &end, 10);
+
+		if (*end == '\0' && ticks > 0) {
+			return Generate(argv[2], ticks);
+		}
+	}
+
+	PrintUsage();
+
+	return 1;
+}
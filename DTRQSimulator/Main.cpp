@@ -0,0 +1,171 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Quadcopter.h"
+#include "Vector.h"
+
+//Headless counterpart of DTRQController/Main.cpp, runs a fixed number of steps either as fast as possible
+//or paced at a multiple of real time and reports the throughput
+typedef struct Options {
+	int Steps = 10000;
+	double dT = 0.05;
+	double RealTime = 0.0;//0 runs unpaced
+	int Substeps = 1;//physics and actuator steps per control step
+	bool Feedback = false;
+	Quadcopter::Integrator Integrator = Quadcopter::SemiImplicitEuler;
+	std::string StatePath;//final snapshot written here when set
+} Options;
+
+void PrintUsage() {
+	std::cout << "Usage: DTRQSimulator [--steps N] [--dt seconds] [--realtime multiple] [--substeps N] [--integrator euler|rk4|exp] [--feedback] [--state path]" << std::endl;
+}
+
+bool ParseArguments(int argc, char *argv[], Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+
+		if (argument == "--feedback") {
+			options.Feedback = true;
+			continue;
+		}
+
+		if (argument == "--help") {
+			return false;
+		}
+
+		if (i + 1 >= argc) {
+			std::cout << "Missing value for " << argument << std::endl;
+			return false;
+		}
+
+		std::string value = argv[++i];
+		char *end = nullptr;
+
+		if (argument == "--steps") {
+			options.Steps = (int)strtol(value.c_str(), &end, 10);
+		}
+		else if (argument == "--dt") {
+			options.dT = strtod(value.c_str(), &end);
+		}
+		else if (argument == "--realtime") {
+			options.RealTime = strtod(value.c_str(), &end);
+		}
+		else if (argument == "--substeps") {
+			options.Substeps = (int)strtol(value.c_str(), &end, 10);
+		}
+		else if (argument == "--integrator") {
+			if (value == "euler") options.Integrator = Quadcopter::SemiImplicitEuler;
+			else if (value == "rk4") options.Integrator = Quadcopter::RungeKutta4;
+			else if (value == "exp") options.Integrator = Quadcopter::ExponentialMap;
+			else {
+				std::cout << "Unknown integrator " << value << std::endl;
+				return false;
+			}
+
+			continue;
+		}
+		else if (argument == "--state") {
+			options.StatePath = value;
+			continue;
+		}
+		else {
+			std::cout << "Unknown argument " << argument << std::endl;
+			return false;
+		}
+
+		if (end == nullptr || *end != '\0') {
+			std::cout << "Invalid value for " << argument << ": " << value << std::endl;
+			return false;
+		}
+	}
+
+	if (options.Steps <= 0 || options.dT <= 0 || options.Substeps <= 0 || options.RealTime < 0) {
+		std::cout << "Steps, dT and substeps must be positive, the real-time multiple cannot be negative." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+
+	if (!ParseArguments(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::cout << "Creating Quadcopter Object." << std::endl;
+
+	VectorFeedbackController *pos = new VectorFeedbackController{
+		new PID{ 10, 0, 12.5 },
+		new PID{ 1, 0, 0.2 },
+		new PID{ 10, 0, 12.5 }
+	};
+
+	VectorFeedbackController *rot = new VectorFeedbackController{
+		new PID{ 0.05, 0, 0.325 },
+		new PID{ 0.05, 0, 0.325 },
+		new PID{ 0.05, 0, 0.325 }
+	};
+
+	Quadcopter q = Quadcopter(true, 0.3, 55, options.dT, pos, rot);
+
+	q.SetFeedbackEnabled(options.Feedback);
+	q.SetIntegrator(options.Integrator);
+	q.SetPhysicsSubsteps(options.Substeps);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < options.Steps; i++) {
+		q.SetTarget(Vector3D(0, 0, 0), Rotation(DirectionAngle(0, Vector3D(0, 1, 0))));
+		q.SimulateCurrent(Vector3D(0, -9.81, 0));
+		q.CalculateCombinedThrustVector();
+
+		if (options.RealTime > 0) {
+			std::this_thread::sleep_until(start + std::chrono::duration<double>((i + 1) * options.dT / options.RealTime));
+		}
+	}
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	double simulated = options.Steps * options.dT;
+
+	std::cout << "Steps: " << options.Steps << " dT: " << Mathematics::DoubleToCleanString(options.dT) <<
+		" Substeps: " << options.Substeps <<
+		" Simulated seconds: " << Mathematics::DoubleToCleanString(simulated) << std::endl;
+	std::cout << "Wall seconds: " << Mathematics::DoubleToCleanString(elapsed) <<
+		" Steps/s: " << Mathematics::DoubleToCleanString(options.Steps / elapsed) <<
+		" Wall microseconds per simulated second: " << Mathematics::DoubleToCleanString(elapsed * 1e6 / simulated) <<
+		" Real-time factor: " << Mathematics::DoubleToCleanString(simulated / elapsed) << std::endl;
+	std::cout << "Final position: " << q.CurrentPosition.ToString() <<
+		" rotation: " << q.CurrentRotation.GetQuaternion().ToString() << std::endl;
+
+	Quaternion rotation = q.CurrentRotation.GetQuaternion();
+
+	if (!std::isfinite(q.CurrentPosition.X) || !std::isfinite(q.CurrentPosition.Y) || !std::isfinite(q.CurrentPosition.Z) ||
+		!std::isfinite(rotation.W) || !std::isfinite(rotation.X) || !std::isfinite(rotation.Y) || !std::isfinite(rotation.Z)) {
+		std::cout << "Simulation state is not finite." << std::endl;
+		return 1;
+	}
+
+	//Raw snapshot bytes, two builds stepped the same way compare equal only if they agree bit for bit
+	if (!options.StatePath.empty()) {
+		Quadcopter::Snapshot snapshot = {};
+		std::ofstream file;
+
+		file.open(options.StatePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open() || !q.SaveSnapshot(snapshot)) {
+			std::cout << "Could not write the state to " << options.StatePath << std::endl;
+			return 1;
+		}
+
+		file.write(reinterpret_cast<const char *>(&snapshot), sizeof(snapshot));
+	}
+
+	return 0;
+}
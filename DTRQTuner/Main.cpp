@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "GainTuner.h"
+
+//Searches the controller gains against closed loop step responses and prints the best set with its metrics
+typedef struct Options {
+	GainTuner::ControllerType Type = GainTuner::PIDControl;
+	int Iterations = 200;
+	int Threads = (int)std::thread::hardware_concurrency();
+	int Batch = 0;//0 uses one vertex per thread
+	int Steps = 400;
+	double dT = 0.05;
+} Options;
+
+void PrintUsage() {
+	std::cout << "Usage: DTRQTuner [--adrc] [--iterations N] [--threads N] [--batch N] [--steps N] [--dt seconds]" << std::endl;
+}
+
+bool ParseArguments(int argc, char *argv[], Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+
+		if (argument == "--adrc") {
+			options.Type = GainTuner::ADRCControl;
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			std::cout << "Missing value for " << argument << std::endl;
+			return false;
+		}
+
+		char *end = nullptr;
+		const char *value = argv[++i];
+
+		if (argument == "--iterations") options.Iterations = (int)strtol(value, &end, 10);
+		else if (argument == "--threads") options.Threads = (int)strtol(value, &end, 10);
+		else if (argument == "--batch") options.Batch = (int)strtol(value, &end, 10);
+		else if (argument == "--steps") options.Steps = (int)strtol(value, &end, 10);
+		else if (argument == "--dt") options.dT = strtod(value, &end);
+		else {
+			std::cout << "Unknown argument " << argument << std::endl;
+			return false;
+		}
+
+		if (*end != '\0') {
+			std::cout << "Invalid value for " << argument << ": " << value << std::endl;
+			return false;
+		}
+	}
+
+	if (options.Iterations < 0 || options.Steps <= 0 || options.dT <= 0) {
+		std::cout << "Iterations cannot be negative, steps and dT must be positive." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+
+	if (!ParseArguments(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+
+	GainTuner tuner = GainTuner(options.Type, options.Steps, options.dT);
+
+	tuner.SetBatchSize(options.Batch);
+
+	std::cout << "Tuning " << (options.Type == GainTuner::ADRCControl ? "ADRC" : "PID") << " gains, " <<
+		options.Iterations << " iterations on " << options.Threads << " threads." << std::endl;
+
+	GainTuner::Result result = tuner.Tune(options.Iterations, options.Threads);
+
+	std::cout << tuner.ToString(result);
+
+	return result.Cost <= result.InitialCost ? 0 : 1;
+}